@@ -185,6 +185,26 @@ ABSL_BASE_INTERNAL_FORCEINLINE int CountTrailingZerosNonZero32(uint32_t n) {
 #endif
 }
 
+ABSL_BASE_INTERNAL_FORCEINLINE int Popcount64Slow(uint64_t n) {
+  n -= (n >> 1) & 0x5555555555555555;
+  n = (n & 0x3333333333333333) + ((n >> 2) & 0x3333333333333333);
+  n = (n + (n >> 4)) & 0x0F0F0F0F0F0F0F0F;
+  return static_cast<int>((n * 0x0101010101010101) >> 56);
+}
+
+ABSL_BASE_INTERNAL_FORCEINLINE int Popcount64(uint64_t n) {
+#if defined(__GNUC__)
+  // Use __builtin_popcountll, which is a single popcnt instruction when the
+  // target supports it (e.g. -mpopcnt on x86, cnt on ARM64).
+  static_assert(sizeof(unsigned long long) == sizeof(n),  // NOLINT(runtime/int)
+                "__builtin_popcountll does not take 64-bit arg");
+  return __builtin_popcountll(n);
+#else
+  // MSVC's __popcnt64 faults on CPUs without the popcnt instruction.
+  return Popcount64Slow(n);
+#endif
+}
+
 #undef ABSL_BASE_INTERNAL_FORCEINLINE
 
 }  // namespace base_internal
@@ -93,5 +93,23 @@ TEST(BitsTest, CountTrailingZerosNonZero32) {
   }
 }
 
+int Popcount64(uint64_t n) {
+  int fast = absl::base_internal::Popcount64(n);
+  int slow = absl::base_internal::Popcount64Slow(n);
+  EXPECT_EQ(fast, slow) << n;
+  return fast;
+}
+
+TEST(BitsTest, Popcount64) {
+  EXPECT_EQ(0, Popcount64(0));
+  EXPECT_EQ(64, Popcount64(~uint64_t{}));
+  EXPECT_EQ(32, Popcount64(0x5555555555555555));
+
+  for (int index = 0; index < 64; index++) {
+    uint64_t x = static_cast<uint64_t>(1) << index;
+    ASSERT_EQ(1, Popcount64(x)) << index;
+    ASSERT_EQ(64 - index, Popcount64(~(x - 1))) << index;
+  }
+}
 
 }  // namespace
@@ -0,0 +1,854 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/compressed_bitmap.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "absl/base/internal/bits.h"
+
+namespace absl {
+namespace container_internal {
+
+constexpr uint32_t BitmapContainer::kMaxArraySize;
+constexpr size_t BitmapContainer::kBitsetWords;
+
+}  // namespace container_internal
+
+namespace {
+
+using Container = container_internal::BitmapContainer;
+using base_internal::CountTrailingZerosNonZero64;
+using base_internal::Popcount64;
+
+constexpr uint32_t kMaxArraySize = Container::kMaxArraySize;
+constexpr size_t kWords = Container::kBitsetWords;
+
+uint16_t High(uint32_t v) { return static_cast<uint16_t>(v >> 16); }
+uint16_t Low(uint32_t v) { return static_cast<uint16_t>(v & 0xFFFF); }
+
+size_t NumRuns(const Container& c) { return c.values.size() / 2; }
+uint32_t RunStart(const Container& c, size_t i) { return c.values[2 * i]; }
+uint32_t RunLast(const Container& c, size_t i) {
+  return uint32_t{c.values[2 * i]} + c.values[2 * i + 1];
+}
+
+bool TestBit(const std::vector<uint64_t>& words, uint32_t i) {
+  return (words[i >> 6] >> (i & 63)) & 1;
+}
+void SetBit(std::vector<uint64_t>& words, uint32_t i) {
+  words[i >> 6] |= uint64_t{1} << (i & 63);
+}
+
+// Sets the bits in `[first, last]`.
+void SetRange(std::vector<uint64_t>& words, uint32_t first, uint32_t last) {
+  const size_t first_word = first >> 6;
+  const size_t last_word = last >> 6;
+  const uint64_t first_mask = ~uint64_t{0} << (first & 63);
+  const uint64_t last_mask = ~uint64_t{0} >> (63 - (last & 63));
+  if (first_word == last_word) {
+    words[first_word] |= first_mask & last_mask;
+    return;
+  }
+  words[first_word] |= first_mask;
+  for (size_t i = first_word + 1; i < last_word; ++i) words[i] = ~uint64_t{0};
+  words[last_word] |= last_mask;
+}
+
+uint32_t CountBits(const std::vector<uint64_t>& words) {
+  uint32_t n = 0;
+  for (uint64_t w : words) n += Popcount64(w);
+  return n;
+}
+
+// Combines two bitsets a word at a time and returns the cardinality of the
+// result. The loop has no dependencies between iterations besides the count,
+// so compilers vectorize `op`.
+template <class Op>
+uint32_t CombineWords(const std::vector<uint64_t>& a,
+                      const std::vector<uint64_t>& b,
+                      std::vector<uint64_t>* out, Op op) {
+  out->resize(kWords);
+  const uint64_t* pa = a.data();
+  const uint64_t* pb = b.data();
+  uint64_t* po = out->data();
+  uint32_t n = 0;
+  for (size_t i = 0; i < kWords; ++i) {
+    po[i] = op(pa[i], pb[i]);
+    n += Popcount64(po[i]);
+  }
+  return n;
+}
+
+std::vector<uint64_t> ToWords(const Container& c) {
+  if (c.type == Container::kBitset) return c.words;
+  std::vector<uint64_t> words(kWords);
+  if (c.type == Container::kArray) {
+    for (uint16_t v : c.values) SetBit(words, v);
+  } else {
+    for (size_t i = 0; i < NumRuns(c); ++i) {
+      SetRange(words, RunStart(c, i), RunLast(c, i));
+    }
+  }
+  return words;
+}
+
+std::vector<uint16_t> ToArray(const Container& c) {
+  if (c.type == Container::kArray) return c.values;
+  std::vector<uint16_t> out;
+  out.reserve(c.cardinality);
+  if (c.type == Container::kBitset) {
+    for (size_t i = 0; i < kWords; ++i) {
+      for (uint64_t w = c.words[i]; w != 0; w &= w - 1) {
+        out.push_back(
+            static_cast<uint16_t>(i * 64 + CountTrailingZerosNonZero64(w)));
+      }
+    }
+  } else {
+    for (size_t i = 0; i < NumRuns(c); ++i) {
+      for (uint32_t v = RunStart(c, i); v <= RunLast(c, i); ++v) {
+        out.push_back(static_cast<uint16_t>(v));
+      }
+    }
+  }
+  return out;
+}
+
+template <class T>
+void Release(std::vector<T>& v) {
+  std::vector<T>().swap(v);
+}
+
+// Turns `c` into an array or a bitset, whichever fits its cardinality.
+void Normalize(Container& c) {
+  if (c.cardinality <= kMaxArraySize) {
+    if (c.type == Container::kArray) return;
+    c.values = ToArray(c);
+    Release(c.words);
+    c.type = Container::kArray;
+  } else {
+    if (c.type == Container::kBitset) return;
+    c.words = ToWords(c);
+    Release(c.values);
+    c.type = Container::kBitset;
+  }
+}
+
+Container MakeArray(uint16_t key, std::vector<uint16_t> values) {
+  Container c;
+  c.key = key;
+  c.type = Container::kArray;
+  c.cardinality = static_cast<uint32_t>(values.size());
+  c.values = std::move(values);
+  Normalize(c);
+  return c;
+}
+
+Container MakeBitset(uint16_t key, std::vector<uint64_t> words,
+                     uint32_t cardinality) {
+  Container c;
+  c.key = key;
+  c.type = Container::kBitset;
+  c.cardinality = cardinality;
+  c.words = std::move(words);
+  Normalize(c);
+  return c;
+}
+
+Container MakeRun(uint16_t key, uint32_t first, uint32_t last) {
+  Container c;
+  c.key = key;
+  c.type = Container::kRun;
+  c.cardinality = last - first + 1;
+  c.values = {static_cast<uint16_t>(first),
+              static_cast<uint16_t>(last - first)};
+  return c;
+}
+
+bool Contains(const Container& c, uint16_t low) {
+  switch (c.type) {
+    case Container::kArray:
+      return std::binary_search(c.values.begin(), c.values.end(), low);
+    case Container::kBitset:
+      return TestBit(c.words, low);
+    case Container::kRun: {
+      // Find the last run starting at or before `low`.
+      size_t lo = 0, hi = NumRuns(c);
+      while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        if (RunStart(c, mid) <= low) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      return lo > 0 && low <= RunLast(c, lo - 1);
+    }
+  }
+  return false;
+}
+
+// Returns `c` itself unless it holds runs, in which case it is converted to an
+// array or bitset in `*tmp`. The binary operations below only handle those two
+// representations.
+const Container& Materialize(const Container& c, Container* tmp) {
+  if (c.type != Container::kRun) return c;
+  *tmp = c;
+  Normalize(*tmp);
+  return *tmp;
+}
+
+Container And(const Container& x, const Container& y) {
+  Container tx, ty;
+  const Container& a = Materialize(x, &tx);
+  const Container& b = Materialize(y, &ty);
+  if (a.type == Container::kArray && b.type == Container::kArray) {
+    std::vector<uint16_t> out;
+    out.reserve(std::min(a.values.size(), b.values.size()));
+    std::set_intersection(a.values.begin(), a.values.end(), b.values.begin(),
+                          b.values.end(), std::back_inserter(out));
+    return MakeArray(a.key, std::move(out));
+  }
+  if (a.type == Container::kArray || b.type == Container::kArray) {
+    const Container& arr = a.type == Container::kArray ? a : b;
+    const Container& bits = a.type == Container::kArray ? b : a;
+    std::vector<uint16_t> out;
+    out.reserve(arr.values.size());
+    for (uint16_t v : arr.values) {
+      if (TestBit(bits.words, v)) out.push_back(v);
+    }
+    return MakeArray(a.key, std::move(out));
+  }
+  std::vector<uint64_t> words;
+  const uint32_t n = CombineWords(a.words, b.words, &words,
+                                  [](uint64_t p, uint64_t q) { return p & q; });
+  return MakeBitset(a.key, std::move(words), n);
+}
+
+Container Or(const Container& x, const Container& y) {
+  Container tx, ty;
+  const Container& a = Materialize(x, &tx);
+  const Container& b = Materialize(y, &ty);
+  if (a.type == Container::kArray && b.type == Container::kArray &&
+      a.cardinality + b.cardinality <= kMaxArraySize) {
+    std::vector<uint16_t> out;
+    out.reserve(a.values.size() + b.values.size());
+    std::set_union(a.values.begin(), a.values.end(), b.values.begin(),
+                   b.values.end(), std::back_inserter(out));
+    return MakeArray(a.key, std::move(out));
+  }
+  if (a.type == Container::kBitset && b.type == Container::kBitset) {
+    std::vector<uint64_t> words;
+    const uint32_t n = CombineWords(
+        a.words, b.words, &words, [](uint64_t p, uint64_t q) { return p | q; });
+    return MakeBitset(a.key, std::move(words), n);
+  }
+  // At least one array: add its values to a bitset copy of the other.
+  const Container& arr = a.type == Container::kArray ? a : b;
+  const Container& other = a.type == Container::kArray ? b : a;
+  std::vector<uint64_t> words = ToWords(other);
+  uint32_t n = other.cardinality;
+  for (uint16_t v : arr.values) {
+    if (!TestBit(words, v)) {
+      SetBit(words, v);
+      ++n;
+    }
+  }
+  return MakeBitset(a.key, std::move(words), n);
+}
+
+Container Xor(const Container& x, const Container& y) {
+  Container tx, ty;
+  const Container& a = Materialize(x, &tx);
+  const Container& b = Materialize(y, &ty);
+  if (a.type == Container::kArray && b.type == Container::kArray) {
+    std::vector<uint16_t> out;
+    out.reserve(a.values.size() + b.values.size());
+    std::set_symmetric_difference(a.values.begin(), a.values.end(),
+                                  b.values.begin(), b.values.end(),
+                                  std::back_inserter(out));
+    return MakeArray(a.key, std::move(out));
+  }
+  if (a.type == Container::kBitset && b.type == Container::kBitset) {
+    std::vector<uint64_t> words;
+    const uint32_t n = CombineWords(
+        a.words, b.words, &words, [](uint64_t p, uint64_t q) { return p ^ q; });
+    return MakeBitset(a.key, std::move(words), n);
+  }
+  const Container& arr = a.type == Container::kArray ? a : b;
+  const Container& bits = a.type == Container::kArray ? b : a;
+  std::vector<uint64_t> words = bits.words;
+  uint32_t n = bits.cardinality;
+  for (uint16_t v : arr.values) {
+    n = TestBit(words, v) ? n - 1 : n + 1;
+    words[v >> 6] ^= uint64_t{1} << (v & 63);
+  }
+  return MakeBitset(a.key, std::move(words), n);
+}
+
+Container AndNot(const Container& x, const Container& y) {
+  Container tx, ty;
+  const Container& a = Materialize(x, &tx);
+  const Container& b = Materialize(y, &ty);
+  if (a.type == Container::kArray) {
+    std::vector<uint16_t> out;
+    out.reserve(a.values.size());
+    if (b.type == Container::kArray) {
+      std::set_difference(a.values.begin(), a.values.end(), b.values.begin(),
+                          b.values.end(), std::back_inserter(out));
+    } else {
+      for (uint16_t v : a.values) {
+        if (!TestBit(b.words, v)) out.push_back(v);
+      }
+    }
+    return MakeArray(a.key, std::move(out));
+  }
+  if (b.type == Container::kBitset) {
+    std::vector<uint64_t> words;
+    const uint32_t n =
+        CombineWords(a.words, b.words, &words,
+                     [](uint64_t p, uint64_t q) { return p & ~q; });
+    return MakeBitset(a.key, std::move(words), n);
+  }
+  std::vector<uint64_t> words = a.words;
+  uint32_t n = a.cardinality;
+  for (uint16_t v : b.values) {
+    if (TestBit(words, v)) {
+      words[v >> 6] &= ~(uint64_t{1} << (v & 63));
+      --n;
+    }
+  }
+  return MakeBitset(a.key, std::move(words), n);
+}
+
+size_t ContainerIntersectionSize(const Container& x, const Container& y) {
+  Container tx, ty;
+  const Container& a = Materialize(x, &tx);
+  const Container& b = Materialize(y, &ty);
+  size_t n = 0;
+  if (a.type == Container::kBitset && b.type == Container::kBitset) {
+    for (size_t i = 0; i < kWords; ++i) {
+      n += Popcount64(a.words[i] & b.words[i]);
+    }
+  } else if (a.type == Container::kArray && b.type == Container::kArray) {
+    auto i = a.values.begin(), j = b.values.begin();
+    while (i != a.values.end() && j != b.values.end()) {
+      if (*i < *j) {
+        ++i;
+      } else if (*j < *i) {
+        ++j;
+      } else {
+        ++n, ++i, ++j;
+      }
+    }
+  } else {
+    const Container& arr = a.type == Container::kArray ? a : b;
+    const Container& bits = a.type == Container::kArray ? b : a;
+    for (uint16_t v : arr.values) n += TestBit(bits.words, v);
+  }
+  return n;
+}
+
+// Number of runs of consecutive values in `c`.
+size_t CountRuns(const Container& c) {
+  switch (c.type) {
+    case Container::kArray: {
+      size_t n = 1;
+      for (size_t i = 1; i < c.values.size(); ++i) {
+        n += c.values[i] != c.values[i - 1] + 1;
+      }
+      return n;
+    }
+    case Container::kBitset: {
+      // A run starts at every set bit whose lower neighbor is clear.
+      size_t n = 0;
+      uint64_t carry = 0;
+      for (uint64_t w : c.words) {
+        n += Popcount64(w & ~((w << 1) | carry));
+        carry = w >> 63;
+      }
+      return n;
+    }
+    case Container::kRun:
+      return NumRuns(c);
+  }
+  return 0;
+}
+
+void ToRuns(Container& c) {
+  if (c.type == Container::kRun) return;
+  const std::vector<uint16_t> values = ToArray(c);
+  std::vector<uint16_t> runs;
+  runs.reserve(2 * CountRuns(c));
+  for (size_t i = 0; i < values.size();) {
+    size_t j = i + 1;
+    while (j < values.size() && values[j] == values[j - 1] + 1) ++j;
+    runs.push_back(values[i]);
+    runs.push_back(static_cast<uint16_t>(j - i - 1));
+    i = j;
+  }
+  c.values = std::move(runs);
+  Release(c.words);
+  c.type = Container::kRun;
+}
+
+// Merges the containers of `a` and `b` by key. Containers present in both are
+// combined with `op`; containers present in only one of them are kept if
+// `keep_a`/`keep_b` is set. Containers of `a` are moved from if `movable_a`,
+// which is either null or `&a`, is set.
+template <class Op>
+std::vector<Container> Merge(const std::vector<Container>& a,
+                             std::vector<Container>* movable_a,
+                             const std::vector<Container>& b, Op op,
+                             bool keep_a, bool keep_b) {
+  std::vector<Container> out;
+  out.reserve(std::max(a.size(), b.size()));
+  auto take_a = [&](size_t i) {
+    if (movable_a != nullptr) {
+      out.push_back(std::move((*movable_a)[i]));
+    } else {
+      out.push_back(a[i]);
+    }
+  };
+  size_t i = 0, j = 0;
+  while (i < a.size() && j < b.size()) {
+    if (a[i].key < b[j].key) {
+      if (keep_a) take_a(i);
+      ++i;
+    } else if (b[j].key < a[i].key) {
+      if (keep_b) out.push_back(b[j]);
+      ++j;
+    } else {
+      Container c = op(a[i], b[j]);
+      if (c.cardinality != 0) out.push_back(std::move(c));
+      ++i, ++j;
+    }
+  }
+  if (keep_a) {
+    for (; i < a.size(); ++i) take_a(i);
+  }
+  if (keep_b) out.insert(out.end(), b.begin() + j, b.end());
+  return out;
+}
+
+void PutU8(std::string* out, uint8_t v) {
+  out->push_back(static_cast<char>(v));
+}
+void PutU16(std::string* out, uint16_t v) {
+  PutU8(out, static_cast<uint8_t>(v));
+  PutU8(out, static_cast<uint8_t>(v >> 8));
+}
+void PutU32(std::string* out, uint32_t v) {
+  PutU16(out, static_cast<uint16_t>(v));
+  PutU16(out, static_cast<uint16_t>(v >> 16));
+}
+void PutU64(std::string* out, uint64_t v) {
+  PutU32(out, static_cast<uint32_t>(v));
+  PutU32(out, static_cast<uint32_t>(v >> 32));
+}
+
+// Reads little-endian integers from a string_view, failing on truncation.
+class Reader {
+ public:
+  explicit Reader(absl::string_view data) : data_(data) {}
+
+  bool done() const { return data_.empty(); }
+
+  template <class T>
+  bool Read(T* v) {
+    if (data_.size() < sizeof(T)) return false;
+    T r = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      r |= static_cast<T>(static_cast<uint8_t>(data_[i])) << (8 * i);
+    }
+    data_.remove_prefix(sizeof(T));
+    *v = r;
+    return true;
+  }
+
+ private:
+  absl::string_view data_;
+};
+
+constexpr uint8_t kFormatVersion = 1;
+
+bool ReadContainer(Reader* in, Container* c) {
+  uint8_t type;
+  uint32_t count;
+  if (!in->Read(&c->key) || !in->Read(&type) || !in->Read(&c->cardinality) ||
+      !in->Read(&count)) {
+    return false;
+  }
+  if (c->cardinality == 0 || c->cardinality > 65536) return false;
+  switch (type) {
+    case Container::kArray:
+      if (count != c->cardinality || count > kMaxArraySize) return false;
+      c->values.resize(count);
+      for (uint32_t i = 0; i < count; ++i) {
+        if (!in->Read(&c->values[i])) return false;
+        if (i > 0 && c->values[i] <= c->values[i - 1]) return false;
+      }
+      break;
+    case Container::kBitset:
+      if (count != kWords || c->cardinality <= kMaxArraySize) return false;
+      c->words.resize(kWords);
+      for (uint64_t& w : c->words) {
+        if (!in->Read(&w)) return false;
+      }
+      if (CountBits(c->words) != c->cardinality) return false;
+      break;
+    case Container::kRun: {
+      if (count == 0 || count % 2 != 0 || count > 65536) return false;
+      c->values.resize(count);
+      for (uint16_t& v : c->values) {
+        if (!in->Read(&v)) return false;
+      }
+      uint32_t total = 0;
+      for (size_t i = 0; i < NumRuns(*c); ++i) {
+        if (RunLast(*c, i) > 0xFFFF) return false;
+        if (i > 0 && RunStart(*c, i) <= RunLast(*c, i - 1) + 1) return false;
+        total += RunLast(*c, i) - RunStart(*c, i) + 1;
+      }
+      if (total != c->cardinality) return false;
+      break;
+    }
+    default:
+      return false;
+  }
+  c->type = static_cast<Container::Type>(type);
+  return true;
+}
+
+}  // namespace
+
+CompressedBitmap::const_iterator::const_iterator(
+    const std::vector<Container>* containers, size_t ci)
+    : containers_(containers), ci_(ci) {
+  Seek();
+}
+
+void CompressedBitmap::const_iterator::Seek() {
+  pos_ = 0;
+  low_ = 0;
+  if (ci_ == containers_->size()) return;
+  const Container& c = (*containers_)[ci_];
+  if (c.type == Container::kBitset) {
+    size_t w = 0;
+    while (c.words[w] == 0) ++w;
+    low_ = static_cast<uint32_t>(w * 64 +
+                                 CountTrailingZerosNonZero64(c.words[w]));
+  } else {
+    low_ = c.values[0];
+  }
+}
+
+CompressedBitmap::const_iterator& CompressedBitmap::const_iterator::
+operator++() {
+  const Container& c = (*containers_)[ci_];
+  switch (c.type) {
+    case Container::kArray:
+      if (++pos_ < c.values.size()) {
+        low_ = c.values[pos_];
+        return *this;
+      }
+      break;
+    case Container::kBitset:
+      if (low_ != 0xFFFF) {
+        const uint32_t next = low_ + 1;
+        size_t w = next >> 6;
+        uint64_t word = c.words[w] & (~uint64_t{0} << (next & 63));
+        while (true) {
+          if (word != 0) {
+            low_ = static_cast<uint32_t>(w * 64 +
+                                         CountTrailingZerosNonZero64(word));
+            return *this;
+          }
+          if (++w == kWords) break;
+          word = c.words[w];
+        }
+      }
+      break;
+    case Container::kRun:
+      if (low_ < RunLast(c, pos_)) {
+        ++low_;
+        return *this;
+      }
+      if (++pos_ < NumRuns(c)) {
+        low_ = RunStart(c, pos_);
+        return *this;
+      }
+      break;
+  }
+  ++ci_;
+  Seek();
+  return *this;
+}
+
+const Container* CompressedBitmap::Find(uint16_t key) const {
+  auto it = std::lower_bound(
+      containers_.begin(), containers_.end(), key,
+      [](const Container& c, uint16_t k) { return c.key < k; });
+  return it != containers_.end() && it->key == key ? &*it : nullptr;
+}
+
+size_t CompressedBitmap::size() const {
+  size_t n = 0;
+  for (const Container& c : containers_) n += c.cardinality;
+  return n;
+}
+
+bool CompressedBitmap::contains(uint32_t value) const {
+  const Container* c = Find(High(value));
+  return c != nullptr && Contains(*c, Low(value));
+}
+
+bool CompressedBitmap::insert(uint32_t value) {
+  const uint16_t key = High(value);
+  const uint16_t low = Low(value);
+  auto it = std::lower_bound(
+      containers_.begin(), containers_.end(), key,
+      [](const Container& c, uint16_t k) { return c.key < k; });
+  if (it == containers_.end() || it->key != key) {
+    containers_.insert(it, MakeArray(key, {low}));
+    return true;
+  }
+  Container& c = *it;
+  if (c.type == Container::kRun) {
+    if (Contains(c, low)) return false;
+    Normalize(c);
+  }
+  if (c.type == Container::kArray) {
+    auto pos = std::lower_bound(c.values.begin(), c.values.end(), low);
+    if (pos != c.values.end() && *pos == low) return false;
+    c.values.insert(pos, low);
+    ++c.cardinality;
+    Normalize(c);
+    return true;
+  }
+  if (TestBit(c.words, low)) return false;
+  SetBit(c.words, low);
+  ++c.cardinality;
+  return true;
+}
+
+void CompressedBitmap::insert_range(uint32_t first, uint64_t last) {
+  if (last > uint64_t{1} << 32) last = uint64_t{1} << 32;
+  if (last <= first) return;
+  const uint32_t back = static_cast<uint32_t>(last - 1);
+  for (uint32_t key = High(first); key <= High(back); ++key) {
+    const uint32_t lo = key == High(first) ? Low(first) : 0;
+    const uint32_t hi = key == High(back) ? Low(back) : 0xFFFF;
+    auto it = std::lower_bound(
+        containers_.begin(), containers_.end(), key,
+        [](const Container& c, uint32_t k) { return c.key < k; });
+    if (it == containers_.end() || it->key != key) {
+      containers_.insert(it, MakeRun(static_cast<uint16_t>(key), lo, hi));
+      continue;
+    }
+    if (lo == 0 && hi == 0xFFFF) {
+      *it = MakeRun(static_cast<uint16_t>(key), lo, hi);
+      continue;
+    }
+    std::vector<uint64_t> words = ToWords(*it);
+    SetRange(words, lo, hi);
+    const uint32_t n = CountBits(words);
+    *it = MakeBitset(static_cast<uint16_t>(key), std::move(words), n);
+  }
+}
+
+size_t CompressedBitmap::erase(uint32_t value) {
+  const uint16_t key = High(value);
+  const uint16_t low = Low(value);
+  auto it = std::lower_bound(
+      containers_.begin(), containers_.end(), key,
+      [](const Container& c, uint16_t k) { return c.key < k; });
+  if (it == containers_.end() || it->key != key || !Contains(*it, low)) {
+    return 0;
+  }
+  Container& c = *it;
+  if (c.cardinality == 1) {
+    containers_.erase(it);
+    return 1;
+  }
+  if (c.type == Container::kRun) Normalize(c);
+  --c.cardinality;
+  if (c.type == Container::kArray) {
+    c.values.erase(std::lower_bound(c.values.begin(), c.values.end(), low));
+  } else {
+    c.words[low >> 6] &= ~(uint64_t{1} << (low & 63));
+    Normalize(c);
+  }
+  return 1;
+}
+
+void CompressedBitmap::shrink_to_fit() {
+  for (Container& c : containers_) {
+    const size_t run_bytes = 4 * CountRuns(c);
+    const size_t other_bytes = c.cardinality <= kMaxArraySize
+                                   ? 2 * size_t{c.cardinality}
+                                   : 8 * kWords;
+    if (run_bytes < other_bytes) {
+      ToRuns(c);
+    } else {
+      Normalize(c);
+    }
+    c.values.shrink_to_fit();
+    c.words.shrink_to_fit();
+  }
+  containers_.shrink_to_fit();
+}
+
+size_t CompressedBitmap::bytes_used() const {
+  size_t n = sizeof(*this) + containers_.capacity() * sizeof(Container);
+  for (const Container& c : containers_) {
+    n += c.values.capacity() * sizeof(uint16_t) +
+         c.words.capacity() * sizeof(uint64_t);
+  }
+  return n;
+}
+
+CompressedBitmap& CompressedBitmap::operator&=(const CompressedBitmap& other) {
+  containers_ =
+      Merge(containers_, &containers_, other.containers_, And, false, false);
+  return *this;
+}
+
+CompressedBitmap& CompressedBitmap::operator|=(const CompressedBitmap& other) {
+  containers_ =
+      Merge(containers_, &containers_, other.containers_, Or, true, true);
+  return *this;
+}
+
+CompressedBitmap& CompressedBitmap::operator^=(const CompressedBitmap& other) {
+  containers_ =
+      Merge(containers_, &containers_, other.containers_, Xor, true, true);
+  return *this;
+}
+
+CompressedBitmap& CompressedBitmap::operator-=(const CompressedBitmap& other) {
+  containers_ =
+      Merge(containers_, &containers_, other.containers_, AndNot, true, false);
+  return *this;
+}
+
+CompressedBitmap operator&(const CompressedBitmap& a,
+                           const CompressedBitmap& b) {
+  CompressedBitmap r;
+  r.containers_ =
+      Merge(a.containers_, nullptr, b.containers_, And, false, false);
+  return r;
+}
+
+CompressedBitmap operator|(const CompressedBitmap& a,
+                           const CompressedBitmap& b) {
+  CompressedBitmap r;
+  r.containers_ = Merge(a.containers_, nullptr, b.containers_, Or, true, true);
+  return r;
+}
+
+CompressedBitmap operator^(const CompressedBitmap& a,
+                           const CompressedBitmap& b) {
+  CompressedBitmap r;
+  r.containers_ = Merge(a.containers_, nullptr, b.containers_, Xor, true, true);
+  return r;
+}
+
+CompressedBitmap operator-(const CompressedBitmap& a,
+                           const CompressedBitmap& b) {
+  CompressedBitmap r;
+  r.containers_ =
+      Merge(a.containers_, nullptr, b.containers_, AndNot, true, false);
+  return r;
+}
+
+size_t CompressedBitmap::IntersectionSize(const CompressedBitmap& a,
+                                          const CompressedBitmap& b) {
+  size_t n = 0;
+  size_t i = 0, j = 0;
+  while (i < a.containers_.size() && j < b.containers_.size()) {
+    if (a.containers_[i].key < b.containers_[j].key) {
+      ++i;
+    } else if (b.containers_[j].key < a.containers_[i].key) {
+      ++j;
+    } else {
+      n += ContainerIntersectionSize(a.containers_[i], b.containers_[j]);
+      ++i, ++j;
+    }
+  }
+  return n;
+}
+
+bool operator==(const CompressedBitmap& a, const CompressedBitmap& b) {
+  if (a.containers_.size() != b.containers_.size()) return false;
+  for (size_t i = 0; i < a.containers_.size(); ++i) {
+    const Container& x = a.containers_[i];
+    const Container& y = b.containers_[i];
+    if (x.key != y.key || x.cardinality != y.cardinality) return false;
+    if (x.type == y.type) {
+      if (x.values != y.values || x.words != y.words) return false;
+    } else if (ToWords(x) != ToWords(y)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Format: a version byte and the number of containers, followed by every
+// container as its key, type, cardinality, number of payload elements and
+// the payload itself. All integers are little-endian.
+std::string CompressedBitmap::Serialize() const {
+  std::string out;
+  PutU8(&out, kFormatVersion);
+  PutU32(&out, static_cast<uint32_t>(containers_.size()));
+  for (const Container& c : containers_) {
+    PutU16(&out, c.key);
+    PutU8(&out, c.type);
+    PutU32(&out, c.cardinality);
+    if (c.type == Container::kBitset) {
+      PutU32(&out, static_cast<uint32_t>(c.words.size()));
+      for (uint64_t w : c.words) PutU64(&out, w);
+    } else {
+      PutU32(&out, static_cast<uint32_t>(c.values.size()));
+      for (uint16_t v : c.values) PutU16(&out, v);
+    }
+  }
+  return out;
+}
+
+bool CompressedBitmap::Deserialize(absl::string_view data) {
+  clear();
+  Reader in(data);
+  uint8_t version;
+  uint32_t n;
+  if (!in.Read(&version) || version != kFormatVersion || !in.Read(&n) ||
+      n > 65536) {
+    return false;
+  }
+  std::vector<Container> containers;
+  for (uint32_t i = 0; i < n; ++i) {
+    Container c;
+    if (!ReadContainer(&in, &c) ||
+        (i > 0 && c.key <= containers.back().key)) {
+      return false;
+    }
+    containers.push_back(std::move(c));
+  }
+  if (!in.done()) return false;
+  containers_ = std::move(containers);
+  return true;
+}
+
+}  // namespace absl
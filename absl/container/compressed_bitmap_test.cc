@@ -0,0 +1,257 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/compressed_bitmap.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace absl {
+namespace container_internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+std::vector<uint32_t> ToVector(const CompressedBitmap& b) {
+  return std::vector<uint32_t>(b.begin(), b.end());
+}
+
+// Random values in a few chunks, mixing sparse chunks, dense chunks and long
+// ranges so that every container representation is exercised.
+std::set<uint32_t> RandomSet(std::mt19937* rng) {
+  std::set<uint32_t> s;
+  std::uniform_int_distribution<uint32_t> chunk(0, 5);
+  std::uniform_int_distribution<uint32_t> low(0, 0xFFFF);
+  for (int i = 0; i < 6; ++i) {
+    const uint32_t base = chunk(*rng) << 16;
+    switch ((*rng)() % 3) {
+      case 0:
+        for (int j = 0; j < 100; ++j) s.insert(base | low(*rng));
+        break;
+      case 1:
+        for (int j = 0; j < 10000; ++j) s.insert(base | low(*rng));
+        break;
+      case 2: {
+        const uint32_t start = low(*rng);
+        const uint32_t len = low(*rng) % 20000;
+        for (uint32_t v = start; v <= std::min<uint32_t>(0xFFFF, start + len);
+             ++v) {
+          s.insert(base | v);
+        }
+        break;
+      }
+    }
+  }
+  return s;
+}
+
+CompressedBitmap FromSet(const std::set<uint32_t>& s, bool optimize) {
+  CompressedBitmap b(s.begin(), s.end());
+  if (optimize) b.shrink_to_fit();
+  return b;
+}
+
+TEST(CompressedBitmap, Empty) {
+  CompressedBitmap b;
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(0, b.size());
+  EXPECT_EQ(b.begin(), b.end());
+  EXPECT_FALSE(b.contains(0));
+  EXPECT_EQ(0, b.erase(0));
+}
+
+TEST(CompressedBitmap, InsertEraseContains) {
+  CompressedBitmap b = {5, 1, 0xFFFFFFFF, 70000, 1};
+  EXPECT_EQ(4, b.size());
+  EXPECT_THAT(ToVector(b), ElementsAre(1, 5, 70000, 0xFFFFFFFF));
+  EXPECT_TRUE(b.contains(70000));
+  EXPECT_FALSE(b.contains(70001));
+  EXPECT_FALSE(b.insert(5));
+  EXPECT_TRUE(b.insert(6));
+  EXPECT_EQ(1, b.count(6));
+  EXPECT_EQ(1, b.erase(5));
+  EXPECT_EQ(0, b.erase(5));
+  EXPECT_THAT(ToVector(b), ElementsAre(1, 6, 70000, 0xFFFFFFFF));
+  b.clear();
+  EXPECT_TRUE(b.empty());
+}
+
+TEST(CompressedBitmap, ArrayToBitsetAndBack) {
+  CompressedBitmap b;
+  for (uint32_t i = 0; i < 10000; ++i) b.insert(i * 3);
+  EXPECT_EQ(10000, b.size());
+  for (uint32_t i = 0; i < 30000; ++i) {
+    ASSERT_EQ(i % 3 == 0, b.contains(i)) << i;
+  }
+  for (uint32_t i = 0; i < 10000; i += 2) b.erase(i * 3);
+  EXPECT_EQ(5000, b.size());
+  for (uint32_t i = 0; i < 10000; ++i) {
+    ASSERT_EQ(i % 2 == 1, b.contains(i * 3)) << i;
+  }
+  std::vector<uint32_t> expected;
+  for (uint32_t i = 1; i < 10000; i += 2) expected.push_back(i * 3);
+  EXPECT_THAT(ToVector(b), ElementsAreArray(expected));
+}
+
+TEST(CompressedBitmap, InsertRange) {
+  CompressedBitmap b;
+  b.insert_range(10, 20);
+  b.insert_range(65530, 131080);
+  b.insert_range(5, 5);
+  EXPECT_EQ(10 + (131080 - 65530), b.size());
+  EXPECT_FALSE(b.contains(9));
+  EXPECT_TRUE(b.contains(10));
+  EXPECT_TRUE(b.contains(19));
+  EXPECT_FALSE(b.contains(20));
+  EXPECT_TRUE(b.contains(65536));
+  EXPECT_TRUE(b.contains(131079));
+  EXPECT_FALSE(b.contains(131080));
+
+  // Insertion into and removal from run containers.
+  EXPECT_FALSE(b.insert(100000));
+  EXPECT_TRUE(b.insert(131090));
+  EXPECT_EQ(1, b.erase(100000));
+  EXPECT_FALSE(b.contains(100000));
+  EXPECT_TRUE(b.contains(100001));
+  // Partially overlapping range.
+  b.insert_range(15, 30);
+  EXPECT_TRUE(b.contains(25));
+  EXPECT_EQ(20 + (131080 - 65530), b.size());
+
+  CompressedBitmap all;
+  all.insert_range(0, uint64_t{1} << 32);
+  EXPECT_EQ(uint64_t{1} << 32, all.size());
+  EXPECT_TRUE(all.contains(0xFFFFFFFF));
+  // 2^16 containers of a single run each.
+  EXPECT_LT(all.bytes_used(), 8 << 20);
+}
+
+TEST(CompressedBitmap, SetOperationsMatchStdSet) {
+  std::mt19937 rng(42);
+  for (int iter = 0; iter < 10; ++iter) {
+    const std::set<uint32_t> x = RandomSet(&rng);
+    const std::set<uint32_t> y = RandomSet(&rng);
+    const CompressedBitmap a = FromSet(x, iter % 2 == 0);
+    const CompressedBitmap b = FromSet(y, iter % 3 == 0);
+    ASSERT_EQ(x.size(), a.size());
+    ASSERT_THAT(ToVector(a), ElementsAreArray(x.begin(), x.end()));
+
+    std::vector<uint32_t> expected;
+    std::set_intersection(x.begin(), x.end(), y.begin(), y.end(),
+                          std::back_inserter(expected));
+    EXPECT_THAT(ToVector(a & b), ElementsAreArray(expected));
+    EXPECT_EQ(expected.size(), CompressedBitmap::IntersectionSize(a, b));
+
+    expected.clear();
+    std::set_union(x.begin(), x.end(), y.begin(), y.end(),
+                   std::back_inserter(expected));
+    EXPECT_THAT(ToVector(a | b), ElementsAreArray(expected));
+
+    expected.clear();
+    std::set_symmetric_difference(x.begin(), x.end(), y.begin(), y.end(),
+                                  std::back_inserter(expected));
+    EXPECT_THAT(ToVector(a ^ b), ElementsAreArray(expected));
+
+    expected.clear();
+    std::set_difference(x.begin(), x.end(), y.begin(), y.end(),
+                        std::back_inserter(expected));
+    const CompressedBitmap diff = a - b;
+    EXPECT_THAT(ToVector(diff), ElementsAreArray(expected));
+    EXPECT_EQ(expected.size(), diff.size());
+
+    CompressedBitmap c = a;
+    c -= b;
+    EXPECT_EQ(diff, c);
+    c |= b;
+    EXPECT_EQ(a | b, c);
+    c &= a;
+    EXPECT_EQ(a, c);
+    c ^= a;
+    EXPECT_TRUE(c.empty());
+  }
+}
+
+TEST(CompressedBitmap, ShrinkToFit) {
+  CompressedBitmap b;
+  for (uint32_t i = 0; i < 200000; ++i) b.insert(i);
+  const size_t before = b.bytes_used();
+  b.shrink_to_fit();
+  EXPECT_LT(b.bytes_used(), before / 10);
+  EXPECT_EQ(200000, b.size());
+  EXPECT_TRUE(b.contains(199999));
+  EXPECT_FALSE(b.contains(200000));
+
+  CompressedBitmap copy;
+  for (uint32_t i = 0; i < 200000; ++i) copy.insert(i);
+  EXPECT_EQ(copy, b);
+}
+
+TEST(CompressedBitmap, SmallerThanHashSet) {
+  std::mt19937 rng(1);
+  CompressedBitmap b;
+  // One million IDs out of ten million.
+  for (int i = 0; i < 1000000; ++i) b.insert(rng() % 10000000);
+  b.shrink_to_fit();
+  EXPECT_LT(b.bytes_used(), 2 * b.size());
+}
+
+TEST(CompressedBitmap, SerializeRoundTrip) {
+  std::mt19937 rng(7);
+  for (int iter = 0; iter < 5; ++iter) {
+    const std::set<uint32_t> x = RandomSet(&rng);
+    const CompressedBitmap a = FromSet(x, iter % 2 == 1);
+    const std::string data = a.Serialize();
+    CompressedBitmap b = {1, 2, 3};
+    ASSERT_TRUE(b.Deserialize(data));
+    EXPECT_EQ(a, b);
+    EXPECT_THAT(ToVector(b), ElementsAreArray(x.begin(), x.end()));
+  }
+  CompressedBitmap empty;
+  CompressedBitmap b = {1};
+  EXPECT_TRUE(b.Deserialize(empty.Serialize()));
+  EXPECT_TRUE(b.empty());
+}
+
+TEST(CompressedBitmap, DeserializeRejectsCorruptData) {
+  CompressedBitmap a = {1, 2, 3, 100000};
+  a.insert_range(200000, 300000);
+  const std::string data = a.Serialize();
+  CompressedBitmap b;
+  EXPECT_FALSE(b.Deserialize(""));
+  EXPECT_FALSE(b.Deserialize(data.substr(0, data.size() - 1)));
+  EXPECT_FALSE(b.Deserialize(data + "x"));
+  for (size_t i = 0; i < data.size(); ++i) {
+    std::string corrupt = data;
+    corrupt[i] ^= 0x5A;
+    if (b.Deserialize(corrupt)) {
+      // Some corruptions produce another valid bitmap, which must then be
+      // internally consistent.
+      EXPECT_EQ(b.size(), ToVector(b).size());
+    } else {
+      EXPECT_TRUE(b.empty());
+    }
+  }
+}
+
+}  // namespace
+}  // namespace container_internal
+}  // namespace absl
@@ -0,0 +1,377 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: dary_heap.h
+// -----------------------------------------------------------------------------
+//
+// An `absl::DaryHeap<T, Compare, D, N>` is a priority queue with the ordering
+// semantics of `std::priority_queue<T, std::vector<T>, Compare>` (`top()` is
+// the greatest element under `Compare`), implemented as a `D`-ary heap.
+//
+// A node's `D` children are adjacent in memory, so with a small element type
+// every level of a sift examines one or two cache lines, and the tree is
+// `log2(D)` times shallower than a binary heap. For heaps that do not fit in
+// cache, a `pop()` therefore touches 2 (`D = 4`) to 3 (`D = 8`) times fewer
+// cache lines, at the price of more comparisons per level.
+//
+// Every element is identified by a `handle_type` returned when it is pushed.
+// Handles allow changing the priority of an element (`update()`,
+// `decrease_key()`) and removing it (`erase()`) in O(log n), as needed by
+// timers and schedulers. A handle stays valid until its element is popped or
+// erased, after which it may be reused for a new element.
+//
+// The first `N` elements are stored inline, as in `absl::InlinedVector`.
+//
+// Example:
+//
+//   // A min-heap of deadlines.
+//   absl::DaryHeap<absl::Time, std::greater<absl::Time>> timers;
+//   auto h = timers.push(now + absl::Seconds(5));
+//   timers.decrease_key(h, now + absl::Seconds(1));  // fire earlier
+//   while (!timers.empty() && timers.top() <= now) timers.pop();
+
+#ifndef ABSL_CONTAINER_DARY_HEAP_H_
+#define ABSL_CONTAINER_DARY_HEAP_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "absl/base/macros.h"
+#include "absl/container/inlined_vector.h"
+
+namespace absl {
+
+template <typename T, typename Compare = std::less<T>, size_t D = 4,
+          size_t N = 8>
+class DaryHeap {
+  static_assert(D >= 2, "DaryHeap requires an arity of at least 2");
+
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using value_compare = Compare;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+
+  // Identifies an element of the heap.
+  class handle_type {
+   public:
+    handle_type() = default;
+
+    friend bool operator==(handle_type a, handle_type b) {
+      return a.id_ == b.id_;
+    }
+    friend bool operator!=(handle_type a, handle_type b) {
+      return a.id_ != b.id_;
+    }
+
+   private:
+    friend class DaryHeap;
+    explicit handle_type(uint32_t id) : id_(id) {}
+
+    uint32_t id_ = 0;
+  };
+
+  DaryHeap() = default;
+  explicit DaryHeap(const Compare& comp) : comp_(comp) {}
+
+  // Builds a heap from `[first, last)` in linear time. The elements receive
+  // the handles returned by `handle_at_insertion(i)` for `i` in
+  // `[0, distance(first, last))`.
+  template <typename InputIterator>
+  DaryHeap(InputIterator first, InputIterator last,
+           const Compare& comp = Compare())
+      : comp_(comp) {
+    assign(first, last);
+  }
+
+  DaryHeap(std::initializer_list<value_type> list,
+           const Compare& comp = Compare())
+      : DaryHeap(list.begin(), list.end(), comp) {}
+
+  bool empty() const { return heap_.empty(); }
+  size_type size() const { return heap_.size(); }
+
+  // Returns the greatest element under `Compare`.
+  const_reference top() const {
+    assert(!empty());
+    return heap_[0].value;
+  }
+  handle_type top_handle() const {
+    assert(!empty());
+    return handle_type(heap_[0].handle);
+  }
+
+  value_compare value_comp() const { return comp_; }
+
+  // Inserts an element and returns its handle.
+  handle_type push(const value_type& v) { return emplace(v); }
+  handle_type push(value_type&& v) { return emplace(std::move(v)); }
+
+  template <typename... Args>
+  handle_type emplace(Args&&... args) {
+    heap_.push_back(Entry{value_type(std::forward<Args>(args)...), kNone});
+    const uint32_t h = AttachHandle();
+    SiftUp(heap_.size() - 1);
+    return handle_type(h);
+  }
+
+  // Inserts `[first, last)`. When the range is large compared to the heap,
+  // the heap is rebuilt in linear time instead of sifting each element.
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    const size_type old_size = heap_.size();
+    using Category =
+        typename std::iterator_traits<InputIterator>::iterator_category;
+    ReserveFor(first, last, Category());
+    ABSL_INTERNAL_TRY {
+      for (; first != last; ++first) {
+        heap_.push_back(Entry{value_type(*first), kNone});
+        AttachHandle();
+      }
+    }
+    ABSL_INTERNAL_CATCH_ANY {
+      // Keep the elements inserted so far.
+      for (size_type i = old_size; i < heap_.size(); ++i) SiftUp(i);
+      ABSL_INTERNAL_RETHROW;
+    }
+    const size_type added = heap_.size() - old_size;
+    if (added > old_size / 2) {
+      Heapify();
+    } else {
+      for (size_type i = old_size; i < heap_.size(); ++i) SiftUp(i);
+    }
+  }
+
+  // Replaces the contents with `[first, last)` in linear time. Handles are
+  // assigned in input order; see `handle_at_insertion()`.
+  template <typename InputIterator>
+  void assign(InputIterator first, InputIterator last) {
+    clear();
+    insert(first, last);
+  }
+
+  // After `clear()` or `assign()`, the `i`-th inserted element has handle
+  // `handle_at_insertion(i)`, as long as no element has been removed since.
+  static handle_type handle_at_insertion(size_type i) {
+    return handle_type(static_cast<uint32_t>(i));
+  }
+
+  // Removes the top element.
+  void pop() {
+    assert(!empty());
+    RemoveAt(0);
+  }
+
+  // Returns true if `h` refers to an element of the heap.
+  bool contains(handle_type h) const {
+    return h.id_ < positions_.size() && (positions_[h.id_] & kFreeBit) == 0;
+  }
+
+  // Returns the element identified by `h`.
+  const_reference operator[](handle_type h) const {
+    assert(contains(h));
+    return heap_[positions_[h.id_]].value;
+  }
+
+  // Replaces the element identified by `h` with `v`, which may move in either
+  // direction.
+  void update(handle_type h, value_type v) {
+    assert(contains(h));
+    const size_type i = positions_[h.id_];
+    const bool up = comp_(heap_[i].value, v);
+    heap_[i].value = std::move(v);
+    if (up) {
+      SiftUp(i);
+    } else {
+      SiftDown(i);
+    }
+  }
+
+  // Replaces the element identified by `h` with `v`, which must not compare
+  // less than the current value: the element can only move towards the top.
+  // In a min-heap (`Compare = std::greater<T>`), this is the classic
+  // decrease-key operation.
+  void decrease_key(handle_type h, value_type v) {
+    assert(contains(h));
+    const size_type i = positions_[h.id_];
+    assert(!comp_(v, heap_[i].value));
+    heap_[i].value = std::move(v);
+    SiftUp(i);
+  }
+
+  // Removes the element identified by `h`.
+  void erase(handle_type h) {
+    assert(contains(h));
+    RemoveAt(positions_[h.id_]);
+  }
+
+  void reserve(size_type n) {
+    heap_.reserve(n);
+    positions_.reserve(n);
+  }
+
+  void clear() {
+    heap_.clear();
+    positions_.clear();
+    free_head_ = kNone;
+  }
+
+  void swap(DaryHeap& other) {
+    using std::swap;
+    heap_.swap(other.heap_);
+    positions_.swap(other.positions_);
+    swap(free_head_, other.free_head_);
+    swap(comp_, other.comp_);
+  }
+
+  friend void swap(DaryHeap& a, DaryHeap& b) { a.swap(b); }
+
+ private:
+  struct Entry {
+    value_type value;
+    uint32_t handle;
+  };
+
+  // Marks free entries of `positions_`; the low bits link the free list,
+  // which ends with `kNone`.
+  static constexpr uint32_t kFreeBit = uint32_t{1} << 31;
+  static constexpr uint32_t kNone = kFreeBit - 1;
+
+  template <typename ForwardIterator>
+  void ReserveFor(ForwardIterator first, ForwardIterator last,
+                  std::forward_iterator_tag) {
+    reserve(heap_.size() + std::distance(first, last));
+  }
+  template <typename InputIterator>
+  void ReserveFor(InputIterator, InputIterator, std::input_iterator_tag) {}
+
+  static size_type Parent(size_type i) { return (i - 1) / D; }
+  static size_type FirstChild(size_type i) { return D * i + 1; }
+
+  uint32_t AllocateHandle() {
+    if (free_head_ != kNone) {
+      const uint32_t h = free_head_;
+      free_head_ = positions_[h] & ~kFreeBit;
+      return h;
+    }
+    positions_.push_back(0);
+    return static_cast<uint32_t>(positions_.size() - 1);
+  }
+
+  // Gives the entry at the back of `heap_` a handle and returns it. If that
+  // throws, the entry is removed, so that no handle refers to it.
+  uint32_t AttachHandle() {
+    uint32_t h = kNone;
+    ABSL_INTERNAL_TRY { h = AllocateHandle(); }
+    ABSL_INTERNAL_CATCH_ANY {
+      heap_.pop_back();
+      ABSL_INTERNAL_RETHROW;
+    }
+    heap_.back().handle = h;
+    positions_[h] = static_cast<uint32_t>(heap_.size() - 1);
+    return h;
+  }
+
+  void FreeHandle(uint32_t h) {
+    positions_[h] = kFreeBit | free_head_;
+    free_head_ = h;
+  }
+
+  // Stores `e` at index `i` of `heap` and records its position. The sift
+  // loops work on raw pointers to avoid `InlinedVector`'s per-access check
+  // for inlined storage.
+  static void Place(Entry&& e, size_type i, Entry* heap, uint32_t* positions) {
+    positions[e.handle] = static_cast<uint32_t>(i);
+    heap[i] = std::move(e);
+  }
+
+  void SiftUp(size_type i) {
+    if (i == 0) return;
+    Entry* heap = heap_.data();
+    uint32_t* positions = positions_.data();
+    Entry e = std::move(heap[i]);
+    while (i > 0) {
+      const size_type parent = Parent(i);
+      if (!comp_(heap[parent].value, e.value)) break;
+      Place(std::move(heap[parent]), i, heap, positions);
+      i = parent;
+    }
+    Place(std::move(e), i, heap, positions);
+  }
+
+  void SiftDown(size_type i) {
+    const size_type n = heap_.size();
+    if (FirstChild(i) >= n) return;
+    Entry* heap = heap_.data();
+    uint32_t* positions = positions_.data();
+    Entry e = std::move(heap[i]);
+    for (;;) {
+      const size_type first = FirstChild(i);
+      if (first >= n) break;
+      const size_type last = first + D < n ? first + D : n;
+      size_type best = first;
+      for (size_type c = first + 1; c < last; ++c) {
+        if (comp_(heap[best].value, heap[c].value)) best = c;
+      }
+      if (!comp_(e.value, heap[best].value)) break;
+      Place(std::move(heap[best]), i, heap, positions);
+      i = best;
+    }
+    Place(std::move(e), i, heap, positions);
+  }
+
+  void Heapify() {
+    const size_type n = heap_.size();
+    if (n < 2) return;
+    for (size_type i = Parent(n - 1) + 1; i-- > 0;) SiftDown(i);
+  }
+
+  void RemoveAt(size_type i) {
+    FreeHandle(heap_[i].handle);
+    const size_type last = heap_.size() - 1;
+    if (i == last) {
+      heap_.pop_back();
+      return;
+    }
+    Place(std::move(heap_[last]), i, heap_.data(), positions_.data());
+    heap_.pop_back();
+    if (i > 0 && comp_(heap_[Parent(i)].value, heap_[i].value)) {
+      SiftUp(i);
+    } else {
+      SiftDown(i);
+    }
+  }
+
+  absl::InlinedVector<Entry, N> heap_;
+  // Index in `heap_` of each live handle.
+  absl::InlinedVector<uint32_t, N> positions_;
+  uint32_t free_head_ = kNone;
+  Compare comp_;
+};
+
+template <typename T, typename Compare, size_t D, size_t N>
+constexpr uint32_t DaryHeap<T, Compare, D, N>::kNone;
+template <typename T, typename Compare, size_t D, size_t N>
+constexpr uint32_t DaryHeap<T, Compare, D, N>::kFreeBit;
+
+}  // namespace absl
+
+#endif  // ABSL_CONTAINER_DARY_HEAP_H_
@@ -0,0 +1,92 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/dary_heap.h"
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+template <size_t D>
+using MaxHeap = absl::DaryHeap<uint64_t, std::less<uint64_t>, D>;
+
+std::vector<uint64_t> RandomValues(int n) {
+  std::mt19937_64 rng(42);
+  std::vector<uint64_t> values(n);
+  for (auto& v : values) v = rng();
+  return values;
+}
+
+// A heap holding `n` elements: every iteration pops the top and pushes a new
+// random element, as in a scheduler's event loop.
+template <typename Heap>
+void BM_PopPush(benchmark::State& state) {
+  const int n = state.range(0);
+  const std::vector<uint64_t> values = RandomValues(n);
+  Heap heap(values.begin(), values.end());
+  std::mt19937_64 rng(7);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(heap.top());
+    heap.pop();
+    heap.push(rng());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_PopPush, std::priority_queue<uint64_t>)
+    ->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_PopPush, MaxHeap<2>)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_PopPush, MaxHeap<4>)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_PopPush, MaxHeap<8>)->Range(1 << 10, 1 << 22);
+
+template <typename Heap>
+void BM_Heapify(benchmark::State& state) {
+  const std::vector<uint64_t> values = RandomValues(state.range(0));
+  for (auto _ : state) {
+    Heap heap(values.begin(), values.end());
+    benchmark::DoNotOptimize(heap.top());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Heapify, std::priority_queue<uint64_t>)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Heapify, MaxHeap<4>)->Range(1 << 10, 1 << 20);
+
+// A min-heap of `n` deadlines where every iteration moves a random element
+// earlier, as in Dijkstra's algorithm.
+template <size_t D>
+void BM_DecreaseKey(benchmark::State& state) {
+  using Heap = absl::DaryHeap<uint64_t, std::greater<uint64_t>, D>;
+  const int n = state.range(0);
+  std::vector<uint64_t> values = RandomValues(n);
+  Heap heap(values.begin(), values.end());
+  std::mt19937 rng(7);
+  for (auto _ : state) {
+    const int i = rng() % n;
+    values[i] -= values[i] / 8;
+    heap.decrease_key(Heap::handle_at_insertion(i), values[i]);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_DecreaseKey, 2)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_DecreaseKey, 4)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_DecreaseKey, 8)->Range(1 << 10, 1 << 22);
+
+}  // namespace
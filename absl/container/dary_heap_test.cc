@@ -0,0 +1,288 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/dary_heap.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/base/config.h"
+
+namespace {
+
+using testing::ElementsAre;
+
+template <typename Heap>
+std::vector<typename Heap::value_type> Drain(Heap* heap) {
+  std::vector<typename Heap::value_type> out;
+  while (!heap->empty()) {
+    out.push_back(heap->top());
+    heap->pop();
+  }
+  return out;
+}
+
+TEST(DaryHeapTest, Empty) {
+  absl::DaryHeap<int> heap;
+  EXPECT_TRUE(heap.empty());
+  EXPECT_EQ(0, heap.size());
+}
+
+TEST(DaryHeapTest, PopsInPriorityOrder) {
+  absl::DaryHeap<int> heap;
+  for (int v : {5, 1, 9, 3, 7, 3, 8}) heap.push(v);
+  EXPECT_EQ(7, heap.size());
+  EXPECT_EQ(9, heap.top());
+  EXPECT_THAT(Drain(&heap), ElementsAre(9, 8, 7, 5, 3, 3, 1));
+
+  absl::DaryHeap<int, std::greater<int>> min_heap = {5, 1, 9, 3};
+  EXPECT_THAT(Drain(&min_heap), ElementsAre(1, 3, 5, 9));
+}
+
+template <size_t D>
+void CheckMatchesPriorityQueue() {
+  std::mt19937 rng(D);
+  absl::DaryHeap<int, std::less<int>, D> heap;
+  std::priority_queue<int> expected;
+  for (int i = 0; i < 20000; ++i) {
+    if (expected.empty() || rng() % 3 != 0) {
+      const int v = rng() % 1000;
+      heap.push(v);
+      expected.push(v);
+    } else {
+      ASSERT_EQ(expected.top(), heap.top());
+      heap.pop();
+      expected.pop();
+    }
+    ASSERT_EQ(expected.size(), heap.size());
+  }
+  while (!expected.empty()) {
+    ASSERT_EQ(expected.top(), heap.top());
+    heap.pop();
+    expected.pop();
+  }
+}
+
+TEST(DaryHeapTest, MatchesPriorityQueue) {
+  CheckMatchesPriorityQueue<2>();
+  CheckMatchesPriorityQueue<3>();
+  CheckMatchesPriorityQueue<4>();
+  CheckMatchesPriorityQueue<8>();
+}
+
+TEST(DaryHeapTest, BulkHeapify) {
+  std::vector<int> values(1000);
+  for (int i = 0; i < 1000; ++i) values[i] = (i * 7919) % 1000;
+  absl::DaryHeap<int, std::less<int>, 8> heap(values.begin(), values.end());
+  EXPECT_EQ(1000, heap.size());
+  for (int i = 0; i < 1000; ++i) {
+    const auto h = heap.handle_at_insertion(i);
+    ASSERT_TRUE(heap.contains(h));
+    ASSERT_EQ(values[i], heap[h]);
+  }
+  std::vector<int> sorted = values;
+  std::sort(sorted.rbegin(), sorted.rend());
+  EXPECT_EQ(sorted, Drain(&heap));
+
+  // Small bulk insertions into a large heap sift each element instead.
+  heap.assign(values.begin(), values.end());
+  heap.insert(values.begin(), values.begin() + 10);
+  EXPECT_EQ(1010, heap.size());
+  sorted.insert(sorted.end(), values.begin(), values.begin() + 10);
+  std::sort(sorted.rbegin(), sorted.rend());
+  EXPECT_EQ(sorted, Drain(&heap));
+}
+
+TEST(DaryHeapTest, HandlesTrackElements) {
+  absl::DaryHeap<int, std::greater<int>> heap;
+  std::vector<absl::DaryHeap<int, std::greater<int>>::handle_type> handles;
+  for (int i = 0; i < 100; ++i) handles.push_back(heap.push(100 + i));
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(heap.contains(handles[i]));
+    ASSERT_EQ(100 + i, heap[handles[i]]);
+  }
+
+  heap.decrease_key(handles[50], 1);
+  EXPECT_EQ(1, heap.top());
+  EXPECT_EQ(handles[50], heap.top_handle());
+
+  heap.update(handles[50], 500);
+  EXPECT_EQ(100, heap.top());
+  heap.update(handles[99], 0);
+  EXPECT_EQ(0, heap.top());
+
+  heap.erase(handles[10]);
+  EXPECT_FALSE(heap.contains(handles[10]));
+  heap.pop();  // 0, formerly 199.
+  EXPECT_FALSE(heap.contains(handles[99]));
+  EXPECT_EQ(98, heap.size());
+
+  // Freed handles are reused.
+  const auto h = heap.push(-1);
+  EXPECT_TRUE(h == handles[10] || h == handles[99]);
+  EXPECT_EQ(-1, heap[h]);
+  EXPECT_EQ(h, heap.top_handle());
+
+  std::vector<int> expected = {-1};
+  for (int i = 0; i < 99; ++i) {
+    if (i != 10 && i != 50) expected.push_back(100 + i);
+  }
+  expected.push_back(500);
+  EXPECT_EQ(expected, Drain(&heap));
+}
+
+TEST(DaryHeapTest, RandomHandleOperations) {
+  std::mt19937 rng(3);
+  using Heap = absl::DaryHeap<int, std::less<int>, 4, 4>;
+  Heap heap;
+  std::map<int, Heap::handle_type> live;  // Unique value -> handle.
+  int next_value = 0;
+  for (int i = 0; i < 20000; ++i) {
+    const int op = rng() % 4;
+    if (live.empty() || op == 0) {
+      const int v = next_value++ * 2;
+      live[v] = heap.push(v);
+    } else if (op == 1) {
+      ASSERT_EQ(live.rbegin()->first, heap.top());
+      live.erase(std::prev(live.end()));
+      heap.pop();
+    } else {
+      auto it = live.begin();
+      std::advance(it, rng() % live.size());
+      const Heap::handle_type h = it->second;
+      live.erase(it);
+      if (op == 2) {
+        heap.erase(h);
+      } else {
+        // Odd values never collide with pushed values.
+        int v = static_cast<int>(rng() % (2 * next_value + 2)) | 1;
+        while (live.count(v)) v += 2;
+        heap.update(h, v);
+        live[v] = h;
+      }
+    }
+    ASSERT_EQ(live.size(), heap.size());
+  }
+  for (const auto& e : live) ASSERT_EQ(e.first, heap[e.second]);
+}
+
+TEST(DaryHeapTest, MoveOnlyValues) {
+  struct Less {
+    bool operator()(const std::unique_ptr<int>& a,
+                    const std::unique_ptr<int>& b) const {
+      return *a < *b;
+    }
+  };
+  absl::DaryHeap<std::unique_ptr<int>, Less> heap;
+  for (int i = 0; i < 20; ++i) heap.push(std::unique_ptr<int>(new int(i)));
+  EXPECT_EQ(19, *heap.top());
+  heap.pop();
+  EXPECT_EQ(18, *heap.top());
+}
+
+TEST(DaryHeapTest, SwapAndClear) {
+  absl::DaryHeap<std::string> a = {"b", "a"};
+  absl::DaryHeap<std::string> b = {"z"};
+  swap(a, b);
+  EXPECT_EQ("z", a.top());
+  EXPECT_EQ("b", b.top());
+  a.clear();
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(a.handle_at_insertion(0), a.push("x"));
+}
+
+#ifdef ABSL_HAVE_EXCEPTIONS
+// Throws when copied while `throw_on_copy` is set.
+struct ThrowingCopy {
+  static bool throw_on_copy;
+  int value;
+  explicit ThrowingCopy(int v) : value(v) {}
+  ThrowingCopy(const ThrowingCopy& that) : value(that.value) {
+    if (throw_on_copy) throw std::runtime_error("copy");
+  }
+  ThrowingCopy(ThrowingCopy&&) = default;
+  ThrowingCopy& operator=(ThrowingCopy&&) = default;
+  friend bool operator<(const ThrowingCopy& a, const ThrowingCopy& b) {
+    return a.value < b.value;
+  }
+};
+bool ThrowingCopy::throw_on_copy = false;
+
+TEST(DaryHeapTest, ThrowingInsertLeavesNoHandle) {
+  absl::DaryHeap<ThrowingCopy> heap;
+  heap.push(ThrowingCopy(1));
+  heap.push(ThrowingCopy(2));
+  const ThrowingCopy three(3);
+  const std::vector<ThrowingCopy> values = {ThrowingCopy(4), ThrowingCopy(5)};
+  ThrowingCopy::throw_on_copy = true;
+  EXPECT_THROW(heap.push(three), std::runtime_error);
+  EXPECT_THROW(heap.insert(values.begin(), values.end()), std::runtime_error);
+  ThrowingCopy::throw_on_copy = false;
+  EXPECT_EQ(2, heap.size());
+  EXPECT_FALSE(heap.contains(heap.handle_at_insertion(2)));
+  EXPECT_EQ(heap.handle_at_insertion(2), heap.push(three));
+  EXPECT_EQ(3, heap[heap.handle_at_insertion(2)].value);
+  EXPECT_EQ(3, heap.top().value);
+}
+
+// An input iterator over `ThrowingCopy`s whose negative values throw when
+// copied.
+struct ThrowOnNegativeIterator {
+  using iterator_category = std::input_iterator_tag;
+  using value_type = ThrowingCopy;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const ThrowingCopy*;
+  using reference = const ThrowingCopy&;
+
+  reference operator*() const {
+    ThrowingCopy::throw_on_copy = p->value < 0;
+    return *p;
+  }
+  ThrowOnNegativeIterator& operator++() {
+    ++p;
+    return *this;
+  }
+  bool operator!=(const ThrowOnNegativeIterator& that) const {
+    return p != that.p;
+  }
+
+  const ThrowingCopy* p;
+};
+
+TEST(DaryHeapTest, ThrowingRangeInsertKeepsEarlierElements) {
+  absl::DaryHeap<ThrowingCopy> heap;
+  heap.push(ThrowingCopy(5));
+  const ThrowingCopy values[] = {ThrowingCopy(9), ThrowingCopy(-1)};
+  EXPECT_THROW(heap.insert(ThrowOnNegativeIterator{values},
+                           ThrowOnNegativeIterator{values + 2}),
+               std::runtime_error);
+  ThrowingCopy::throw_on_copy = false;
+  ASSERT_EQ(2, heap.size());
+  EXPECT_EQ(9, heap.top().value);
+  EXPECT_EQ(9, heap[heap.handle_at_insertion(1)].value);
+  EXPECT_FALSE(heap.contains(heap.handle_at_insertion(2)));
+}
+#endif  // ABSL_HAVE_EXCEPTIONS
+
+}  // namespace
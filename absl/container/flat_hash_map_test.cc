@@ -14,6 +14,9 @@
 
 #include "absl/container/flat_hash_map.h"
 
+#include <functional>
+#include <string>
+
 #include "absl/container/internal/hash_generator_testing.h"
 #include "absl/container/internal/unordered_map_constructor_test.h"
 #include "absl/container/internal/unordered_map_lookup_test.h"
@@ -239,6 +242,54 @@ TEST(FlatHashMap, Any) {
 }
 #endif  // __ANDROID__
 
+TEST(FlatHashMap, HashedKey) {
+  flat_hash_map<std::string, int> m = {{"status", 1}, {"code", 2}};
+  const absl::HashedKey<absl::string_view> status("status");
+  const absl::HashedKey<absl::string_view> missing("missing");
+  auto it = m.find(status);
+  ASSERT_TRUE(it != m.end());
+  EXPECT_EQ(1, it->second);
+  EXPECT_TRUE(m.find(missing) == m.end());
+  EXPECT_TRUE(m.contains(status));
+  EXPECT_FALSE(m.contains(missing));
+  EXPECT_EQ(1, m.count(status));
+  EXPECT_EQ(0, m.count(missing));
+
+  const auto& cm = m;
+  EXPECT_EQ(2, cm.find(absl::HashedKey<std::string>("code"))->second);
+
+  flat_hash_map<int, int> ints = {{7, 70}};
+  EXPECT_EQ(70, ints.find(absl::HashedKey<int>(7))->second);
+  EXPECT_FALSE(ints.contains(absl::HashedKey<int>(8)));
+}
+
+struct StdStringHash {
+  size_t operator()(const std::string& s) const {
+    return std::hash<std::string>()(s);
+  }
+};
+
+// The stored hash is that of absl::Hash<K>, which other hashers, and the
+// default hasher for other key types, do not match: the key is hashed again.
+TEST(FlatHashMap, HashedKeyWithOtherHash) {
+  flat_hash_map<std::string, int, StdStringHash> m = {{"status", 1}};
+  const absl::HashedKey<std::string> status("status");
+  const absl::HashedKey<std::string> missing("missing");
+  EXPECT_EQ(1, m.find(status)->second);
+  EXPECT_TRUE(m.contains(status));
+  EXPECT_EQ(0, m.count(missing));
+
+  // absl::Hash<const char*> hashes the pointer.
+  flat_hash_map<std::string, int> d = {{"status", 1}};
+  const absl::HashedKey<const char*> literal("status");
+  EXPECT_EQ(1, d.find(literal)->second);
+  EXPECT_TRUE(d.contains(literal));
+
+  // absl::Hash<long> is not the hasher of int keys.
+  flat_hash_map<int, int> ints = {{7, 70}};
+  EXPECT_EQ(70, ints.find(absl::HashedKey<long>(7))->second);
+}
+
 }  // namespace
 }  // namespace container_internal
 }  // namespace absl
@@ -0,0 +1,516 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: flat_hash_multimap.h
+// -----------------------------------------------------------------------------
+//
+// An `absl::flat_hash_multimap<K, V>` is an unordered associative container
+// that maps each key to any number of values, intended as a replacement for
+// both `std::unordered_multimap` and the common
+// `flat_hash_map<K, std::vector<V>>` idiom.
+//
+// Every distinct key is stored once, in a Swiss table. The values of all keys
+// share a single array; the values of one key form a linked list through that
+// array, in insertion order. Compared to a map of vectors this avoids one
+// allocation per key and keeps all values densely packed, and compared to
+// `std::unordered_multimap` it stores each key once and allocates no nodes.
+
+#ifndef ABSL_CONTAINER_FLAT_HASH_MULTIMAP_H_
+#define ABSL_CONTAINER_FLAT_HASH_MULTIMAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/base/internal/throw_delegate.h"
+#include "absl/base/macros.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/memory/memory.h"
+
+namespace absl {
+namespace container_internal {
+
+// The values stored under one key of a `flat_hash_multimap`, as a list of
+// indices into the shared value array.
+struct MultimapChain {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t size;
+};
+
+}  // namespace container_internal
+
+// -----------------------------------------------------------------------------
+// absl::flat_hash_multimap
+// -----------------------------------------------------------------------------
+//
+// An `absl::flat_hash_multimap<K, V>` associates each key with a list of
+// values. Its interface follows `std::unordered_multimap<K, V>` with the
+// following notable differences:
+//
+// * Values of the same key are kept in insertion order.
+// * `count()` is `O(1)`, and `erase(key)` is `O(1)` for trivially destructible
+//   values.
+// * Iterators dereference to a `std::pair<const K&, V&>` proxy rather than to
+//   a `value_type&`.
+// * Insertion invalidates all iterators, pointers and references.
+// * `erase(iterator)` invalidates iterators to the erased element and to the
+//   element that follows it; continue with the returned iterator.
+// * Values must be MoveConstructible and MoveAssignable. Erased values are
+//   moved from and their storage is reused by later insertions.
+// * Supports grouped insertion of many values under one key with a single
+//   lookup, through `insert(key, first, last)`.
+// * At most 2^32 - 1 values can be stored.
+//
+// Example:
+//
+//   absl::flat_hash_multimap<std::string, int> postings;
+//   postings.insert("apple", {1, 4, 9});
+//   postings.emplace("pear", 4);
+//
+//   for (auto it = postings.equal_range("apple"); it.first != it.second;
+//        ++it.first) {
+//     std::cout << it.first->second << std::endl;  // 1, 4, 9
+//   }
+template <class K, class V,
+          class Hash = absl::container_internal::hash_default_hash<K>,
+          class Eq = absl::container_internal::hash_default_eq<K>,
+          class Allocator = std::allocator<std::pair<const K, V>>>
+class flat_hash_multimap {
+  using Chain = container_internal::MultimapChain;
+
+  struct Node {
+    template <class... Args>
+    explicit Node(Args&&... args)
+        : value(std::forward<Args>(args)...), next(kNone) {}
+
+    V value;
+    uint32_t next;
+  };
+
+  using AllocTraits = absl::allocator_traits<Allocator>;
+  using Keys = absl::flat_hash_map<
+      K, Chain, Hash, Eq,
+      typename AllocTraits::template rebind_alloc<std::pair<const K, Chain>>>;
+  using Nodes =
+      std::vector<Node, typename AllocTraits::template rebind_alloc<Node>>;
+
+  static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+  template <bool kConst>
+  class Iter {
+    using Map = typename std::conditional<kConst, const flat_hash_multimap,
+                                          flat_hash_multimap>::type;
+    using KeyIter =
+        typename std::conditional<kConst, typename Keys::const_iterator,
+                                  typename Keys::iterator>::type;
+    using Mapped = typename std::conditional<kConst, const V, V>::type;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<const K, V>;
+    using reference = std::pair<const K&, Mapped&>;
+    using difference_type = ptrdiff_t;
+
+    // `operator->` returns a proxy holding the reference.
+    class pointer {
+     public:
+      const reference* operator->() const { return &ref_; }
+
+     private:
+      friend class Iter;
+      explicit pointer(reference ref) : ref_(ref) {}
+      reference ref_;
+    };
+
+    Iter() = default;
+
+    // Conversion from `iterator` to `const_iterator`.
+    template <bool C = kConst, typename std::enable_if<C, int>::type = 0>
+    Iter(const Iter<false>& it)  // NOLINT
+        : map_(it.map_), key_(it.key_), node_(it.node_), prev_(it.prev_) {}
+
+    reference operator*() const {
+      return reference(key_->first, map_->nodes_[node_].value);
+    }
+    pointer operator->() const { return pointer(**this); }
+
+    Iter& operator++() {
+      prev_ = node_;
+      node_ = map_->nodes_[node_].next;
+      if (node_ == kNone) {
+        ++key_;
+        prev_ = kNone;
+        node_ = key_ == map_->keys_.end() ? kNone : key_->second.head;
+      }
+      return *this;
+    }
+    Iter operator++(int) {
+      Iter tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    // Every value has its own index, and the end position has none.
+    friend bool operator==(const Iter& a, const Iter& b) {
+      return a.node_ == b.node_;
+    }
+    friend bool operator!=(const Iter& a, const Iter& b) {
+      return a.node_ != b.node_;
+    }
+
+   private:
+    friend class flat_hash_multimap;
+    friend class Iter<true>;
+
+    // Points to the first value of `key`, or to the end.
+    Iter(Map* map, KeyIter key)
+        : map_(map),
+          key_(key),
+          node_(key == map->keys_.end() ? kNone : key->second.head),
+          prev_(kNone) {}
+    Iter(Map* map, KeyIter key, uint32_t node, uint32_t prev)
+        : map_(map), key_(key), node_(node), prev_(prev) {}
+
+    Map* map_ = nullptr;
+    KeyIter key_;
+    uint32_t node_ = kNone;
+    uint32_t prev_ = kNone;  // The previous value under the same key.
+  };
+
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<const K, V>;
+  using init_type = std::pair<K, V>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = Eq;
+  using allocator_type = Allocator;
+  using reference = std::pair<const K&, V&>;
+  using const_reference = std::pair<const K&, const V&>;
+  using iterator = Iter<false>;
+  using const_iterator = Iter<true>;
+
+  template <class Key>
+  using key_arg = typename Keys::template key_arg<Key>;
+
+  flat_hash_multimap() = default;
+
+  explicit flat_hash_multimap(size_type bucket_count,
+                              const hasher& hash = hasher(),
+                              const key_equal& eq = key_equal(),
+                              const allocator_type& alloc = allocator_type())
+      : keys_(bucket_count, hash, eq, typename Keys::allocator_type(alloc)),
+        nodes_(typename Nodes::allocator_type(alloc)) {}
+
+  explicit flat_hash_multimap(const allocator_type& alloc)
+      : flat_hash_multimap(0, hasher(), key_equal(), alloc) {}
+
+  template <class InputIter>
+  flat_hash_multimap(InputIter first, InputIter last,
+                     size_type bucket_count = 0, const hasher& hash = hasher(),
+                     const key_equal& eq = key_equal(),
+                     const allocator_type& alloc = allocator_type())
+      : flat_hash_multimap(bucket_count, hash, eq, alloc) {
+    insert(first, last);
+  }
+
+  flat_hash_multimap(std::initializer_list<init_type> init,
+                     size_type bucket_count = 0, const hasher& hash = hasher(),
+                     const key_equal& eq = key_equal(),
+                     const allocator_type& alloc = allocator_type())
+      : flat_hash_multimap(init.begin(), init.end(), bucket_count, hash, eq,
+                           alloc) {}
+
+  flat_hash_multimap(const flat_hash_multimap&) = default;
+  flat_hash_multimap& operator=(const flat_hash_multimap&) = default;
+
+  flat_hash_multimap(flat_hash_multimap&& that) noexcept(
+      std::is_nothrow_move_constructible<Keys>::value&&
+          std::is_nothrow_move_constructible<Nodes>::value)
+      : keys_(std::move(that.keys_)),
+        nodes_(std::move(that.nodes_)),
+        free_(that.free_),
+        size_(that.size_) {
+    that.clear();
+  }
+
+  flat_hash_multimap& operator=(flat_hash_multimap&& that) noexcept(
+      std::is_nothrow_move_assignable<Keys>::value&&
+          std::is_nothrow_move_assignable<Nodes>::value) {
+    keys_ = std::move(that.keys_);
+    nodes_ = std::move(that.nodes_);
+    free_ = that.free_;
+    size_ = that.size_;
+    that.clear();
+    return *this;
+  }
+
+  iterator begin() { return iterator(this, keys_.begin()); }
+  iterator end() { return iterator(this, keys_.end()); }
+  const_iterator begin() const { return const_iterator(this, keys_.begin()); }
+  const_iterator end() const { return const_iterator(this, keys_.end()); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  // Total number of values.
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_type max_size() const { return kNone; }
+
+  // Number of distinct keys.
+  size_type key_count() const { return keys_.size(); }
+
+  void clear() {
+    keys_.clear();
+    nodes_.clear();
+    free_ = kNone;
+    size_ = 0;
+  }
+
+  // Reserves room for `n` values in total.
+  void reserve(size_type n) { nodes_.reserve(n); }
+
+  // Reserves room for `n` distinct keys.
+  void rehash(size_type n) { keys_.reserve(n); }
+
+  // Adds a value under `key`, constructed from `args`, after the existing
+  // values of `key`. Returns an iterator to the new value.
+  template <class Key = key_type, class... Args>
+  iterator emplace(key_arg<Key>&& key, Args&&... args) {
+    return EmplaceImpl(std::forward<Key>(key), std::forward<Args>(args)...);
+  }
+  template <class Key = key_type, class... Args>
+  iterator emplace(const key_arg<Key>& key, Args&&... args) {
+    return EmplaceImpl(key, std::forward<Args>(args)...);
+  }
+
+  iterator insert(const init_type& v) { return emplace(v.first, v.second); }
+  iterator insert(init_type&& v) {
+    return emplace(std::move(v.first), std::move(v.second));
+  }
+
+  template <class InputIter>
+  void insert(InputIter first, InputIter last) {
+    for (; first != last; ++first) emplace(first->first, first->second);
+  }
+  void insert(std::initializer_list<init_type> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  // Grouped insertion: adds all values of `[first, last)` under `key` with a
+  // single lookup. The new values are stored contiguously unless erased values
+  // are being reused. Returns an iterator to the first new value, or `end()`
+  // if the range is empty.
+  template <class Key = key_type, class InputIter>
+  iterator insert(const key_arg<Key>& key, InputIter first, InputIter last) {
+    if (first == last) return end();
+    using Category =
+        typename std::iterator_traits<InputIter>::iterator_category;
+    if (std::is_base_of<std::forward_iterator_tag, Category>::value &&
+        free_ == kNone) {
+      // Grow geometrically, as push_back would: reserving exactly what each
+      // call needs makes repeated grouped inserts quadratic.
+      const size_t needed = nodes_.size() + std::distance(first, last);
+      if (needed > nodes_.capacity()) {
+        nodes_.reserve(std::max(needed, 2 * nodes_.capacity()));
+      }
+    }
+    iterator result = EmplaceImpl(key, *first);
+    auto key_it = result.key_;
+    for (++first; first != last; ++first) Append(key_it, NewNode(*first));
+    return result;
+  }
+  template <class Key = key_type>
+  iterator insert(const key_arg<Key>& key, std::initializer_list<V> values) {
+    return insert(key, values.begin(), values.end());
+  }
+
+  // Returns an iterator to the first value of `key`, or `end()`.
+  template <class Key = key_type>
+  iterator find(const key_arg<Key>& key) {
+    return iterator(this, keys_.find(key));
+  }
+  template <class Key = key_type>
+  const_iterator find(const key_arg<Key>& key) const {
+    return const_iterator(this, keys_.find(key));
+  }
+
+  // Returns the range of values of `key`, in insertion order.
+  template <class Key = key_type>
+  std::pair<iterator, iterator> equal_range(const key_arg<Key>& key) {
+    auto it = keys_.find(key);
+    if (it == keys_.end()) return {end(), end()};
+    return {iterator(this, it), iterator(this, std::next(it))};
+  }
+  template <class Key = key_type>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_arg<Key>& key) const {
+    auto it = keys_.find(key);
+    if (it == keys_.end()) return {end(), end()};
+    return {const_iterator(this, it), const_iterator(this, std::next(it))};
+  }
+
+  template <class Key = key_type>
+  size_type count(const key_arg<Key>& key) const {
+    auto it = keys_.find(key);
+    return it == keys_.end() ? 0 : it->second.size;
+  }
+
+  template <class Key = key_type>
+  bool contains(const key_arg<Key>& key) const {
+    return keys_.contains(key);
+  }
+
+  // Erases all values of `key`. Returns the number of erased values.
+  template <class Key = key_type>
+  size_type erase(const key_arg<Key>& key) {
+    auto it = keys_.find(key);
+    if (it == keys_.end()) return 0;
+    const Chain chain = it->second;
+    keys_.erase(it);
+    if (!std::is_trivially_destructible<V>::value) {
+      for (uint32_t n = chain.head; n != kNone; n = nodes_[n].next) {
+        Release(n);
+      }
+    }
+    nodes_[chain.tail].next = free_;
+    free_ = chain.head;
+    size_ -= chain.size;
+    return chain.size;
+  }
+
+  // Erases the value at `pos`. Returns an iterator to the following value.
+  iterator erase(iterator pos) {
+    Chain& chain = pos.key_->second;
+    const uint32_t n = pos.node_;
+    const uint32_t next = nodes_[n].next;
+    if (pos.prev_ == kNone) {
+      chain.head = next;
+    } else {
+      nodes_[pos.prev_].next = next;
+    }
+    if (chain.tail == n) chain.tail = pos.prev_;
+    FreeNode(n);
+    --size_;
+    if (--chain.size == 0) {
+      auto next_key = std::next(pos.key_);
+      keys_.erase(pos.key_);
+      return iterator(this, next_key);
+    }
+    if (next != kNone) return iterator(this, pos.key_, next, pos.prev_);
+    return iterator(this, std::next(pos.key_));
+  }
+
+  void swap(flat_hash_multimap& that) {
+    using std::swap;
+    swap(keys_, that.keys_);
+    swap(nodes_, that.nodes_);
+    swap(free_, that.free_);
+    swap(size_, that.size_);
+  }
+
+  hasher hash_function() const { return keys_.hash_function(); }
+  key_equal key_eq() const { return keys_.key_eq(); }
+  allocator_type get_allocator() const {
+    return allocator_type(keys_.get_allocator());
+  }
+
+  friend void swap(flat_hash_multimap& a, flat_hash_multimap& b) { a.swap(b); }
+
+ private:
+  template <class KeyArg, class... Args>
+  iterator EmplaceImpl(KeyArg&& key, Args&&... args) {
+    // Create the value first so that a throwing constructor does not leave a
+    // key without values behind.
+    const uint32_t n = NewNode(std::forward<Args>(args)...);
+    typename Keys::iterator key_it;
+    ABSL_INTERNAL_TRY {
+      key_it = keys_
+                   .try_emplace(std::forward<KeyArg>(key),
+                                Chain{kNone, kNone, 0})
+                   .first;
+    }
+    ABSL_INTERNAL_CATCH_ANY {
+      FreeNode(n);
+      ABSL_INTERNAL_RETHROW;
+    }
+    return Append(key_it, n);
+  }
+
+  iterator Append(typename Keys::iterator key_it, uint32_t n) {
+    Chain& chain = key_it->second;
+    if (chain.tail == kNone) {
+      chain.head = n;
+    } else {
+      nodes_[chain.tail].next = n;
+    }
+    iterator result(this, key_it, n, chain.tail);
+    chain.tail = n;
+    ++chain.size;
+    ++size_;
+    return result;
+  }
+
+  // Returns the index of a new, unlinked value constructed from `args`.
+  template <class... Args>
+  uint32_t NewNode(Args&&... args) {
+    if (free_ != kNone) {
+      const uint32_t n = free_;
+      nodes_[n].value = V(std::forward<Args>(args)...);
+      free_ = nodes_[n].next;
+      nodes_[n].next = kNone;
+      return n;
+    }
+    if (nodes_.size() >= kNone) {
+      base_internal::ThrowStdLengthError("absl::flat_hash_multimap: too large");
+    }
+    nodes_.emplace_back(std::forward<Args>(args)...);
+    return static_cast<uint32_t>(nodes_.size() - 1);
+  }
+
+  // Returns the unlinked value `n` to the list of erased values.
+  void FreeNode(uint32_t n) {
+    Release(n);
+    nodes_[n].next = free_;
+    free_ = n;
+  }
+
+  // Frees the resources of an erased value by moving from it.
+  void Release(uint32_t n) {
+    V discard(std::move(nodes_[n].value));
+    (void)discard;
+  }
+
+  Keys keys_;
+  Nodes nodes_;
+  uint32_t free_ = kNone;  // Head of the list of erased values.
+  size_t size_ = 0;
+};
+
+template <class K, class V, class Hash, class Eq, class Allocator>
+constexpr uint32_t flat_hash_multimap<K, V, Hash, Eq, Allocator>::kNone;
+
+}  // namespace absl
+
+#endif  // ABSL_CONTAINER_FLAT_HASH_MULTIMAP_H_
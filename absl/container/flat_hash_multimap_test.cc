@@ -0,0 +1,319 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/flat_hash_multimap.h"
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/base/config.h"
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
+
+namespace absl {
+namespace container_internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+using ::testing::UnorderedElementsAreArray;
+
+template <class Map, class Key>
+std::vector<typename Map::mapped_type> Values(const Map& m, const Key& key) {
+  std::vector<typename Map::mapped_type> out;
+  auto range = m.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    out.push_back(it->second);
+  }
+  return out;
+}
+
+template <class Map>
+std::vector<std::pair<typename Map::key_type, typename Map::mapped_type>>
+Items(const Map& m) {
+  std::vector<std::pair<typename Map::key_type, typename Map::mapped_type>>
+      out;
+  for (const auto& kv : m) out.emplace_back(kv.first, kv.second);
+  return out;
+}
+
+TEST(FlatHashMultimap, Empty) {
+  flat_hash_multimap<int, int> m;
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(0, m.size());
+  EXPECT_EQ(m.begin(), m.end());
+  EXPECT_EQ(0, m.count(1));
+  EXPECT_FALSE(m.contains(1));
+  EXPECT_EQ(m.end(), m.find(1));
+  EXPECT_THAT(Values(m, 1), IsEmpty());
+}
+
+TEST(FlatHashMultimap, ValuesKeepInsertionOrder) {
+  flat_hash_multimap<int, int> m;
+  m.emplace(1, 10);
+  m.emplace(2, 20);
+  m.emplace(1, 11);
+  m.insert({1, 12});
+  m.insert(std::make_pair(3, 30));
+  EXPECT_EQ(5, m.size());
+  EXPECT_EQ(3, m.key_count());
+  EXPECT_EQ(3, m.count(1));
+  EXPECT_THAT(Values(m, 1), ElementsAre(10, 11, 12));
+  EXPECT_THAT(Values(m, 2), ElementsAre(20));
+  EXPECT_THAT(Values(m, 3), ElementsAre(30));
+  EXPECT_EQ(10, m.find(1)->second);
+  EXPECT_THAT(Items(m), UnorderedElementsAre(Pair(1, 10), Pair(1, 11),
+                                             Pair(1, 12), Pair(2, 20),
+                                             Pair(3, 30)));
+}
+
+TEST(FlatHashMultimap, EmplaceReturnsNewValue) {
+  flat_hash_multimap<int, int> m;
+  m.emplace(1, 10);
+  auto it = m.emplace(1, 11);
+  EXPECT_EQ(1, it->first);
+  EXPECT_EQ(11, it->second);
+  (*it).second = 12;
+  EXPECT_THAT(Values(m, 1), ElementsAre(10, 12));
+}
+
+TEST(FlatHashMultimap, GroupedInsert) {
+  flat_hash_multimap<std::string, int> m;
+  std::vector<int> postings = {4, 8, 15, 16, 23, 42};
+  auto it = m.insert("lost", postings.begin(), postings.end());
+  EXPECT_EQ("lost", it->first);
+  EXPECT_EQ(4, it->second);
+  m.insert("found", {1, 2});
+  m.insert("lost", {99});
+  EXPECT_EQ(m.end(), m.insert("none", postings.end(), postings.end()));
+  EXPECT_FALSE(m.contains("none"));
+  EXPECT_EQ(9, m.size());
+  EXPECT_THAT(Values(m, "lost"), ElementsAre(4, 8, 15, 16, 23, 42, 99));
+  EXPECT_THAT(Values(m, "found"), ElementsAre(1, 2));
+}
+
+TEST(FlatHashMultimap, EraseKey) {
+  flat_hash_multimap<int, std::string> m = {
+      {1, "a"}, {2, "b"}, {1, "c"}, {3, "d"}};
+  EXPECT_EQ(2, m.erase(1));
+  EXPECT_EQ(0, m.erase(1));
+  EXPECT_EQ(2, m.size());
+  EXPECT_FALSE(m.contains(1));
+  // Erased values are reused.
+  m.emplace(4, "e");
+  m.emplace(4, "f");
+  m.emplace(4, "g");
+  EXPECT_THAT(Values(m, 4), ElementsAre("e", "f", "g"));
+  EXPECT_THAT(Items(m), UnorderedElementsAre(Pair(2, "b"), Pair(3, "d"),
+                                             Pair(4, "e"), Pair(4, "f"),
+                                             Pair(4, "g")));
+}
+
+TEST(FlatHashMultimap, EraseIterator) {
+  flat_hash_multimap<int, int> m;
+  for (int i = 0; i < 100; ++i) m.emplace(i % 7, i);
+  for (auto it = m.begin(); it != m.end();) {
+    if (it->second % 3 == 0) {
+      it = m.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  std::vector<std::pair<int, int>> expected;
+  for (int i = 0; i < 100; ++i) {
+    if (i % 3 != 0) expected.emplace_back(i % 7, i);
+  }
+  EXPECT_EQ(expected.size(), m.size());
+  EXPECT_THAT(Items(m), UnorderedElementsAreArray(expected));
+  EXPECT_THAT(Values(m, 0), ElementsAre(7, 14, 28, 35, 49, 56, 70, 77, 91, 98));
+
+  // Erase the tail of a chain and append after it.
+  auto range = m.equal_range(0);
+  auto last = range.first;
+  for (auto it = range.first; it != range.second; ++it) last = it;
+  m.erase(last);
+  m.emplace(0, 1000);
+  EXPECT_THAT(Values(m, 0),
+              ElementsAre(7, 14, 28, 35, 49, 56, 70, 77, 91, 1000));
+}
+
+TEST(FlatHashMultimap, EraseLastValueRemovesKey) {
+  flat_hash_multimap<int, int> m = {{1, 1}, {2, 2}};
+  m.erase(m.find(1));
+  EXPECT_FALSE(m.contains(1));
+  EXPECT_EQ(1, m.key_count());
+  EXPECT_THAT(Items(m), ElementsAre(Pair(2, 2)));
+}
+
+TEST(FlatHashMultimap, HeterogeneousLookup) {
+  flat_hash_multimap<std::string, int> m = {{"a", 1}, {"a", 2}, {"b", 3}};
+  absl::string_view a = "a";
+  EXPECT_EQ(2, m.count(a));
+  EXPECT_TRUE(m.contains(a));
+  EXPECT_THAT(Values(m, a), ElementsAre(1, 2));
+  EXPECT_EQ(2, m.erase(a));
+  EXPECT_EQ(1, m.size());
+}
+
+TEST(FlatHashMultimap, CopyAndMove) {
+  flat_hash_multimap<int, std::string> a = {{1, "x"}, {1, "y"}, {2, "z"}};
+  a.erase(2);
+  flat_hash_multimap<int, std::string> b = a;
+  b.emplace(1, "w");
+  EXPECT_THAT(Values(a, 1), ElementsAre("x", "y"));
+  EXPECT_THAT(Values(b, 1), ElementsAre("x", "y", "w"));
+
+  flat_hash_multimap<int, std::string> c = std::move(b);
+  EXPECT_THAT(Values(c, 1), ElementsAre("x", "y", "w"));
+  // The moved-from map is empty and usable.
+  EXPECT_TRUE(b.empty());  // NOLINT(bugprone-use-after-move)
+  b.emplace(5, "v");
+  EXPECT_THAT(Items(b), ElementsAre(Pair(5, "v")));
+
+  swap(a, c);
+  EXPECT_EQ(3, a.size());
+  EXPECT_EQ(2, c.size());
+}
+
+// A hasher whose copy may throw, which makes raw_hash_set move construction
+// potentially throwing.
+struct ThrowingCopyHash {
+  ThrowingCopyHash() = default;
+  ThrowingCopyHash(const ThrowingCopyHash&) noexcept(false) {}
+  size_t operator()(int v) const { return absl::Hash<int>()(v); }
+};
+
+TEST(FlatHashMultimap, MoveIsNoexceptOnlyWhenMembersAre) {
+  using Map = flat_hash_multimap<int, std::string>;
+  EXPECT_TRUE(std::is_nothrow_move_constructible<Map>::value);
+  EXPECT_TRUE(std::is_nothrow_move_assignable<Map>::value);
+
+  using ThrowingMap = flat_hash_multimap<int, std::string, ThrowingCopyHash>;
+  EXPECT_FALSE(std::is_nothrow_move_constructible<ThrowingMap>::value);
+}
+
+TEST(FlatHashMultimap, MoveOnlyValues) {
+  flat_hash_multimap<int, std::unique_ptr<int>> m;
+  m.emplace(1, new int(1));
+  m.emplace(1, absl::make_unique<int>(2));
+  m.erase(m.find(1));
+  m.emplace(1, absl::make_unique<int>(3));
+  std::vector<int> values;
+  for (const auto& kv : m) values.push_back(*kv.second);
+  EXPECT_THAT(values, ElementsAre(2, 3));
+}
+
+TEST(FlatHashMultimap, ConstIteration) {
+  flat_hash_multimap<int, int> m = {{1, 1}, {1, 2}};
+  flat_hash_multimap<int, int>::const_iterator it = m.begin();
+  const auto& cm = m;
+  EXPECT_EQ(it, cm.find(1));
+  EXPECT_EQ(2, cm.count(1));
+  EXPECT_THAT(Items(cm), ElementsAre(Pair(1, 1), Pair(1, 2)));
+}
+
+TEST(FlatHashMultimap, ManyKeys) {
+  flat_hash_multimap<int, int> m;
+  m.reserve(30000);
+  m.rehash(1000);
+  for (int round = 0; round < 30; ++round) {
+    for (int k = 0; k < 1000; ++k) m.emplace(k, round);
+  }
+  EXPECT_EQ(30000, m.size());
+  for (int k = 0; k < 1000; k += 2) EXPECT_EQ(30, m.erase(k));
+  EXPECT_EQ(15000, m.size());
+  for (int k = 1; k < 1000; k += 2) {
+    ASSERT_EQ(30, m.count(k));
+    EXPECT_EQ(0, m.find(k)->second);
+  }
+  size_t n = 0;
+  for (auto it = m.begin(); it != m.end(); ++it) ++n;
+  EXPECT_EQ(15000, n);
+}
+
+// Counts the allocations made by all CountingAllocators.
+size_t allocation_count = 0;
+
+template <class T>
+struct CountingAllocator : std::allocator<T> {
+  template <class U>
+  struct rebind {
+    using other = CountingAllocator<U>;
+  };
+  CountingAllocator() = default;
+  template <class U>
+  CountingAllocator(const CountingAllocator<U>&) {}  // NOLINT
+  T* allocate(size_t n) {
+    ++allocation_count;
+    return std::allocator<T>::allocate(n);
+  }
+};
+
+// Many small grouped inserts, as when building an inverted index, must not
+// reallocate the value storage each time.
+TEST(FlatHashMultimap, ManySmallGroupedInserts) {
+  flat_hash_multimap<int, int, absl::Hash<int>, std::equal_to<int>,
+                     CountingAllocator<std::pair<const int, int>>>
+      m;
+  allocation_count = 0;
+  const std::vector<int> postings = {1, 2};
+  for (int k = 0; k < 100000; ++k) {
+    m.insert(k, postings.begin(), postings.end());
+  }
+  EXPECT_EQ(200000, m.size());
+  EXPECT_THAT(Values(m, 99999), ElementsAre(1, 2));
+  // Geometric growth of both the keys and the values.
+  EXPECT_LT(allocation_count, 100);
+}
+
+#ifdef ABSL_HAVE_EXCEPTIONS
+// Hashes ints, throwing while `throw_on_hash` is set.
+struct ThrowingHash {
+  static bool throw_on_hash;
+  size_t operator()(int k) const {
+    if (throw_on_hash) throw std::runtime_error("hash");
+    return absl::Hash<int>()(k);
+  }
+};
+bool ThrowingHash::throw_on_hash = false;
+
+TEST(FlatHashMultimap, ThrowingKeyInsertLeavesNoValueBehind) {
+  flat_hash_multimap<int, std::string, ThrowingHash> m;
+  m.emplace(1, "a");
+  ThrowingHash::throw_on_hash = true;
+  EXPECT_THROW(m.emplace(2, "b"), std::runtime_error);
+  ThrowingHash::throw_on_hash = false;
+  EXPECT_EQ(1, m.size());
+  EXPECT_FALSE(m.contains(2));
+  // The slot of the discarded value is reused.
+  m.emplace(2, "c");
+  m.emplace(1, "d");
+  EXPECT_EQ(3, m.size());
+  EXPECT_THAT(Values(m, 1), ElementsAre("a", "d"));
+  EXPECT_THAT(Values(m, 2), ElementsAre("c"));
+}
+#endif  // ABSL_HAVE_EXCEPTIONS
+
+}  // namespace
+}  // namespace container_internal
+}  // namespace absl
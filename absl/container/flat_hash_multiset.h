@@ -0,0 +1,309 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: flat_hash_multiset.h
+// -----------------------------------------------------------------------------
+//
+// An `absl::flat_hash_multiset<K>` is an unordered container of keys that may
+// occur more than once, intended as a replacement for
+// `std::unordered_multiset`.
+//
+// Duplicates are not stored individually: the container is a Swiss table that
+// maps every distinct key to its number of occurrences.
+
+#ifndef ABSL_CONTAINER_FLAT_HASH_MULTISET_H_
+#define ABSL_CONTAINER_FLAT_HASH_MULTISET_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/memory/memory.h"
+
+namespace absl {
+
+// -----------------------------------------------------------------------------
+// absl::flat_hash_multiset
+// -----------------------------------------------------------------------------
+//
+// An `absl::flat_hash_multiset<K>` holds keys together with their number of
+// occurrences. Its interface follows `std::unordered_multiset<K>` with the
+// following notable differences:
+//
+// * Equivalent keys are stored once. Inserting a key that is equivalent to
+//   one already present only increments its count, so iteration yields the
+//   first inserted object once per occurrence.
+// * `count()` is `O(1)`.
+// * Supports inserting many copies of a key at once, through
+//   `insert(key, n)`.
+// * Insertion invalidates all iterators, pointers and references.
+//
+// Example:
+//
+//   absl::flat_hash_multiset<std::string> words = {"a", "b", "a"};
+//   words.insert("c", 3);
+//   assert(words.count("a") == 2);
+//   assert(words.size() == 6);
+template <class K, class Hash = absl::container_internal::hash_default_hash<K>,
+          class Eq = absl::container_internal::hash_default_eq<K>,
+          class Allocator = std::allocator<K>>
+class flat_hash_multiset {
+  using AllocTraits = absl::allocator_traits<Allocator>;
+  using Keys = absl::flat_hash_map<
+      K, size_t, Hash, Eq,
+      typename AllocTraits::template rebind_alloc<std::pair<const K, size_t>>>;
+
+ public:
+  using key_type = K;
+  using value_type = K;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = Eq;
+  using allocator_type = Allocator;
+  using reference = const K&;
+  using const_reference = const K&;
+
+  // Visits every key once per occurrence.
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = K;
+    using reference = const K&;
+    using pointer = const K*;
+    using difference_type = ptrdiff_t;
+
+    const_iterator() = default;
+
+    reference operator*() const { return key_->first; }
+    pointer operator->() const { return &key_->first; }
+
+    const_iterator& operator++() {
+      if (++i_ == key_->second) {
+        ++key_;
+        i_ = 0;
+      }
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend bool operator==(const const_iterator& a, const const_iterator& b) {
+      return a.key_ == b.key_ && a.i_ == b.i_;
+    }
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) {
+      return !(a == b);
+    }
+
+   private:
+    friend class flat_hash_multiset;
+    const_iterator(typename Keys::const_iterator key, size_t i)
+        : key_(key), i_(i) {}
+
+    typename Keys::const_iterator key_;
+    size_t i_ = 0;  // Occurrence of `*key_` this iterator points to.
+  };
+  using iterator = const_iterator;
+
+  template <class Key>
+  using key_arg = typename Keys::template key_arg<Key>;
+
+  flat_hash_multiset() = default;
+
+  explicit flat_hash_multiset(size_type bucket_count,
+                              const hasher& hash = hasher(),
+                              const key_equal& eq = key_equal(),
+                              const allocator_type& alloc = allocator_type())
+      : keys_(bucket_count, hash, eq, typename Keys::allocator_type(alloc)) {}
+
+  explicit flat_hash_multiset(const allocator_type& alloc)
+      : flat_hash_multiset(0, hasher(), key_equal(), alloc) {}
+
+  template <class InputIter>
+  flat_hash_multiset(InputIter first, InputIter last,
+                     size_type bucket_count = 0, const hasher& hash = hasher(),
+                     const key_equal& eq = key_equal(),
+                     const allocator_type& alloc = allocator_type())
+      : flat_hash_multiset(bucket_count, hash, eq, alloc) {
+    insert(first, last);
+  }
+
+  flat_hash_multiset(std::initializer_list<K> init, size_type bucket_count = 0,
+                     const hasher& hash = hasher(),
+                     const key_equal& eq = key_equal(),
+                     const allocator_type& alloc = allocator_type())
+      : flat_hash_multiset(init.begin(), init.end(), bucket_count, hash, eq,
+                           alloc) {}
+
+  flat_hash_multiset(const flat_hash_multiset&) = default;
+  flat_hash_multiset& operator=(const flat_hash_multiset&) = default;
+
+  flat_hash_multiset(flat_hash_multiset&& that) noexcept(
+      std::is_nothrow_move_constructible<Keys>::value)
+      : keys_(std::move(that.keys_)), size_(that.size_) {
+    that.clear();
+  }
+
+  flat_hash_multiset& operator=(flat_hash_multiset&& that) noexcept(
+      std::is_nothrow_move_assignable<Keys>::value) {
+    keys_ = std::move(that.keys_);
+    size_ = that.size_;
+    that.clear();
+    return *this;
+  }
+
+  iterator begin() const { return iterator(keys_.begin(), 0); }
+  iterator end() const { return iterator(keys_.end(), 0); }
+  iterator cbegin() const { return begin(); }
+  iterator cend() const { return end(); }
+
+  // Total number of occurrences.
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_type max_size() const { return keys_.max_size(); }
+
+  // Number of distinct keys.
+  size_type key_count() const { return keys_.size(); }
+
+  void clear() {
+    keys_.clear();
+    size_ = 0;
+  }
+
+  // Reserves room for `n` distinct keys.
+  void reserve(size_type n) { keys_.reserve(n); }
+  void rehash(size_type n) { keys_.rehash(n); }
+
+  template <class... Args>
+  iterator emplace(Args&&... args) {
+    return insert(K(std::forward<Args>(args)...));
+  }
+
+  // Adds one occurrence of `key`. Returns an iterator to it.
+  template <class Key = key_type>
+  iterator insert(key_arg<Key>&& key) {
+    return InsertImpl(std::forward<Key>(key), 1);
+  }
+  template <class Key = key_type>
+  iterator insert(const key_arg<Key>& key) {
+    return InsertImpl(key, 1);
+  }
+
+  // Adds `n` occurrences of `key` with a single lookup. Returns an iterator to
+  // the first of them, or `end()` if `n` is zero.
+  template <class Key = key_type>
+  iterator insert(const key_arg<Key>& key, size_type n) {
+    return InsertImpl(key, n);
+  }
+
+  template <class InputIter,
+            typename std::enable_if<!std::is_integral<InputIter>::value,
+                                    int>::type = 0>
+  void insert(InputIter first, InputIter last) {
+    for (; first != last; ++first) insert(*first);
+  }
+  void insert(std::initializer_list<K> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  // Returns an iterator to the first occurrence of `key`, or `end()`.
+  template <class Key = key_type>
+  iterator find(const key_arg<Key>& key) const {
+    return iterator(keys_.find(key), 0);
+  }
+
+  // Returns the range of all occurrences of `key`.
+  template <class Key = key_type>
+  std::pair<iterator, iterator> equal_range(const key_arg<Key>& key) const {
+    auto it = keys_.find(key);
+    if (it == keys_.end()) return {end(), end()};
+    return {iterator(it, 0), iterator(std::next(it), 0)};
+  }
+
+  template <class Key = key_type>
+  size_type count(const key_arg<Key>& key) const {
+    auto it = keys_.find(key);
+    return it == keys_.end() ? 0 : it->second;
+  }
+
+  template <class Key = key_type>
+  bool contains(const key_arg<Key>& key) const {
+    return keys_.contains(key);
+  }
+
+  // Erases all occurrences of `key`. Returns the number of erased keys.
+  template <class Key = key_type>
+  size_type erase(const key_arg<Key>& key) {
+    auto it = keys_.find(key);
+    if (it == keys_.end()) return 0;
+    const size_t n = it->second;
+    keys_.erase(it);
+    size_ -= n;
+    return n;
+  }
+
+  // Erases the occurrence at `pos`. Returns an iterator to the following one.
+  iterator erase(const_iterator pos) {
+    // `Keys` does not hand out mutable iterators for const ones, so look the
+    // counter up again. The key is known to be present.
+    auto it = keys_.find(pos.key_->first);
+    --size_;
+    if (--it->second == 0) {
+      auto next = std::next(pos.key_);
+      keys_.erase(it);
+      return iterator(next, 0);
+    }
+    if (pos.i_ < it->second) return pos;
+    return iterator(std::next(pos.key_), 0);
+  }
+
+  void swap(flat_hash_multiset& that) {
+    using std::swap;
+    swap(keys_, that.keys_);
+    swap(size_, that.size_);
+  }
+
+  hasher hash_function() const { return keys_.hash_function(); }
+  key_equal key_eq() const { return keys_.key_eq(); }
+  allocator_type get_allocator() const {
+    return allocator_type(keys_.get_allocator());
+  }
+
+  friend void swap(flat_hash_multiset& a, flat_hash_multiset& b) { a.swap(b); }
+
+ private:
+  template <class KeyArg>
+  iterator InsertImpl(KeyArg&& key, size_type n) {
+    if (n == 0) return end();
+    auto it = keys_.try_emplace(std::forward<KeyArg>(key), 0).first;
+    const size_t first = it->second;
+    it->second += n;
+    size_ += n;
+    return iterator(it, first);
+  }
+
+  Keys keys_;
+  size_t size_ = 0;
+};
+
+}  // namespace absl
+
+#endif  // ABSL_CONTAINER_FLAT_HASH_MULTISET_H_
@@ -0,0 +1,149 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/flat_hash_multiset.h"
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
+
+namespace absl {
+namespace container_internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::UnorderedElementsAre;
+
+template <class Set>
+std::vector<typename Set::key_type> Items(const Set& s) {
+  return std::vector<typename Set::key_type>(s.begin(), s.end());
+}
+
+TEST(FlatHashMultiset, Empty) {
+  flat_hash_multiset<int> s;
+  EXPECT_TRUE(s.empty());
+  EXPECT_EQ(s.begin(), s.end());
+  EXPECT_EQ(0, s.count(1));
+  EXPECT_EQ(s.end(), s.find(1));
+  auto range = s.equal_range(1);
+  EXPECT_EQ(range.first, range.second);
+}
+
+TEST(FlatHashMultiset, Insert) {
+  flat_hash_multiset<int> s = {1, 2, 1, 3, 1};
+  EXPECT_EQ(5, s.size());
+  EXPECT_EQ(3, s.key_count());
+  EXPECT_EQ(3, s.count(1));
+  EXPECT_EQ(1, s.count(2));
+  EXPECT_THAT(Items(s), UnorderedElementsAre(1, 1, 1, 2, 3));
+
+  auto it = s.insert(2);
+  EXPECT_EQ(2, *it);
+  EXPECT_EQ(2, s.count(2));
+  s.emplace(4);
+  EXPECT_EQ(1, s.count(4));
+}
+
+TEST(FlatHashMultiset, GroupedInsert) {
+  flat_hash_multiset<int> s;
+  EXPECT_EQ(s.end(), s.insert(7, 0));
+  EXPECT_FALSE(s.contains(7));
+  s.insert(7, 1000);
+  s.insert(7, 5);
+  EXPECT_EQ(1005, s.size());
+  EXPECT_EQ(1005, s.count(7));
+  size_t n = 0;
+  auto range = s.equal_range(7);
+  for (auto it = range.first; it != range.second; ++it) {
+    EXPECT_EQ(7, *it);
+    ++n;
+  }
+  EXPECT_EQ(1005, n);
+}
+
+TEST(FlatHashMultiset, Erase) {
+  flat_hash_multiset<std::string> s = {"a", "b", "a", "c", "a"};
+  EXPECT_EQ(3, s.erase("a"));
+  EXPECT_EQ(0, s.erase("a"));
+  EXPECT_EQ(2, s.size());
+
+  s.insert("b", 3);
+  // Remove one occurrence at a time.
+  auto it = s.find("b");
+  it = s.erase(it);
+  EXPECT_EQ(3, s.count("b"));
+  EXPECT_EQ("b", *it);
+
+  for (auto i = s.begin(); i != s.end();) {
+    if (*i == "b") {
+      i = s.erase(i);
+    } else {
+      ++i;
+    }
+  }
+  EXPECT_THAT(Items(s), ElementsAre("c"));
+  EXPECT_EQ(1, s.size());
+}
+
+TEST(FlatHashMultiset, HeterogeneousLookup) {
+  flat_hash_multiset<std::string> s = {"x", "x", "y"};
+  absl::string_view x = "x";
+  EXPECT_EQ(2, s.count(x));
+  EXPECT_TRUE(s.contains(x));
+  EXPECT_EQ("x", *s.find(x));
+  s.insert(x, 2);
+  EXPECT_EQ(4, s.count("x"));
+}
+
+TEST(FlatHashMultiset, CopyAndMove) {
+  flat_hash_multiset<int> a = {1, 1, 2};
+  flat_hash_multiset<int> b = a;
+  b.insert(1);
+  EXPECT_EQ(2, a.count(1));
+  EXPECT_EQ(3, b.count(1));
+  flat_hash_multiset<int> c = std::move(b);
+  EXPECT_EQ(4, c.size());
+  EXPECT_TRUE(b.empty());  // NOLINT(bugprone-use-after-move)
+  swap(a, c);
+  EXPECT_EQ(4, a.size());
+  EXPECT_EQ(3, c.size());
+}
+
+// A hasher whose copy may throw, which makes raw_hash_set move construction
+// potentially throwing.
+struct ThrowingCopyHash {
+  ThrowingCopyHash() = default;
+  ThrowingCopyHash(const ThrowingCopyHash&) noexcept(false) {}
+  size_t operator()(int v) const { return absl::Hash<int>()(v); }
+};
+
+TEST(FlatHashMultiset, MoveIsNoexceptOnlyWhenMembersAre) {
+  using Set = flat_hash_multiset<int>;
+  EXPECT_TRUE(std::is_nothrow_move_constructible<Set>::value);
+  EXPECT_TRUE(std::is_nothrow_move_assignable<Set>::value);
+
+  using ThrowingSet = flat_hash_multiset<int, ThrowingCopyHash>;
+  EXPECT_FALSE(std::is_nothrow_move_constructible<ThrowingSet>::value);
+}
+
+}  // namespace
+}  // namespace container_internal
+}  // namespace absl
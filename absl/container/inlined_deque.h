@@ -0,0 +1,611 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: inlined_deque.h
+// -----------------------------------------------------------------------------
+//
+// An `absl::InlinedDeque<T, N>` is a double-ended queue stored in a circular
+// buffer. Like `absl::InlinedVector<T, N>`, it holds up to `N` elements inline
+// without any heap allocation; beyond that it moves its elements to a heap
+// buffer whose capacity is a power of two, doubling it as needed.
+//
+// Pushing and popping at either end take constant time (amortized when the
+// buffer grows), which makes `InlinedDeque` a good fit for small FIFO queues on
+// hot paths: unlike `std::deque`, it does not allocate for its first `N`
+// elements, and unlike `absl::InlinedVector`, `pop_front()` does not shift the
+// remaining elements.
+//
+// Elements are not contiguous: the live range may wrap around the end of the
+// buffer. Any insertion or removal invalidates iterators and references.
+//
+// Example:
+//
+//   absl::InlinedDeque<Request, 4> pending;
+//   pending.push_back(request);
+//   ...
+//   while (!pending.empty()) {
+//     Process(pending.front());
+//     pending.pop_front();
+//   }
+
+#ifndef ABSL_CONTAINER_INLINED_DEQUE_H_
+#define ABSL_CONTAINER_INLINED_DEQUE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "absl/base/internal/throw_delegate.h"
+#include "absl/base/macros.h"
+#include "absl/base/optimization.h"
+#include "absl/memory/memory.h"
+#include "absl/meta/type_traits.h"
+
+namespace absl {
+
+template <typename T, size_t N, typename A = std::allocator<T>>
+class InlinedDeque {
+  static_assert(N > 0, "InlinedDeque requires inline capacity greater than 0");
+
+  using AllocatorTraits = std::allocator_traits<A>;
+
+  template <bool kConst>
+  class Iter {
+    using Deque = typename std::conditional<kConst, const InlinedDeque,
+                                            InlinedDeque>::type;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using reference = typename std::conditional<kConst, const T&, T&>::type;
+    using pointer = typename std::conditional<kConst, const T*, T*>::type;
+    using difference_type = ptrdiff_t;
+
+    Iter() = default;
+    template <bool C = kConst, typename std::enable_if<C, int>::type = 0>
+    Iter(const Iter<false>& it) : deque_(it.deque_), i_(it.i_) {}  // NOLINT
+
+    reference operator*() const { return (*deque_)[i_]; }
+    pointer operator->() const { return &(*deque_)[i_]; }
+    reference operator[](difference_type n) const { return (*deque_)[i_ + n]; }
+
+    Iter& operator++() {
+      ++i_;
+      return *this;
+    }
+    Iter operator++(int) { return Iter(deque_, i_++); }
+    Iter& operator--() {
+      --i_;
+      return *this;
+    }
+    Iter operator--(int) { return Iter(deque_, i_--); }
+    Iter& operator+=(difference_type n) {
+      i_ += n;
+      return *this;
+    }
+    Iter& operator-=(difference_type n) {
+      i_ -= n;
+      return *this;
+    }
+    friend Iter operator+(Iter it, difference_type n) { return it += n; }
+    friend Iter operator+(difference_type n, Iter it) { return it += n; }
+    friend Iter operator-(Iter it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const Iter& a, const Iter& b) {
+      return static_cast<difference_type>(a.i_ - b.i_);
+    }
+
+    friend bool operator==(const Iter& a, const Iter& b) {
+      return a.i_ == b.i_;
+    }
+    friend bool operator!=(const Iter& a, const Iter& b) {
+      return a.i_ != b.i_;
+    }
+    friend bool operator<(const Iter& a, const Iter& b) { return a.i_ < b.i_; }
+    friend bool operator>(const Iter& a, const Iter& b) { return a.i_ > b.i_; }
+    friend bool operator<=(const Iter& a, const Iter& b) {
+      return a.i_ <= b.i_;
+    }
+    friend bool operator>=(const Iter& a, const Iter& b) {
+      return a.i_ >= b.i_;
+    }
+
+   private:
+    friend class InlinedDeque;
+    friend class Iter<true>;
+    Iter(Deque* deque, size_t i) : deque_(deque), i_(i) {}
+
+    Deque* deque_ = nullptr;
+    size_t i_ = 0;  // Logical index: 0 is the front.
+  };
+
+ public:
+  using allocator_type = A;
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+  using iterator = Iter<false>;
+  using const_iterator = Iter<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  // ---------------------------------------------------------------------------
+  // InlinedDeque Constructors and Destructor
+  // ---------------------------------------------------------------------------
+
+  InlinedDeque() noexcept(noexcept(allocator_type()))
+      : InlinedDeque(allocator_type()) {}
+
+  explicit InlinedDeque(const allocator_type& alloc) noexcept
+      : allocator_and_data_(alloc) {
+    allocator_and_data_.data = inlined_space();
+  }
+
+  // Creates a deque of `n` value-initialized elements.
+  explicit InlinedDeque(size_type n,
+                        const allocator_type& alloc = allocator_type())
+      : InlinedDeque(alloc) {
+    reserve(n);
+    for (size_type i = 0; i < n; ++i) emplace_back();
+  }
+
+  InlinedDeque(size_type n, const_reference v,
+               const allocator_type& alloc = allocator_type())
+      : InlinedDeque(alloc) {
+    reserve(n);
+    for (size_type i = 0; i < n; ++i) emplace_back(v);
+  }
+
+  InlinedDeque(std::initializer_list<value_type> list,
+               const allocator_type& alloc = allocator_type())
+      : InlinedDeque(list.begin(), list.end(), alloc) {}
+
+  template <typename InputIterator,
+            typename = absl::enable_if_t<
+                !std::is_integral<InputIterator>::value>>
+  InlinedDeque(InputIterator first, InputIterator last,
+               const allocator_type& alloc = allocator_type())
+      : InlinedDeque(alloc) {
+    for (; first != last; ++first) emplace_back(*first);
+  }
+
+  InlinedDeque(const InlinedDeque& other)
+      : InlinedDeque(AllocatorTraits::select_on_container_copy_construction(
+            other.allocator())) {
+    AppendCopies(other);
+  }
+
+  // Steals the heap buffer of `other` if it has one; otherwise moves its
+  // inlined elements. `other` is left empty.
+  InlinedDeque(InlinedDeque&& other) noexcept(
+      std::is_nothrow_move_constructible<value_type>::value)
+      : InlinedDeque(other.allocator()) {
+    TakeFrom(&other);
+  }
+
+  ~InlinedDeque() {
+    clear();
+    FreeHeapBuffer();
+  }
+
+  InlinedDeque& operator=(const InlinedDeque& other) {
+    if (ABSL_PREDICT_TRUE(this != &other)) {
+      clear();
+      AppendCopies(other);
+    }
+    return *this;
+  }
+
+  InlinedDeque& operator=(InlinedDeque&& other) {
+    if (ABSL_PREDICT_FALSE(this == &other)) return *this;
+    clear();
+    if (!other.inlined() && allocator() != other.allocator()) {
+      // The buffer cannot change hands; move the elements instead.
+      reserve(other.size());
+      for (reference v : other) emplace_back(std::move(v));
+      other.clear();
+      return *this;
+    }
+    FreeHeapBuffer();
+    ResetToInlined();
+    TakeFrom(&other);
+    return *this;
+  }
+
+  InlinedDeque& operator=(std::initializer_list<value_type> list) {
+    clear();
+    reserve(list.size());
+    for (const_reference v : list) emplace_back(v);
+    return *this;
+  }
+
+  // ---------------------------------------------------------------------------
+  // InlinedDeque Member Accessors
+  // ---------------------------------------------------------------------------
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return AllocatorTraits::max_size(allocator());
+  }
+
+  // Returns the number of elements the deque can hold without allocating:
+  // `N` while the elements are inlined, a power of two afterwards.
+  size_type capacity() const noexcept { return capacity_; }
+
+  reference operator[](size_type i) {
+    assert(i < size());
+    return data()[Physical(i)];
+  }
+  const_reference operator[](size_type i) const {
+    assert(i < size());
+    return data()[Physical(i)];
+  }
+
+  reference at(size_type i) {
+    if (ABSL_PREDICT_FALSE(i >= size())) {
+      base_internal::ThrowStdOutOfRange(
+          "InlinedDeque::at() failed bounds check");
+    }
+    return (*this)[i];
+  }
+  const_reference at(size_type i) const {
+    if (ABSL_PREDICT_FALSE(i >= size())) {
+      base_internal::ThrowStdOutOfRange(
+          "InlinedDeque::at() failed bounds check");
+    }
+    return (*this)[i];
+  }
+
+  reference front() {
+    assert(!empty());
+    return data()[head_];
+  }
+  const_reference front() const {
+    assert(!empty());
+    return data()[head_];
+  }
+  reference back() {
+    assert(!empty());
+    return data()[Physical(size_ - 1)];
+  }
+  const_reference back() const {
+    assert(!empty());
+    return data()[Physical(size_ - 1)];
+  }
+
+  allocator_type get_allocator() const { return allocator(); }
+
+  // ---------------------------------------------------------------------------
+  // InlinedDeque Iterators
+  // ---------------------------------------------------------------------------
+
+  iterator begin() noexcept { return iterator(this, 0); }
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  iterator end() noexcept { return iterator(this, size_); }
+  const_iterator end() const noexcept { return const_iterator(this, size_); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  // ---------------------------------------------------------------------------
+  // InlinedDeque Member Mutators
+  // ---------------------------------------------------------------------------
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    if (ABSL_PREDICT_FALSE(size_ == capacity_)) {
+      return GrowAndEmplace(/*front=*/false, std::forward<Args>(args)...);
+    }
+    pointer slot = data() + Physical(size_);
+    AllocatorTraits::construct(allocator(), slot, std::forward<Args>(args)...);
+    ++size_;
+    return *slot;
+  }
+
+  template <typename... Args>
+  reference emplace_front(Args&&... args) {
+    if (ABSL_PREDICT_FALSE(size_ == capacity_)) {
+      return GrowAndEmplace(/*front=*/true, std::forward<Args>(args)...);
+    }
+    const size_type new_head = (head_ == 0 ? capacity_ : head_) - 1;
+    pointer slot = data() + new_head;
+    AllocatorTraits::construct(allocator(), slot, std::forward<Args>(args)...);
+    head_ = new_head;
+    ++size_;
+    return *slot;
+  }
+
+  void push_back(const_reference v) { emplace_back(v); }
+  void push_back(value_type&& v) { emplace_back(std::move(v)); }
+  void push_front(const_reference v) { emplace_front(v); }
+  void push_front(value_type&& v) { emplace_front(std::move(v)); }
+
+  void pop_back() {
+    assert(!empty());
+    --size_;
+    AllocatorTraits::destroy(allocator(), data() + Physical(size_));
+  }
+
+  void pop_front() {
+    assert(!empty());
+    AllocatorTraits::destroy(allocator(), data() + head_);
+    head_ = head_ + 1 == capacity_ ? 0 : head_ + 1;
+    --size_;
+  }
+
+  // Destroys all elements. Unlike `absl::InlinedVector::clear()`, the heap
+  // buffer, if any, is kept so that a drained queue can refill without
+  // allocating; call `shrink_to_fit()` to release it.
+  void clear() noexcept {
+    const size_type first_len = (std::min)(size_, capacity_ - head_);
+    Destroy(data() + head_, first_len);
+    Destroy(data(), size_ - first_len);
+    head_ = 0;
+    size_ = 0;
+  }
+
+  // Ensures that `n` elements fit without further allocation.
+  void reserve(size_type n) {
+    if (n <= capacity_) return;
+    Reallocate(NextCapacity(n));
+  }
+
+  // Moves the elements back to the inlined storage if they fit, or to the
+  // smallest power-of-two heap buffer that holds them.
+  void shrink_to_fit() {
+    if (inlined()) return;
+    if (size_ <= N) {
+      pointer old_data = data();
+      const size_type old_capacity = capacity_;
+      RelocateOut(inlined_space());
+      AllocatorTraits::deallocate(allocator(), old_data, old_capacity);
+      allocator_and_data_.data = inlined_space();
+      capacity_ = N;
+      head_ = 0;
+      return;
+    }
+    const size_type new_capacity = NextCapacity(size_);
+    if (new_capacity < capacity_) Reallocate(new_capacity);
+  }
+
+  void swap(InlinedDeque& other) {
+    if (ABSL_PREDICT_FALSE(this == &other)) return;
+    InlinedDeque tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+ private:
+  using ValueTypeBuffer =
+      absl::aligned_storage_t<sizeof(value_type), alignof(value_type)>;
+
+  // Derives from `allocator_type` to use the empty base class optimization.
+  class AllocatorAndData : private allocator_type {
+   public:
+    explicit AllocatorAndData(const allocator_type& a) : allocator_type(a) {}
+
+    allocator_type& allocator() { return *this; }
+    const allocator_type& allocator() const { return *this; }
+
+    pointer data = nullptr;
+  };
+
+  // Elements are relocated with `memcpy()` under the same conditions as in
+  // `absl::InlinedVector`.
+  using RelocateBytewise = std::integral_constant<
+      bool,
+      absl::is_trivially_relocatable<value_type>::value &&
+          std::is_same<allocator_type, std::allocator<value_type>>::value>;
+
+  allocator_type& allocator() { return allocator_and_data_.allocator(); }
+  const allocator_type& allocator() const {
+    return allocator_and_data_.allocator();
+  }
+
+  pointer data() { return allocator_and_data_.data; }
+  const_pointer data() const { return allocator_and_data_.data; }
+
+  pointer inlined_space() { return reinterpret_cast<pointer>(inlined_); }
+
+  bool inlined() const {
+    return allocator_and_data_.data ==
+           reinterpret_cast<const_pointer>(inlined_);
+  }
+
+  // Maps a logical index to a buffer index.
+  size_type Physical(size_type i) const {
+    const size_type p = head_ + i;
+    return p < capacity_ ? p : p - capacity_;
+  }
+
+  // Returns the smallest power of two that is at least `n` and greater than
+  // the inlined capacity.
+  static size_type NextCapacity(size_type n) {
+    size_type capacity = 1;
+    while (capacity <= N || capacity < n) capacity <<= 1;
+    return capacity;
+  }
+
+  void Destroy(pointer first, size_type n) {
+    for (size_type i = 0; i < n; ++i) {
+      AllocatorTraits::destroy(allocator(), first + i);
+    }
+  }
+
+  void Relocate(pointer src, size_type n, pointer dst, std::true_type) {
+    if (n != 0) {
+      std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src),
+                  n * sizeof(value_type));
+    }
+  }
+
+  void Relocate(pointer src, size_type n, pointer dst, std::false_type) {
+    for (size_type i = 0; i < n; ++i) {
+      AllocatorTraits::construct(allocator(), dst + i, std::move(src[i]));
+    }
+    Destroy(src, n);
+  }
+
+  // Relocates the elements, in order, to `dst[0, size())`. The buffer is left
+  // uninitialized; `head_` and `size_` are unchanged.
+  void RelocateOut(pointer dst) {
+    const size_type first_len = (std::min)(size_, capacity_ - head_);
+    Relocate(data() + head_, first_len, dst, RelocateBytewise());
+    Relocate(data(), size_ - first_len, dst + first_len, RelocateBytewise());
+  }
+
+  void FreeHeapBuffer() {
+    if (!inlined()) {
+      AllocatorTraits::deallocate(allocator(), data(), capacity_);
+    }
+  }
+
+  void ResetToInlined() {
+    allocator_and_data_.data = inlined_space();
+    capacity_ = N;
+    head_ = 0;
+    size_ = 0;
+  }
+
+  // Switches to a heap buffer of `new_capacity` elements.
+  void Reallocate(size_type new_capacity) {
+    pointer new_data = AllocatorTraits::allocate(allocator(), new_capacity);
+    RelocateOut(new_data);
+    FreeHeapBuffer();
+    allocator_and_data_.data = new_data;
+    capacity_ = new_capacity;
+    head_ = 0;
+  }
+
+  template <typename... Args>
+  reference GrowAndEmplace(bool front, Args&&... args) {
+    const size_type new_capacity = NextCapacity(2 * capacity_);
+    pointer new_data = AllocatorTraits::allocate(allocator(), new_capacity);
+    // Construct the new element first, since `args` may refer to an element.
+    const size_type pos = front ? new_capacity - 1 : size_;
+    ABSL_INTERNAL_TRY {
+      AllocatorTraits::construct(allocator(), new_data + pos,
+                                 std::forward<Args>(args)...);
+    }
+    ABSL_INTERNAL_CATCH_ANY {
+      AllocatorTraits::deallocate(allocator(), new_data, new_capacity);
+      ABSL_INTERNAL_RETHROW;
+    }
+    RelocateOut(new_data);
+    FreeHeapBuffer();
+    allocator_and_data_.data = new_data;
+    capacity_ = new_capacity;
+    head_ = front ? pos : 0;
+    ++size_;
+    return new_data[pos];
+  }
+
+  // Takes over the contents of `other`, leaving it empty. This deque must be
+  // empty and inlined, and use an allocator equal to `other`'s.
+  void TakeFrom(InlinedDeque* other) {
+    if (!other->inlined()) {
+      allocator_and_data_.data = other->data();
+      capacity_ = other->capacity_;
+      head_ = other->head_;
+      size_ = other->size_;
+      other->ResetToInlined();
+      return;
+    }
+    other->RelocateOut(inlined_space());
+    size_ = other->size_;
+    other->head_ = 0;
+    other->size_ = 0;
+  }
+
+  void AppendCopies(const InlinedDeque& other) {
+    reserve(other.size());
+    for (const_reference v : other) emplace_back(v);
+  }
+
+  AllocatorAndData allocator_and_data_;
+  size_type capacity_ = N;
+  size_type head_ = 0;  // Buffer index of the front element.
+  size_type size_ = 0;
+  ValueTypeBuffer inlined_[N];
+};
+
+// -----------------------------------------------------------------------------
+// InlinedDeque Non-Member Functions
+// -----------------------------------------------------------------------------
+
+template <typename T, size_t N, typename A>
+void swap(InlinedDeque<T, N, A>& a, InlinedDeque<T, N, A>& b) {
+  a.swap(b);
+}
+
+template <typename T, size_t N, typename A>
+bool operator==(const InlinedDeque<T, N, A>& a,
+                const InlinedDeque<T, N, A>& b) {
+  return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template <typename T, size_t N, typename A>
+bool operator!=(const InlinedDeque<T, N, A>& a,
+                const InlinedDeque<T, N, A>& b) {
+  return !(a == b);
+}
+
+template <typename T, size_t N, typename A>
+bool operator<(const InlinedDeque<T, N, A>& a,
+               const InlinedDeque<T, N, A>& b) {
+  return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+
+template <typename T, size_t N, typename A>
+bool operator>(const InlinedDeque<T, N, A>& a,
+               const InlinedDeque<T, N, A>& b) {
+  return b < a;
+}
+
+template <typename T, size_t N, typename A>
+bool operator<=(const InlinedDeque<T, N, A>& a,
+                const InlinedDeque<T, N, A>& b) {
+  return !(b < a);
+}
+
+template <typename T, size_t N, typename A>
+bool operator>=(const InlinedDeque<T, N, A>& a,
+                const InlinedDeque<T, N, A>& b) {
+  return !(a < b);
+}
+
+}  // namespace absl
+
+#endif  // ABSL_CONTAINER_INLINED_DEQUE_H_
@@ -0,0 +1,100 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/inlined_deque.h"
+
+#include <deque>
+
+#include "benchmark/benchmark.h"
+#include "absl/container/inlined_vector.h"
+
+namespace {
+
+// Adapters giving every queue the same interface.
+template <typename T>
+void PopFront(std::deque<T>* q) {
+  q->pop_front();
+}
+
+template <typename T, size_t N>
+void PopFront(absl::InlinedDeque<T, N>* q) {
+  q->pop_front();
+}
+
+template <typename T, size_t N>
+void PopFront(absl::InlinedVector<T, N>* q) {
+  q->erase(q->begin());
+}
+
+// A short-lived queue: created, filled with `depth` elements, drained and
+// destroyed, as for a per-request work list.
+template <typename Queue>
+void BM_CreateFillDrain(benchmark::State& state) {
+  const int depth = state.range(0);
+  for (auto _ : state) {
+    Queue q;
+    for (int i = 0; i < depth; ++i) q.push_back(i);
+    while (!q.empty()) {
+      benchmark::DoNotOptimize(q.front());
+      PopFront(&q);
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * depth);
+}
+BENCHMARK_TEMPLATE(BM_CreateFillDrain, std::deque<int>)->Range(1, 64);
+BENCHMARK_TEMPLATE(BM_CreateFillDrain, absl::InlinedDeque<int, 8>)
+    ->Range(1, 64);
+BENCHMARK_TEMPLATE(BM_CreateFillDrain, absl::InlinedVector<int, 8>)
+    ->Range(1, 64);
+
+// A long-lived FIFO holding `depth` elements: every iteration pushes one
+// element at the back and pops one from the front.
+template <typename Queue>
+void BM_SteadyStateFifo(benchmark::State& state) {
+  const int depth = state.range(0);
+  Queue q;
+  for (int i = 0; i < depth; ++i) q.push_back(i);
+  int next = depth;
+  for (auto _ : state) {
+    q.push_back(next++);
+    benchmark::DoNotOptimize(q.front());
+    PopFront(&q);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_SteadyStateFifo, std::deque<int>)->Range(2, 1024);
+BENCHMARK_TEMPLATE(BM_SteadyStateFifo, absl::InlinedDeque<int, 8>)
+    ->Range(2, 1024);
+BENCHMARK_TEMPLATE(BM_SteadyStateFifo, absl::InlinedVector<int, 8>)
+    ->Range(2, 1024);
+
+// Alternating pushes and pops at both ends, as for a work-stealing deque.
+template <typename Queue>
+void BM_BothEnds(benchmark::State& state) {
+  Queue q;
+  for (int i = 0; i < 4; ++i) q.push_back(i);
+  for (auto _ : state) {
+    q.push_front(1);
+    q.push_back(2);
+    benchmark::DoNotOptimize(q.back());
+    q.pop_back();
+    benchmark::DoNotOptimize(q.front());
+    q.pop_front();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 4);
+}
+BENCHMARK_TEMPLATE(BM_BothEnds, std::deque<int>);
+BENCHMARK_TEMPLATE(BM_BothEnds, absl::InlinedDeque<int, 8>);
+
+}  // namespace
@@ -0,0 +1,278 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/inlined_deque.h"
+
+#include <deque>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/base/internal/exception_testing.h"
+#include "absl/container/internal/counting_allocator.h"
+#include "absl/container/internal/test_instance_tracker.h"
+#include "absl/memory/memory.h"
+
+namespace {
+
+using absl::container_internal::CountingAllocator;
+using absl::test_internal::CopyableMovableInstance;
+using absl::test_internal::InstanceTracker;
+using testing::ElementsAre;
+using testing::ElementsAreArray;
+
+using IntDeque = absl::InlinedDeque<int, 4>;
+
+std::vector<int> ToVector(const IntDeque& d) {
+  return std::vector<int>(d.begin(), d.end());
+}
+
+TEST(InlinedDequeTest, Empty) {
+  IntDeque d;
+  EXPECT_TRUE(d.empty());
+  EXPECT_EQ(0, d.size());
+  EXPECT_EQ(4, d.capacity());
+  EXPECT_EQ(d.begin(), d.end());
+}
+
+TEST(InlinedDequeTest, PushAndPopBothEnds) {
+  IntDeque d;
+  d.push_back(2);
+  d.push_front(1);
+  d.push_back(3);
+  d.emplace_front(0);
+  EXPECT_THAT(ToVector(d), ElementsAre(0, 1, 2, 3));
+  EXPECT_EQ(4, d.capacity());
+  EXPECT_EQ(0, d.front());
+  EXPECT_EQ(3, d.back());
+  d.pop_front();
+  d.pop_back();
+  EXPECT_THAT(ToVector(d), ElementsAre(1, 2));
+  EXPECT_EQ(1, d[0]);
+  EXPECT_EQ(2, d.at(1));
+  ABSL_BASE_INTERNAL_EXPECT_FAIL(d.at(2), std::out_of_range,
+                                 "failed bounds check");
+}
+
+TEST(InlinedDequeTest, WrapsAroundWithoutAllocating) {
+  int64_t allocated = 0;
+  absl::InlinedDeque<int, 4, CountingAllocator<int>> d(
+      (CountingAllocator<int>(&allocated)));
+  for (int i = 0; i < 1000; ++i) {
+    d.push_back(i);
+    d.push_back(i + 1);
+    d.push_back(i + 2);
+    ASSERT_EQ(i, d.front());
+    ASSERT_EQ(i + 2, d.back());
+    d.pop_front();
+    d.pop_front();
+    d.pop_front();
+  }
+  EXPECT_EQ(0, allocated);
+  EXPECT_EQ(4, d.capacity());
+}
+
+TEST(InlinedDequeTest, SpillsToPowerOfTwoHeapBuffer) {
+  int64_t allocated = 0;
+  absl::InlinedDeque<int, 3, CountingAllocator<int>> d(
+      (CountingAllocator<int>(&allocated)));
+  // Make the inlined contents wrap before spilling.
+  d.push_back(1);
+  d.push_back(2);
+  d.pop_front();
+  d.push_back(3);
+  d.push_back(4);
+  EXPECT_EQ(0, allocated);
+  d.push_front(0);
+  EXPECT_EQ(8, d.capacity());
+  EXPECT_EQ(8 * sizeof(int), allocated);
+  for (int i = 5; i < 20; ++i) d.push_back(i);
+  EXPECT_EQ(32, d.capacity());
+  std::vector<int> expected = {0};
+  for (int i = 2; i < 20; ++i) expected.push_back(i);
+  EXPECT_EQ(expected, std::vector<int>(d.begin(), d.end()));
+
+  d.clear();
+  EXPECT_EQ(32, d.capacity());
+  d.shrink_to_fit();
+  EXPECT_EQ(3, d.capacity());
+  EXPECT_EQ(0, allocated);
+}
+
+TEST(InlinedDequeTest, MatchesStdDeque) {
+  std::mt19937 rng(17);
+  IntDeque d;
+  std::deque<int> expected;
+  for (int i = 0; i < 20000; ++i) {
+    switch (rng() % 5) {
+      case 0:
+        d.push_back(i);
+        expected.push_back(i);
+        break;
+      case 1:
+        d.push_front(i);
+        expected.push_front(i);
+        break;
+      case 2:
+        if (!expected.empty()) {
+          d.pop_back();
+          expected.pop_back();
+        }
+        break;
+      case 3:
+        if (!expected.empty()) {
+          d.pop_front();
+          expected.pop_front();
+        }
+        break;
+      case 4:
+        if (rng() % 100 == 0) {
+          d.shrink_to_fit();
+          ASSERT_LE(d.size(), d.capacity());
+        }
+        break;
+    }
+    ASSERT_EQ(expected.size(), d.size());
+    if (!expected.empty()) {
+      ASSERT_EQ(expected.front(), d.front());
+      ASSERT_EQ(expected.back(), d.back());
+    }
+  }
+  EXPECT_THAT(ToVector(d), ElementsAreArray(expected));
+}
+
+TEST(InlinedDequeTest, Reserve) {
+  IntDeque d = {1, 2, 3};
+  d.reserve(3);
+  EXPECT_EQ(4, d.capacity());
+  d.reserve(5);
+  EXPECT_EQ(8, d.capacity());
+  d.reserve(100);
+  EXPECT_EQ(128, d.capacity());
+  EXPECT_THAT(ToVector(d), ElementsAre(1, 2, 3));
+}
+
+TEST(InlinedDequeTest, Iterators) {
+  IntDeque d;
+  for (int i = 0; i < 3; ++i) d.push_back(i);
+  for (int i = 1; i < 3; ++i) d.push_front(-i);
+  EXPECT_EQ(5, d.end() - d.begin());
+  EXPECT_EQ(-2, *d.begin());
+  EXPECT_EQ(1, d.begin()[3]);
+  std::vector<int> reversed(d.rbegin(), d.rend());
+  EXPECT_THAT(reversed, ElementsAre(2, 1, 0, -1, -2));
+  IntDeque::const_iterator it = d.begin();
+  EXPECT_TRUE(it == d.cbegin());
+  for (int& x : d) x *= 10;
+  EXPECT_THAT(ToVector(d), ElementsAre(-20, -10, 0, 10, 20));
+}
+
+TEST(InlinedDequeTest, CopyAndMove) {
+  for (int len = 0; len < 10; ++len) {
+    IntDeque d;
+    for (int i = 0; i < len; ++i) {
+      if (i % 2) {
+        d.push_back(i);
+      } else {
+        d.push_front(i);
+      }
+    }
+    const std::vector<int> contents = ToVector(d);
+
+    IntDeque copy(d);
+    EXPECT_EQ(d, copy);
+    IntDeque assigned = {7, 8};
+    assigned = d;
+    EXPECT_EQ(d, assigned);
+
+    IntDeque moved(std::move(copy));
+    EXPECT_EQ(contents, ToVector(moved));
+    EXPECT_TRUE(copy.empty());  // NOLINT(bugprone-use-after-move)
+
+    IntDeque move_assigned = {1, 2, 3, 4, 5, 6};
+    move_assigned = std::move(moved);
+    EXPECT_EQ(contents, ToVector(move_assigned));
+
+    IntDeque other = {42};
+    swap(other, move_assigned);
+    EXPECT_EQ(contents, ToVector(other));
+    EXPECT_THAT(ToVector(move_assigned), ElementsAre(42));
+  }
+}
+
+TEST(InlinedDequeTest, Comparisons) {
+  IntDeque a = {1, 2, 3};
+  IntDeque b = {1, 2, 4};
+  EXPECT_TRUE(a != b);
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(b > a);
+  EXPECT_TRUE(a <= a);
+  EXPECT_TRUE(b >= a);
+  b.pop_back();
+  b.push_back(3);
+  EXPECT_TRUE(a == b);
+}
+
+TEST(InlinedDequeTest, DestroysElements) {
+  InstanceTracker tracker;
+  {
+    absl::InlinedDeque<CopyableMovableInstance, 2> d;
+    for (int i = 0; i < 10; ++i) {
+      d.emplace_back(i);
+      d.emplace_front(-i);
+    }
+    EXPECT_EQ(20, tracker.live_instances());
+    d.pop_front();
+    d.pop_back();
+    EXPECT_EQ(18, tracker.live_instances());
+    absl::InlinedDeque<CopyableMovableInstance, 2> copy = d;
+    EXPECT_EQ(36, tracker.live_instances());
+    copy.clear();
+    EXPECT_EQ(18, tracker.live_instances());
+    EXPECT_EQ(-8, d.front().value());
+    EXPECT_EQ(8, d.back().value());
+  }
+  EXPECT_EQ(0, tracker.instances());
+}
+
+TEST(InlinedDequeTest, MoveOnly) {
+  absl::InlinedDeque<std::unique_ptr<int>, 2> d;
+  for (int i = 0; i < 10; ++i) d.push_back(absl::make_unique<int>(i));
+  d.push_front(absl::make_unique<int>(-1));
+  auto moved = std::move(d);
+  EXPECT_EQ(11, moved.size());
+  EXPECT_EQ(-1, *moved.front());
+  EXPECT_EQ(9, *moved.back());
+  moved.pop_front();
+  EXPECT_EQ(0, *moved.front());
+}
+
+TEST(InlinedDequeTest, EmplaceFromOwnElementWhileGrowing) {
+  absl::InlinedDeque<std::string, 2> d;
+  d.push_back(std::string(50, 'a'));
+  d.push_back(std::string(50, 'b'));
+  // Both calls reallocate while reading an existing element.
+  d.push_back(d.front());
+  EXPECT_EQ(std::string(50, 'a'), d.back());
+  d.push_back(std::string(50, 'c'));
+  ASSERT_EQ(d.size(), d.capacity());
+  d.push_front(d[1]);
+  EXPECT_EQ(std::string(50, 'b'), d.front());
+}
+
+}  // namespace
@@ -48,6 +48,7 @@
 
 #include "absl/algorithm/algorithm.h"
 #include "absl/base/internal/throw_delegate.h"
+#include "absl/base/macros.h"
 #include "absl/base/optimization.h"
 #include "absl/base/port.h"
 #include "absl/memory/memory.h"
@@ -199,11 +200,7 @@ class InlinedVector {
       tag().set_allocated_size(other.size());
       other.tag() = Tag();
     } else {
-      UninitializedCopy(
-          std::make_move_iterator(other.inlined_space()),
-          std::make_move_iterator(other.inlined_space() + other.size()),
-          inlined_space());
-      tag().set_inline_size(other.size());
+      MoveInlined(&other);
     }
   }
 
@@ -238,11 +235,7 @@ class InlinedVector {
         tag().set_allocated_size(other.size());
       }
     } else {
-      UninitializedCopy(
-          std::make_move_iterator(other.inlined_space()),
-          std::make_move_iterator(other.inlined_space() + other.size()),
-          inlined_space());
-      tag().set_inline_size(other.size());
+      MoveInlined(&other);
     }
   }
 
@@ -478,6 +471,9 @@ class InlinedVector {
       tag().set_allocated_size(other.size());
       init_allocation(other.allocation());
       other.tag() = Tag();
+    } else if (RelocateBytewise::value) {
+      clear();
+      MoveInlined(&other);
     } else {
       if (allocated()) clear();
       // Both are inlined now.
@@ -731,10 +727,7 @@ class InlinedVector {
     assert(pos >= begin());
     assert(pos < end());
 
-    iterator position = const_cast<iterator>(pos);
-    std::move(position + 1, end(), position);
-    pop_back();
-    return position;
+    return erase(pos, pos + 1);
   }
 
   // Overload of `InlinedVector::erase()` for erasing all elements in the
@@ -760,8 +753,7 @@ class InlinedVector {
         space = inlined_space();
         tag().set_inline_size(s - erase_gap);
       }
-      std::move(range_end, space + s, range_start);
-      Destroy(space + s - erase_gap, space + s);
+      EraseGap(range_start, range_end, space + s, RelocateBytewise());
     }
     return range_start;
   }
@@ -789,7 +781,9 @@ class InlinedVector {
   //
   // NOTE: If `n` does not exceed `capacity()`, `reserve()` will have no
   // effects. Otherwise, `reserve()` will reallocate, performing an n-time
-  // element-wise move of everything contained.
+  // element-wise move of everything contained, or a single `memcpy()` if
+  // `absl::is_trivially_relocatable<value_type>` holds and the default
+  // allocator is used.
   void reserve(size_type n) {
     if (n > capacity()) {
       // Make room for new elements
@@ -826,9 +820,7 @@ class InlinedVector {
     // We can't simply use the same approach as above, because `assign()` would
     // call into `reserve()` internally and reserve larger capacity than we need
     Allocation new_allocation(allocator(), s);
-    UninitializedCopy(std::make_move_iterator(allocated_space()),
-                      std::make_move_iterator(allocated_space() + s),
-                      new_allocation.buffer());
+    Relocate(allocated_space(), allocated_space() + s, new_allocation.buffer());
     ResetAllocation(new_allocation, s);
   }
 
@@ -941,14 +933,13 @@ class InlinedVector {
 
   bool allocated() const { return tag().allocated(); }
 
+  // Switches to `new_allocation`, into which the elements have already been
+  // relocated (see `Relocate()`), and frees the previous allocation, if any.
   void ResetAllocation(Allocation new_allocation, size_type new_size) {
     if (allocated()) {
-      Destroy(allocated_space(), allocated_space() + size());
-      assert(begin() == allocated_space());
       allocation().Dealloc(allocator());
       allocation() = new_allocation;
     } else {
-      Destroy(inlined_space(), inlined_space() + size());
       init_allocation(new_allocation);  // bug: only init once
     }
     tag().set_allocated_size(new_size);
@@ -987,6 +978,63 @@ class InlinedVector {
 #endif  // !defined(NDEBUG)
   }
 
+  // Elements are relocated with `memcpy()` when their type is trivially
+  // relocatable and the allocator is `std::allocator`, whose `construct()` and
+  // `destroy()` do nothing beyond running the constructor and destructor.
+  using RelocateBytewise = std::integral_constant<
+      bool,
+      absl::is_trivially_relocatable<value_type>::value &&
+          std::is_same<allocator_type, std::allocator<value_type>>::value>;
+
+  // Moves the elements in [`src`, `src_last`) to the uninitialized memory at
+  // `dst`, which does not overlap the source, and ends their lifetime at the
+  // old address.
+  void Relocate(pointer src, pointer src_last, pointer dst) {
+    Relocate(src, src_last, dst, RelocateBytewise());
+  }
+
+  void Relocate(pointer src, pointer src_last, pointer dst, std::true_type) {
+    if (src != src_last) {
+      std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src),
+                  sizeof(value_type) * (src_last - src));
+    }
+  }
+
+  void Relocate(pointer src, pointer src_last, pointer dst, std::false_type) {
+    UninitializedCopy(std::make_move_iterator(src),
+                      std::make_move_iterator(src_last), dst);
+    Destroy(src, src_last);
+  }
+
+  // Move-constructs the elements of the inlined `other` into the inlined space
+  // of this empty vector. Relocated elements leave `other` empty.
+  void MoveInlined(InlinedVector* other) {
+    const size_type s = other->size();
+    if (RelocateBytewise::value) {
+      Relocate(other->inlined_space(), other->inlined_space() + s,
+               inlined_space());
+      other->tag() = Tag();
+    } else {
+      UninitializedCopy(std::make_move_iterator(other->inlined_space()),
+                        std::make_move_iterator(other->inlined_space() + s),
+                        inlined_space());
+    }
+    tag().set_inline_size(s);
+  }
+
+  // Removes [`from`, `to`) by shifting [`to`, `last`) down to `from`. Leaves
+  // the last `to - from` slots before `last` uninitialized.
+  void EraseGap(pointer from, pointer to, pointer last, std::true_type) {
+    Destroy(from, to);
+    std::memmove(static_cast<void*>(from), static_cast<const void*>(to),
+                 sizeof(value_type) * (last - to));
+  }
+
+  void EraseGap(pointer from, pointer to, pointer last, std::false_type) {
+    std::move(to, last, from);
+    Destroy(last - (to - from), last);
+  }
+
   // Enlarge the underlying representation so we can store `size_ + delta` elems
   // in allocated space. The size is not changed, and any newly added memory is
   // not initialized.
@@ -1005,9 +1053,7 @@ class InlinedVector {
 
     Allocation new_allocation(allocator(), new_capacity);
 
-    UninitializedCopy(std::make_move_iterator(data()),
-                      std::make_move_iterator(data() + s),
-                      new_allocation.buffer());
+    Relocate(data(), data() + s, new_allocation.buffer());
 
     ResetAllocation(new_allocation, s);
   }
@@ -1037,12 +1083,30 @@ class InlinedVector {
       // requested shift.
       Allocation new_allocation(allocator(), new_capacity);
       size_type index = position - begin();
-      UninitializedCopy(std::make_move_iterator(data()),
-                        std::make_move_iterator(data() + index),
-                        new_allocation.buffer());
-      UninitializedCopy(std::make_move_iterator(data() + index),
-                        std::make_move_iterator(data() + s),
-                        new_allocation.buffer() + index + n);
+      pointer new_data = new_allocation.buffer();
+      if (RelocateBytewise::value) {
+        Relocate(data(), data() + index, new_data);
+        Relocate(data() + index, data() + s, new_data + index + n);
+      } else {
+        // Move both ranges before destroying anything, so that a throwing
+        // move leaves every old element to be destroyed exactly once.
+        size_type moved = 0;
+        ABSL_INTERNAL_TRY {
+          for (; moved < index; ++moved) {
+            Construct(new_data + moved, std::move(data()[moved]));
+          }
+          for (; moved < s; ++moved) {
+            Construct(new_data + moved + n, std::move(data()[moved]));
+          }
+        }
+        ABSL_INTERNAL_CATCH_ANY {
+          Destroy(new_data, new_data + (std::min)(moved, index));
+          if (moved > index) Destroy(new_data + index + n, new_data + moved + n);
+          new_allocation.Dealloc(allocator());
+          ABSL_INTERNAL_RETHROW;
+        }
+        Destroy(data(), data() + s);
+      }
       ResetAllocation(new_allocation, s);
 
       // New allocation means our iterator is invalid, so we'll recalculate.
@@ -1087,9 +1151,7 @@ class InlinedVector {
 
     reference new_element =
         Construct(new_allocation.buffer() + s, std::forward<Args>(args)...);
-    UninitializedCopy(std::make_move_iterator(data()),
-                      std::make_move_iterator(data() + s),
-                      new_allocation.buffer());
+    Relocate(data(), data() + s, new_allocation.buffer());
 
     ResetAllocation(new_allocation, s + 1);
 
@@ -1211,16 +1273,7 @@ class InlinedVector {
       const size_type a_size = a->size();
       const size_type b_size = b->size();
       assert(a_size >= b_size);
-      // `a` is larger. Swap the elements up to the smaller array size.
-      std::swap_ranges(a->inlined_space(), a->inlined_space() + b_size,
-                       b->inlined_space());
-
-      // Move the remaining elements:
-      //   [`b_size`, `a_size`) from `a` -> [`b_size`, `a_size`) from `b`
-      b->UninitializedCopy(a->inlined_space() + b_size,
-                           a->inlined_space() + a_size,
-                           b->inlined_space() + b_size);
-      a->Destroy(a->inlined_space() + b_size, a->inlined_space() + a_size);
+      SwapInlinedElements(a, a_size, b, b_size, RelocateBytewise());
 
       swap(a->tag(), b->tag());
       swap(a->allocator(), b->allocator());
@@ -1253,9 +1306,7 @@ class InlinedVector {
     // `inline_space`
     Allocation b_allocation = b->allocation();
 
-    b->UninitializedCopy(a->inlined_space(), a->inlined_space() + a_size,
-                         b->inlined_space());
-    a->Destroy(a->inlined_space(), a->inlined_space() + a_size);
+    TransferInlinedElements(a, a_size, b, RelocateBytewise());
 
     a->allocation() = b_allocation;
 
@@ -1267,6 +1318,50 @@ class InlinedVector {
     assert(a->size() == b_size);
   }
 
+  // Exchanges the `a_size` and `b_size` elements of the inlined vectors `a`
+  // and `b`, where `a_size >= b_size`. Tags are left untouched.
+  static void SwapInlinedElements(InlinedVector* a, size_type a_size,
+                                  InlinedVector* b, size_type b_size,
+                                  std::true_type) {
+    typename Rep::InlinedRep tmp;
+    pointer t = reinterpret_cast<pointer>(std::addressof(tmp.inlined[0]));
+    a->Relocate(a->inlined_space(), a->inlined_space() + a_size, t);
+    a->Relocate(b->inlined_space(), b->inlined_space() + b_size,
+                a->inlined_space());
+    a->Relocate(t, t + a_size, b->inlined_space());
+  }
+
+  static void SwapInlinedElements(InlinedVector* a, size_type a_size,
+                                  InlinedVector* b, size_type b_size,
+                                  std::false_type) {
+    // `a` is larger. Swap the elements up to the smaller array size.
+    std::swap_ranges(a->inlined_space(), a->inlined_space() + b_size,
+                     b->inlined_space());
+
+    // Move the remaining elements:
+    //   [`b_size`, `a_size`) from `a` -> [`b_size`, `a_size`) from `b`
+    b->UninitializedCopy(std::make_move_iterator(a->inlined_space() + b_size),
+                         std::make_move_iterator(a->inlined_space() + a_size),
+                         b->inlined_space() + b_size);
+    a->Destroy(a->inlined_space() + b_size, a->inlined_space() + a_size);
+  }
+
+  // Transfers the `a_size` inlined elements of `a` to the inlined space of
+  // `b`, leaving `a`'s inlined space uninitialized.
+  static void TransferInlinedElements(InlinedVector* a, size_type a_size,
+                                      InlinedVector* b, std::true_type) {
+    a->Relocate(a->inlined_space(), a->inlined_space() + a_size,
+                b->inlined_space());
+  }
+
+  static void TransferInlinedElements(InlinedVector* a, size_type a_size,
+                                      InlinedVector* b, std::false_type) {
+    b->UninitializedCopy(std::make_move_iterator(a->inlined_space()),
+                         std::make_move_iterator(a->inlined_space() + a_size),
+                         b->inlined_space());
+    a->Destroy(a->inlined_space(), a->inlined_space() + a_size);
+  }
+
   // Stores either the inlined or allocated representation
   union Rep {
     using ValueTypeBuffer =
@@ -14,7 +14,9 @@
 
 #include "absl/container/inlined_vector.h"
 
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "benchmark/benchmark.h"
@@ -223,6 +225,90 @@ BENCHMARK_TEMPLATE(BM_SwapElements, LargeCopyableMovable)->Range(0, 1024);
 BENCHMARK_TEMPLATE(BM_SwapElements, LargeCopyableMovableSwappable)
     ->Range(0, 1024);
 
+// The following benchmarks measure the paths that relocate elements: growth
+// past the inlined capacity and beyond, erasure from the front, and moving and
+// swapping inlined vectors. `std::unique_ptr` is trivially relocatable and is
+// moved with `memcpy()`; `NotRelocatable` has the same layout and behavior but
+// is moved element by element.
+class NotRelocatable {
+ public:
+  explicit NotRelocatable(int* p) : p_(p) {}
+  NotRelocatable(NotRelocatable&& other) : p_(other.p_) { other.p_ = nullptr; }
+  NotRelocatable& operator=(NotRelocatable&& other) {
+    std::swap(p_, other.p_);
+    return *this;
+  }
+  ~NotRelocatable() { delete p_; }
+
+ private:
+  int* p_;
+};
+
+std::unique_ptr<int> MakeElement(std::unique_ptr<int>*) {
+  return std::unique_ptr<int>(new int(0));
+}
+NotRelocatable MakeElement(NotRelocatable*) {
+  return NotRelocatable(new int(0));
+}
+
+template <typename ElementType>
+void BM_RelocateGrow(benchmark::State& state) {
+  const int len = state.range(0);
+  absl::InlinedVector<ElementType, 4> v;
+  for (int i = 0; i < len; ++i) {
+    v.push_back(MakeElement(static_cast<ElementType*>(nullptr)));
+  }
+  for (auto _ : state) {
+    // Each iteration relocates all elements twice.
+    v.reserve(2 * len);
+    v.shrink_to_fit();
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * len * 2);
+}
+BENCHMARK_TEMPLATE(BM_RelocateGrow, std::unique_ptr<int>)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_RelocateGrow, NotRelocatable)->Range(8, 1024);
+
+template <typename ElementType>
+void BM_RelocateEraseFront(benchmark::State& state) {
+  const int len = state.range(0);
+  absl::InlinedVector<ElementType, 4> v;
+  for (int i = 0; i < len; ++i) {
+    v.push_back(MakeElement(static_cast<ElementType*>(nullptr)));
+  }
+  for (auto _ : state) {
+    // Rotates by one: erases the first element and appends it again.
+    ElementType first = std::move(v.front());
+    v.erase(v.begin());
+    v.push_back(std::move(first));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * len);
+}
+BENCHMARK_TEMPLATE(BM_RelocateEraseFront, std::unique_ptr<int>)
+    ->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_RelocateEraseFront, NotRelocatable)->Range(8, 1024);
+
+template <typename ElementType>
+void BM_RelocateInlinedMoveAndSwap(benchmark::State& state) {
+  using Vec = absl::InlinedVector<ElementType, 16>;
+  Vec a, b;
+  for (int i = 0; i < 12; ++i) {
+    a.push_back(MakeElement(static_cast<ElementType*>(nullptr)));
+  }
+  for (int i = 0; i < 4; ++i) {
+    b.push_back(MakeElement(static_cast<ElementType*>(nullptr)));
+  }
+  for (auto _ : state) {
+    Vec c(std::move(a));
+    a = std::move(c);
+    using std::swap;
+    swap(a, b);
+    benchmark::DoNotOptimize(a);
+  }
+}
+BENCHMARK_TEMPLATE(BM_RelocateInlinedMoveAndSwap, std::unique_ptr<int>);
+BENCHMARK_TEMPLATE(BM_RelocateInlinedMoveAndSwap, NotRelocatable);
+
 // The following benchmark is meant to track the efficiency of the vector size
 // as a function of stored type via the benchmark label. It is not meant to
 // output useful sizeof operator performance. The loop is a dummy operation
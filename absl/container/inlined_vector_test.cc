@@ -345,6 +345,45 @@ TEST(InlinedVectorTest, Noexcept) {
                 absl::InlinedVector<MoveCanThrow, 2>>::value));
 }
 
+#ifdef ABSL_HAVE_EXCEPTIONS
+// Counts live instances; the move constructor throws once `moves_left` runs
+// out.
+struct ThrowingMove {
+  static int live;
+  static int moves_left;
+  explicit ThrowingMove(int value) : value(value) { ++live; }
+  ThrowingMove(ThrowingMove&& other) : value(other.value) {
+    if (moves_left-- == 0) throw std::runtime_error("move");
+    ++live;
+  }
+  ThrowingMove& operator=(ThrowingMove&& other) {
+    value = other.value;
+    return *this;
+  }
+  ~ThrowingMove() { --live; }
+  int value;
+};
+int ThrowingMove::live = 0;
+int ThrowingMove::moves_left = 0;
+
+TEST(InlinedVectorTest, ThrowingMoveWhileInsertingReallocates) {
+  // Throw while moving each of the elements before and after the gap.
+  for (int throw_at = 0; throw_at < 4; ++throw_at) {
+    SCOPED_TRACE(throw_at);
+    {
+      absl::InlinedVector<ThrowingMove, 4> v;
+      for (int i = 0; i < 4; ++i) v.emplace_back(i);
+      ThrowingMove::moves_left = throw_at;
+      EXPECT_THROW(v.emplace(v.begin() + 2, 9), std::runtime_error);
+      ThrowingMove::moves_left = -1;
+      EXPECT_EQ(4, v.size());
+      EXPECT_EQ(4, ThrowingMove::live);
+    }
+    EXPECT_EQ(0, ThrowingMove::live);
+  }
+}
+#endif  // ABSL_HAVE_EXCEPTIONS
+
 TEST(InlinedVectorTest, EmplaceBack) {
   absl::InlinedVector<std::pair<std::string, int>, 1> v;
 
@@ -1782,3 +1821,112 @@ TEST(InlinedVectorTest, AbslHashValueWorks) {
 }
 
 }  // anonymous namespace
+
+namespace inlined_vector_test {
+
+// A type that opts into trivial relocation and counts how often it is moved.
+class Relocatable {
+ public:
+  Relocatable(int value, int* moves) : value_(value), moves_(moves) {}
+  Relocatable(Relocatable&& other)
+      : value_(other.value_), moves_(other.moves_) {
+    ++*moves_;
+  }
+  Relocatable& operator=(Relocatable&& other) {
+    value_ = other.value_;
+    moves_ = other.moves_;
+    ++*moves_;
+    return *this;
+  }
+  ~Relocatable() {}
+
+  int value() const { return value_; }
+
+ private:
+  int value_;
+  int* moves_;
+};
+
+}  // namespace inlined_vector_test
+
+namespace absl {
+template <>
+struct is_trivially_relocatable<inlined_vector_test::Relocatable>
+    : std::true_type {};
+}  // namespace absl
+
+namespace {
+
+using inlined_vector_test::Relocatable;
+
+std::vector<int> Values(const absl::InlinedVector<Relocatable, 4>& v) {
+  std::vector<int> values;
+  for (const Relocatable& r : v) values.push_back(r.value());
+  return values;
+}
+
+TEST(InlinedVectorTest, RelocatesWithoutMoving) {
+  int moves = 0;
+  absl::InlinedVector<Relocatable, 4> v;
+  for (int i = 0; i < 20; ++i) v.emplace_back(i, &moves);
+  v.reserve(100);
+  v.shrink_to_fit();
+  v.erase(v.begin() + 2, v.begin() + 5);
+  v.erase(v.begin());
+  EXPECT_EQ(0, moves);
+  EXPECT_THAT(Values(v), ElementsAre(1, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                     16, 17, 18, 19));
+
+  absl::InlinedVector<Relocatable, 4> small;
+  small.emplace_back(100, &moves);
+  small.emplace_back(101, &moves);
+  absl::InlinedVector<Relocatable, 4> small2;
+  small2.emplace_back(200, &moves);
+  swap(small, small2);
+  EXPECT_THAT(Values(small), ElementsAre(200));
+  EXPECT_THAT(Values(small2), ElementsAre(100, 101));
+  swap(small, v);
+  EXPECT_THAT(Values(v), ElementsAre(200));
+  EXPECT_EQ(16, small.size());
+
+  absl::InlinedVector<Relocatable, 4> moved(std::move(small2));
+  EXPECT_THAT(Values(moved), ElementsAre(100, 101));
+  v = std::move(moved);
+  EXPECT_THAT(Values(v), ElementsAre(100, 101));
+  EXPECT_EQ(0, moves);
+}
+
+TEST(InlinedVectorTest, RelocatesUniquePtr) {
+  using Vec = absl::InlinedVector<std::unique_ptr<int>, 3>;
+  auto values = [](const Vec& v) {
+    std::vector<int> out;
+    for (const auto& p : v) out.push_back(*p);
+    return out;
+  };
+  for (int a_len = 0; a_len < 7; ++a_len) {
+    for (int b_len = 0; b_len < 7; ++b_len) {
+      Vec a, b;
+      for (int i = 0; i < a_len; ++i) a.push_back(absl::make_unique<int>(i));
+      for (int i = 0; i < b_len; ++i) {
+        b.insert(b.begin(), absl::make_unique<int>(100 + b_len - 1 - i));
+      }
+      swap(a, b);
+      ASSERT_EQ(b_len, a.size());
+      ASSERT_EQ(a_len, b.size());
+      for (int i = 0; i < b_len; ++i) ASSERT_EQ(100 + i, *a[i]);
+      for (int i = 0; i < a_len; ++i) ASSERT_EQ(i, *b[i]);
+
+      if (!b.empty()) b.erase(b.begin());
+      std::vector<int> expected;
+      for (int i = 1; i < a_len; ++i) expected.push_back(i);
+      EXPECT_EQ(expected, values(b));
+
+      Vec c(std::move(b));
+      EXPECT_EQ(expected, values(c));
+      c = std::move(a);
+      EXPECT_EQ(b_len, c.size());
+    }
+  }
+}
+
+}  // namespace
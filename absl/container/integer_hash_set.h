@@ -0,0 +1,741 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: integer_hash_set.h
+// -----------------------------------------------------------------------------
+//
+// An `absl::integer_hash_set<T>` is an unordered set of 32-bit or 64-bit
+// integers. It is a specialized alternative to `absl::flat_hash_set<T>` for
+// integer keys.
+//
+// `flat_hash_set` keeps a separate array of one-byte control values next to the
+// slots and probes the control bytes before it touches a key. For integer keys
+// the key itself is as cheap to compare as a control byte, so
+// `integer_hash_set` drops the control array altogether:
+//
+// * Empty slots hold a sentinel key (zero). A zero key stored by the user is
+//   kept out of line, so every value of `T` can be inserted.
+// * Lookups compare a whole group of keys (32 bytes, i.e. 8 32-bit or 4 64-bit
+//   keys) against the probe key with SSE2 or AVX2, and touch a single array.
+// * Erasure uses backward shifting instead of tombstones, so lookup cost does
+//   not degrade after many erases.
+//
+// This saves a byte per slot and, more importantly, the extra cache miss on
+// the control array for every lookup.
+//
+// Differences from `absl::flat_hash_set`:
+//
+// * Only supports integral key types of 4 or 8 bytes and does not support
+//   heterogeneous lookup or a custom equality functor.
+// * `erase()` may move other elements, so it invalidates all iterators.
+// * Does not provide node handles, `extract()` or `merge()`.
+//
+// Example:
+//
+//   absl::integer_hash_set<uint32_t> ids = {1, 2, 3};
+//   ids.insert(0);
+//   if (ids.contains(2)) { ... }
+
+#ifndef ABSL_CONTAINER_INTEGER_HASH_SET_H_
+#define ABSL_CONTAINER_INTEGER_HASH_SET_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/container/internal/compressed_tuple.h"
+#include "absl/container/internal/hash_function_defaults.h"  // IWYU pragma: export
+#include "absl/container/internal/have_sse.h"
+#include "absl/container/internal/raw_hash_set.h"
+#include "absl/memory/memory.h"
+#include "absl/utility/utility.h"
+
+namespace absl {
+namespace container_internal {
+
+// Number of bytes of keys compared at once by an `IntegerGroup`.
+constexpr size_t kIntegerGroupBytes = 32;
+
+// A group of `kWidth` consecutive integer slots. `Match()` returns a bitmask
+// with bit `i` set if the `i`-th key equals the argument.
+template <class T>
+struct IntegerGroupPortableImpl {
+  static constexpr size_t kWidth = kIntegerGroupBytes / sizeof(T);
+
+  explicit IntegerGroupPortableImpl(const T* pos) : pos_(pos) {}
+
+  BitMask<uint32_t, kWidth> Match(T key) const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i != kWidth; ++i) {
+      mask |= static_cast<uint32_t>(pos_[i] == key) << i;
+    }
+    return BitMask<uint32_t, kWidth>(mask);
+  }
+
+  const T* pos_;
+};
+
+#if SWISSTABLE_HAVE_AVX2
+
+template <class T, size_t Size = sizeof(T)>
+struct IntegerGroupAvx2Impl;
+
+template <class T>
+struct IntegerGroupAvx2Impl<T, 4> {
+  static constexpr size_t kWidth = 8;
+
+  explicit IntegerGroupAvx2Impl(const T* pos)
+      : keys_(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos))) {}
+
+  BitMask<uint32_t, kWidth> Match(T key) const {
+    __m256i eq =
+        _mm256_cmpeq_epi32(keys_, _mm256_set1_epi32(static_cast<int>(key)));
+    return BitMask<uint32_t, kWidth>(
+        static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(eq))));
+  }
+
+  __m256i keys_;
+};
+
+template <class T>
+struct IntegerGroupAvx2Impl<T, 8> {
+  static constexpr size_t kWidth = 4;
+
+  explicit IntegerGroupAvx2Impl(const T* pos)
+      : keys_(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos))) {}
+
+  BitMask<uint32_t, kWidth> Match(T key) const {
+    __m256i eq = _mm256_cmpeq_epi64(
+        keys_, _mm256_set1_epi64x(static_cast<long long>(key)));  // NOLINT
+    return BitMask<uint32_t, kWidth>(
+        static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(eq))));
+  }
+
+  __m256i keys_;
+};
+
+template <class T>
+using IntegerGroup = IntegerGroupAvx2Impl<T>;
+
+#elif SWISSTABLE_HAVE_SSE2
+
+// Without AVX2 a group is made of two 16-byte halves.
+template <class T, size_t Size = sizeof(T)>
+struct IntegerGroupSse2Impl;
+
+template <class T>
+struct IntegerGroupSse2Impl<T, 4> {
+  static constexpr size_t kWidth = 8;
+
+  explicit IntegerGroupSse2Impl(const T* pos)
+      : lo_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))),
+        hi_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos) + 1)) {}
+
+  BitMask<uint32_t, kWidth> Match(T key) const {
+    const __m128i k = _mm_set1_epi32(static_cast<int>(key));
+    const int lo = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lo_, k)));
+    const int hi = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(hi_, k)));
+    return BitMask<uint32_t, kWidth>(static_cast<uint32_t>(lo | (hi << 4)));
+  }
+
+  __m128i lo_;
+  __m128i hi_;
+};
+
+template <class T>
+struct IntegerGroupSse2Impl<T, 8> {
+  static constexpr size_t kWidth = 4;
+
+  explicit IntegerGroupSse2Impl(const T* pos)
+      : lo_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))),
+        hi_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos) + 1)) {}
+
+  BitMask<uint32_t, kWidth> Match(T key) const {
+    const __m128i k = _mm_set1_epi64x(static_cast<long long>(key));  // NOLINT
+    return BitMask<uint32_t, kWidth>(
+        static_cast<uint32_t>(Match64(lo_, k) | (Match64(hi_, k) << 2)));
+  }
+
+ private:
+  // SSE2 has no 64-bit equality: two 64-bit lanes are equal iff both of their
+  // 32-bit halves are.
+  static int Match64(__m128i keys, __m128i k) {
+    const __m128i eq = _mm_cmpeq_epi32(keys, k);
+    const __m128i both =
+        _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_movemask_pd(_mm_castsi128_pd(both));
+  }
+
+  __m128i lo_;
+  __m128i hi_;
+};
+
+template <class T>
+using IntegerGroup = IntegerGroupSse2Impl<T>;
+
+#else
+
+template <class T>
+using IntegerGroup = IntegerGroupPortableImpl<T>;
+
+#endif
+
+}  // namespace container_internal
+
+// -----------------------------------------------------------------------------
+// absl::integer_hash_set
+// -----------------------------------------------------------------------------
+//
+// An `absl::integer_hash_set<T>` is an unordered associative container of
+// unique integers. Its interface is a subset of that of `absl::flat_hash_set`.
+//
+// By default, `integer_hash_set` uses the `absl::Hash` hashing framework.
+template <class T, class Hash = absl::container_internal::hash_default_hash<T>,
+          class Alloc = std::allocator<T>>
+class integer_hash_set {
+  static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                    (sizeof(T) == 4 || sizeof(T) == 8),
+                "integer_hash_set only supports 32-bit and 64-bit integers");
+
+  using Group = container_internal::IntegerGroup<T>;
+  using AllocTraits = absl::allocator_traits<Alloc>;
+
+  static constexpr size_t kWidth = Group::kWidth;
+
+ public:
+  using key_type = T;
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = std::equal_to<T>;
+  using allocator_type = Alloc;
+  using reference = const T&;
+  using const_reference = const T&;
+  using pointer = const T*;
+  using const_pointer = const T*;
+
+  class const_iterator {
+    friend class integer_hash_set;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using reference = const T&;
+    using pointer = const T*;
+    using difference_type = ptrdiff_t;
+
+    const_iterator() {}
+
+    reference operator*() const { return *slot_; }
+    pointer operator->() const { return slot_; }
+
+    const_iterator& operator++() {
+      ++slot_;
+      skip_empty();
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend bool operator==(const const_iterator& a, const const_iterator& b) {
+      return a.slot_ == b.slot_;
+    }
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) {
+      return !(a == b);
+    }
+
+   private:
+    // `last` points to the out of line slot that holds the sentinel key when
+    // it is a member of the set.
+    const_iterator(const T* slot, const T* last, bool has_last)
+        : slot_(slot), last_(last), has_last_(has_last) {}
+
+    void skip_empty() {
+      while (slot_ < last_ && *slot_ == T{0}) ++slot_;
+      if (slot_ == last_ && !has_last_) ++slot_;
+    }
+
+    const T* slot_ = nullptr;
+    const T* last_ = nullptr;
+    bool has_last_ = false;
+  };
+  using iterator = const_iterator;
+
+  integer_hash_set() noexcept(
+      std::is_nothrow_default_constructible<hasher>::value &&
+      std::is_nothrow_default_constructible<allocator_type>::value) {}
+
+  explicit integer_hash_set(size_t bucket_count, const hasher& hash = hasher(),
+                            const allocator_type& alloc = allocator_type())
+      : settings_(hash, alloc) {
+    if (bucket_count) reserve(bucket_count);
+  }
+
+  integer_hash_set(size_t bucket_count, const allocator_type& alloc)
+      : integer_hash_set(bucket_count, hasher(), alloc) {}
+
+  explicit integer_hash_set(const allocator_type& alloc)
+      : integer_hash_set(0, hasher(), alloc) {}
+
+  template <class InputIter>
+  integer_hash_set(InputIter first, InputIter last, size_t bucket_count = 0,
+                   const hasher& hash = hasher(),
+                   const allocator_type& alloc = allocator_type())
+      : integer_hash_set(bucket_count, hash, alloc) {
+    insert(first, last);
+  }
+
+  integer_hash_set(std::initializer_list<T> init, size_t bucket_count = 0,
+                   const hasher& hash = hasher(),
+                   const allocator_type& alloc = allocator_type())
+      : integer_hash_set(init.begin(), init.end(), bucket_count, hash, alloc) {}
+
+  integer_hash_set(const integer_hash_set& that)
+      : integer_hash_set(that, AllocTraits::select_on_container_copy_construction(
+                                   that.alloc_ref())) {}
+
+  integer_hash_set(const integer_hash_set& that, const allocator_type& a)
+      : integer_hash_set(0, that.hash_ref(), a) {
+    if (that.capacity_ == 0) return;
+    // The layout only depends on the hash function, so the slots can be copied
+    // verbatim.
+    initialize_slots(that.capacity_);
+    std::memcpy(slots_, that.slots_, (capacity_ + 1) * sizeof(T));
+    size_ = that.size_;
+    has_zero_ = that.has_zero_;
+    growth_left_ = that.growth_left_;
+  }
+
+  integer_hash_set(integer_hash_set&& that) noexcept(
+      std::is_nothrow_copy_constructible<hasher>::value &&
+      std::is_nothrow_copy_constructible<allocator_type>::value)
+      : mem_(absl::exchange(that.mem_, nullptr)),
+        slots_(absl::exchange(that.slots_, nullptr)),
+        size_(absl::exchange(that.size_, 0)),
+        capacity_(absl::exchange(that.capacity_, 0)),
+        growth_left_(absl::exchange(that.growth_left_, 0)),
+        has_zero_(absl::exchange(that.has_zero_, false)),
+        // Hash and allocator are copied instead of moved because `that` must
+        // be left valid.
+        settings_(that.settings_) {}
+
+  integer_hash_set& operator=(const integer_hash_set& that) {
+    integer_hash_set tmp(
+        that, AllocTraits::propagate_on_container_copy_assignment::value
+                  ? that.alloc_ref()
+                  : alloc_ref());
+    swap(tmp);
+    return *this;
+  }
+
+  integer_hash_set& operator=(integer_hash_set&& that) noexcept(
+      absl::allocator_traits<allocator_type>::is_always_equal::value &&
+      std::is_nothrow_move_assignable<hasher>::value) {
+    if (AllocTraits::propagate_on_container_move_assignment::value ||
+        alloc_ref() == that.alloc_ref()) {
+      integer_hash_set tmp(std::move(that));
+      swap(tmp);
+    } else {
+      integer_hash_set tmp(that, alloc_ref());
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  ~integer_hash_set() { destroy_slots(); }
+
+  iterator begin() const {
+    if (slots_ == nullptr) return end();
+    iterator it(slots_, slots_ + capacity_, has_zero_);
+    it.skip_empty();
+    return it;
+  }
+  iterator end() const {
+    return slots_ == nullptr ? iterator()
+                             : iterator(slots_ + capacity_ + 1,
+                                        slots_ + capacity_, has_zero_);
+  }
+  iterator cbegin() const { return begin(); }
+  iterator cend() const { return end(); }
+
+  bool empty() const { return !size(); }
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+  size_t max_size() const { return (std::numeric_limits<size_t>::max)(); }
+
+  // Removes all elements. Keeps the current capacity.
+  void clear() {
+    if (slots_ == nullptr) return;
+    std::memset(slots_, 0, (capacity_ + 1) * sizeof(T));
+    size_ = 0;
+    has_zero_ = false;
+    reset_growth_left();
+  }
+
+  std::pair<iterator, bool> insert(T key) {
+    if (key == T{0}) return insert_zero();
+    if (capacity_ != 0) {
+      size_t pos;
+      if (find_or_prepare_insert(key, &pos)) {
+        return {iterator_at(pos), false};
+      }
+      if (growth_left_ > 0) return {iterator_at(insert_at(pos, key)), true};
+    }
+    rehash_and_grow();
+    return {iterator_at(insert_at(find_first_empty(hash_ref()(key)), key)),
+            true};
+  }
+
+  iterator insert(const_iterator, T key) { return insert(key).first; }
+
+  template <class InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  void insert(std::initializer_list<T> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(T(std::forward<Args>(args)...));
+  }
+
+  // Erases the element equal to `key`, if any. Returns the number of erased
+  // elements. Invalidates all iterators.
+  size_t erase(T key) {
+    if (key == T{0}) {
+      if (!has_zero_) return 0;
+      has_zero_ = false;
+      --size_;
+      return 1;
+    }
+    size_t pos;
+    if (capacity_ == 0 || !find_or_prepare_insert(key, &pos)) return 0;
+    erase_at(pos);
+    return 1;
+  }
+
+  // Erases the element pointed to by `it`. Invalidates all iterators.
+  void erase(const_iterator it) { erase(*it); }
+
+  // Erases the elements in [`first`, `last`) and returns `end()`.
+  // Invalidates all iterators.
+  iterator erase(const_iterator first, const_iterator last) {
+    if (first == begin() && last == end()) {
+      clear();
+      return end();
+    }
+    // Erasing may shift later elements in front of `first`, so collect the
+    // keys before erasing them.
+    std::vector<T> keys(first, last);
+    for (T key : keys) erase(key);
+    return end();
+  }
+
+  void swap(integer_hash_set& that) noexcept(
+      container_internal::IsNoThrowSwappable<hasher>() &&
+      (!AllocTraits::propagate_on_container_swap::value ||
+       container_internal::IsNoThrowSwappable<allocator_type>())) {
+    using std::swap;
+    swap(mem_, that.mem_);
+    swap(slots_, that.slots_);
+    swap(size_, that.size_);
+    swap(capacity_, that.capacity_);
+    swap(growth_left_, that.growth_left_);
+    swap(has_zero_, that.has_zero_);
+    swap(hash_ref(), that.hash_ref());
+    if (AllocTraits::propagate_on_container_swap::value) {
+      swap(alloc_ref(), that.alloc_ref());
+    } else {
+      // If the allocators do not compare equal it is officially undefined
+      // behavior. We choose to do nothing.
+    }
+  }
+
+  // Sets the capacity to at least `n` slots, and enough to hold `size()`
+  // elements without exceeding the maximum load factor. `rehash(0)` shrinks
+  // the table to fit.
+  void rehash(size_t n) {
+    if (n == 0 && capacity_ == 0) return;
+    if (n == 0 && size_ == 0) {
+      destroy_slots();
+      mem_ = nullptr;
+      slots_ = nullptr;
+      capacity_ = 0;
+      growth_left_ = 0;
+      return;
+    }
+    const size_t m = NormalizeCapacity(
+        (std::max)(n, GrowthToLowerboundCapacity(size_)));
+    if (n == 0 || m > capacity_) resize(m);
+  }
+
+  void reserve(size_t n) {
+    if (n > size_ - has_zero_ + growth_left_ || capacity_ == 0) {
+      rehash(GrowthToLowerboundCapacity(n));
+    }
+  }
+
+  size_t count(T key) const { return find(key) == end() ? 0 : 1; }
+
+  iterator find(T key) const {
+    if (key == T{0}) return has_zero_ ? iterator_at(capacity_) : end();
+    size_t pos;
+    if (capacity_ == 0 || !find_or_prepare_insert(key, &pos)) return end();
+    return iterator_at(pos);
+  }
+
+  bool contains(T key) const { return find(key) != end(); }
+
+  std::pair<iterator, iterator> equal_range(T key) const {
+    auto it = find(key);
+    if (it != end()) return {it, std::next(it)};
+    return {it, it};
+  }
+
+  size_t bucket_count() const { return capacity_; }
+  float load_factor() const {
+    return capacity_ ? static_cast<double>(size()) / capacity_ : 0.0;
+  }
+  float max_load_factor() const { return 7.0f / 8; }
+  void max_load_factor(float) {
+    // Does nothing.
+  }
+
+  hasher hash_function() const { return hash_ref(); }
+  key_equal key_eq() const { return key_equal(); }
+  allocator_type get_allocator() const { return alloc_ref(); }
+
+  friend bool operator==(const integer_hash_set& a, const integer_hash_set& b) {
+    if (a.size() != b.size()) return false;
+    const integer_hash_set* outer = &a;
+    const integer_hash_set* inner = &b;
+    if (outer->capacity() > inner->capacity()) std::swap(outer, inner);
+    for (T key : *outer) {
+      if (!inner->contains(key)) return false;
+    }
+    return true;
+  }
+
+  friend bool operator!=(const integer_hash_set& a, const integer_hash_set& b) {
+    return !(a == b);
+  }
+
+  friend void swap(integer_hash_set& a,
+                   integer_hash_set& b) noexcept(noexcept(a.swap(b))) {
+    a.swap(b);
+  }
+
+ private:
+  // Capacities are powers of two and at least one group wide. The maximum load
+  // factor is 7/8, as in `raw_hash_set`, and at least one slot is always left
+  // empty so that probing terminates.
+  static size_t NormalizeCapacity(size_t n) {
+    size_t c = kWidth;
+    while (c < n) c *= 2;
+    return c;
+  }
+  static size_t CapacityToGrowth(size_t capacity) {
+    return capacity - (std::max)(capacity / 8, size_t{1});
+  }
+  static size_t GrowthToLowerboundCapacity(size_t growth) {
+    return growth + growth / 7 + 1;
+  }
+
+  size_t group_mask() const { return (capacity_ - 1) & ~(kWidth - 1); }
+
+  // Offset of the first slot of the group `key` belongs to.
+  size_t home_group(size_t hash) const {
+    return (hash * kWidth) & group_mask();
+  }
+
+  iterator iterator_at(size_t pos) const {
+    return iterator(slots_ + pos, slots_ + capacity_, has_zero_);
+  }
+
+  // Looks `key` up. Returns true and sets `*pos` to its slot if found.
+  // Otherwise returns false and sets `*pos` to the slot where it would be
+  // inserted.
+  //
+  // Elements are placed in the first group with an empty slot following their
+  // home group, so the search stops at the first group that has an empty slot.
+  bool find_or_prepare_insert(T key, size_t* pos) const {
+    assert(capacity_ != 0);
+    const size_t mask = capacity_ - 1;
+    size_t offset = home_group(hash_ref()(key));
+    while (true) {
+      Group g(slots_ + offset);
+      auto match = g.Match(key);
+      if (match) {
+        *pos = offset + match.LowestBitSet();
+        return true;
+      }
+      auto empty = g.Match(T{0});
+      if (empty) {
+        *pos = offset + empty.LowestBitSet();
+        return false;
+      }
+      offset = (offset + kWidth) & mask;
+    }
+  }
+
+  size_t find_first_empty(size_t hash) const {
+    const size_t mask = capacity_ - 1;
+    size_t offset = home_group(hash);
+    while (true) {
+      auto empty = Group(slots_ + offset).Match(T{0});
+      if (empty) return offset + empty.LowestBitSet();
+      offset = (offset + kWidth) & mask;
+    }
+  }
+
+  size_t insert_at(size_t pos, T key) {
+    slots_[pos] = key;
+    ++size_;
+    --growth_left_;
+    return pos;
+  }
+
+  std::pair<iterator, bool> insert_zero() {
+    if (has_zero_) return {iterator_at(capacity_), false};
+    if (capacity_ == 0) resize(NormalizeCapacity(0));
+    has_zero_ = true;
+    ++size_;
+    return {iterator_at(capacity_), true};
+  }
+
+  // Removes the element at `pos` and shifts later elements of the same
+  // cluster back so that every element remains reachable from its home group
+  // without crossing a group that has an empty slot.
+  void erase_at(size_t pos) {
+    const size_t mask = capacity_ - 1;
+    size_t hole = pos;
+    size_t hole_group = pos & ~(kWidth - 1);
+    // If the group already had an empty slot, no element can have probed past
+    // it and nothing needs to move.
+    const bool was_full = !Group(slots_ + hole_group).Match(T{0});
+    slots_[pos] = T{0};
+    --size_;
+    ++growth_left_;
+    if (!was_full) return;
+
+    size_t offset = (hole_group + kWidth) & mask;
+    while (offset != hole_group) {
+      Group g(slots_ + offset);
+      const bool had_empty = static_cast<bool>(g.Match(T{0}));
+      for (size_t i = 0; i != kWidth; ++i) {
+        const T key = slots_[offset + i];
+        if (key == T{0}) continue;
+        // The element can fill the hole unless its home group lies in
+        // (hole_group, offset].
+        const size_t home = home_group(hash_ref()(key));
+        const size_t d_home = (home - hole_group) & mask;
+        const size_t d_here = (offset - hole_group) & mask;
+        if (d_home != 0 && d_home <= d_here) continue;
+        slots_[hole] = key;
+        slots_[offset + i] = T{0};
+        hole = offset + i;
+        hole_group = offset;
+        break;
+      }
+      // No element past a group with an empty slot can depend on the groups
+      // before it.
+      if (had_empty) break;
+      offset = (offset + kWidth) & mask;
+    }
+  }
+
+  // Number of slots to allocate for a table of `capacity`. One extra slot past
+  // the end holds the sentinel key when it is a member, so that iterators can
+  // point to it. The rest is padding used to align the slots so that no group
+  // straddles two cache lines.
+  static size_t AllocatedSlots(size_t capacity) {
+    return capacity + 1 + kWidth - 1;
+  }
+
+  void initialize_slots(size_t capacity) {
+    assert(capacity >= kWidth && (capacity & (capacity - 1)) == 0);
+    capacity_ = capacity;
+    mem_ = AllocTraits::allocate(alloc_ref(), AllocatedSlots(capacity_));
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(mem_);
+    const uintptr_t align = container_internal::kIntegerGroupBytes;
+    slots_ = mem_ + ((align - addr % align) % align) / sizeof(T);
+    std::memset(slots_, 0, (capacity_ + 1) * sizeof(T));
+    reset_growth_left();
+  }
+
+  void destroy_slots() {
+    if (mem_ == nullptr) return;
+    AllocTraits::deallocate(alloc_ref(), mem_, AllocatedSlots(capacity_));
+  }
+
+  void resize(size_t new_capacity) {
+    T* old_mem = mem_;
+    T* old_slots = slots_;
+    const size_t old_capacity = capacity_;
+    initialize_slots(new_capacity);
+    for (size_t i = 0; i != old_capacity; ++i) {
+      const T key = old_slots[i];
+      if (key == T{0}) continue;
+      slots_[find_first_empty(hash_ref()(key))] = key;
+    }
+    growth_left_ -= size_ - has_zero_;
+    if (old_mem != nullptr) {
+      AllocTraits::deallocate(alloc_ref(), old_mem,
+                              AllocatedSlots(old_capacity));
+    }
+  }
+
+  void rehash_and_grow() {
+    resize(capacity_ == 0 ? NormalizeCapacity(0) : capacity_ * 2);
+  }
+
+  void reset_growth_left() { growth_left_ = CapacityToGrowth(capacity_); }
+
+  hasher& hash_ref() { return settings_.template get<0>(); }
+  const hasher& hash_ref() const { return settings_.template get<0>(); }
+  allocator_type& alloc_ref() { return settings_.template get<1>(); }
+  const allocator_type& alloc_ref() const {
+    return settings_.template get<1>();
+  }
+
+  T* mem_ = nullptr;     // start of the allocation
+  T* slots_ = nullptr;   // [capacity + 1], aligned to a group
+  size_t size_ = 0;      // number of elements, including the sentinel key
+  size_t capacity_ = 0;  // number of probed slots, a power of two
+  size_t growth_left_ = 0;
+  bool has_zero_ = false;  // whether the sentinel key is a member
+  absl::container_internal::CompressedTuple<hasher, allocator_type> settings_{
+      hasher{}, allocator_type{}};
+};
+
+}  // namespace absl
+
+#endif  // ABSL_CONTAINER_INTEGER_HASH_SET_H_
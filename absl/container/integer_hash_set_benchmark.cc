@@ -0,0 +1,103 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/integer_hash_set.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "absl/container/flat_hash_set.h"
+
+namespace {
+
+template <class T>
+std::vector<T> RandomKeys(size_t n, uint32_t seed) {
+  std::mt19937_64 gen(seed);
+  std::vector<T> keys(n);
+  for (auto& k : keys) k = static_cast<T>(gen());
+  return keys;
+}
+
+template <class Set>
+void BM_Insert(benchmark::State& state) {
+  using T = typename Set::value_type;
+  const auto keys = RandomKeys<T>(state.range(0), 1);
+  for (auto _ : state) {
+    Set s;
+    for (T k : keys) s.insert(k);
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          keys.size());
+}
+
+template <class Set>
+void BM_FindHit(benchmark::State& state) {
+  using T = typename Set::value_type;
+  const auto keys = RandomKeys<T>(state.range(0), 1);
+  Set s(keys.begin(), keys.end());
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.contains(keys[i]));
+    if (++i == keys.size()) i = 0;
+  }
+}
+
+template <class Set>
+void BM_FindMiss(benchmark::State& state) {
+  using T = typename Set::value_type;
+  const auto keys = RandomKeys<T>(state.range(0), 1);
+  const auto misses = RandomKeys<T>(state.range(0), 2);
+  Set s(keys.begin(), keys.end());
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.contains(misses[i]));
+    if (++i == misses.size()) i = 0;
+  }
+}
+
+template <class Set>
+void BM_EraseInsert(benchmark::State& state) {
+  using T = typename Set::value_type;
+  const auto keys = RandomKeys<T>(state.range(0), 1);
+  const auto other = RandomKeys<T>(state.range(0), 2);
+  Set s(keys.begin(), keys.end());
+  size_t i = 0;
+  for (auto _ : state) {
+    s.erase(keys[i]);
+    s.insert(other[i]);
+    s.erase(other[i]);
+    s.insert(keys[i]);
+    if (++i == keys.size()) i = 0;
+  }
+}
+
+#define BENCHMARK_SETS(bm)                                                \
+  BENCHMARK_TEMPLATE(bm, absl::flat_hash_set<uint32_t>)                   \
+      ->Range(1 << 4, 1 << 22);                                           \
+  BENCHMARK_TEMPLATE(bm, absl::integer_hash_set<uint32_t>)                \
+      ->Range(1 << 4, 1 << 22);                                           \
+  BENCHMARK_TEMPLATE(bm, absl::flat_hash_set<uint64_t>)                   \
+      ->Range(1 << 4, 1 << 22);                                           \
+  BENCHMARK_TEMPLATE(bm, absl::integer_hash_set<uint64_t>)                \
+      ->Range(1 << 4, 1 << 22)
+
+BENCHMARK_SETS(BM_Insert);
+BENCHMARK_SETS(BM_FindHit);
+BENCHMARK_SETS(BM_FindMiss);
+BENCHMARK_SETS(BM_EraseInsert);
+
+}  // namespace
@@ -0,0 +1,174 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/integer_hash_set.h"
+
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace absl {
+namespace container_internal {
+namespace {
+
+using ::testing::UnorderedElementsAre;
+using ::testing::UnorderedElementsAreArray;
+
+template <class T>
+class IntegerHashSetTest : public ::testing::Test {};
+
+using KeyTypes = ::testing::Types<uint32_t, int32_t, uint64_t, int64_t>;
+TYPED_TEST_SUITE(IntegerHashSetTest, KeyTypes);
+
+TYPED_TEST(IntegerHashSetTest, Empty) {
+  integer_hash_set<TypeParam> s;
+  EXPECT_TRUE(s.empty());
+  EXPECT_EQ(0, s.size());
+  EXPECT_EQ(s.begin(), s.end());
+  EXPECT_FALSE(s.contains(0));
+  EXPECT_FALSE(s.contains(1));
+  EXPECT_EQ(0, s.erase(1));
+}
+
+TYPED_TEST(IntegerHashSetTest, InsertFindErase) {
+  integer_hash_set<TypeParam> s;
+  EXPECT_TRUE(s.insert(1).second);
+  EXPECT_FALSE(s.insert(1).second);
+  EXPECT_TRUE(s.insert(0).second);
+  EXPECT_FALSE(s.insert(0).second);
+  EXPECT_TRUE(s.insert(static_cast<TypeParam>(-1)).second);
+  EXPECT_EQ(3, s.size());
+  EXPECT_EQ(1, *s.find(1));
+  EXPECT_EQ(0, *s.find(0));
+  EXPECT_THAT(s, UnorderedElementsAre(0, 1, static_cast<TypeParam>(-1)));
+
+  EXPECT_EQ(1, s.erase(0));
+  EXPECT_EQ(0, s.erase(0));
+  EXPECT_FALSE(s.contains(0));
+  EXPECT_THAT(s, UnorderedElementsAre(1, static_cast<TypeParam>(-1)));
+  s.erase(s.find(1));
+  EXPECT_THAT(s, UnorderedElementsAre(static_cast<TypeParam>(-1)));
+}
+
+TYPED_TEST(IntegerHashSetTest, MatchesReferenceImplementation) {
+  integer_hash_set<TypeParam> s;
+  std::unordered_set<TypeParam> ref;
+  std::mt19937 gen(42);
+  // A small key range produces long clusters and exercises backward shifting.
+  std::uniform_int_distribution<int> key(0, 500);
+  std::uniform_int_distribution<int> op(0, 2);
+  for (int i = 0; i < 100000; ++i) {
+    const TypeParam k = static_cast<TypeParam>(key(gen));
+    switch (op(gen)) {
+      case 0:
+      case 1:
+        EXPECT_EQ(ref.insert(k).second, s.insert(k).second);
+        break;
+      case 2:
+        EXPECT_EQ(ref.erase(k), s.erase(k));
+        break;
+    }
+    ASSERT_EQ(ref.size(), s.size());
+  }
+  for (int k = 0; k <= 500; ++k) {
+    EXPECT_EQ(ref.count(static_cast<TypeParam>(k)),
+              s.count(static_cast<TypeParam>(k)));
+  }
+  EXPECT_THAT(s, UnorderedElementsAreArray(ref.begin(), ref.end()));
+}
+
+TYPED_TEST(IntegerHashSetTest, Growth) {
+  integer_hash_set<TypeParam> s;
+  for (int i = 0; i < 10000; ++i) s.insert(static_cast<TypeParam>(i * 7919));
+  EXPECT_EQ(10000, s.size());
+  EXPECT_LE(s.load_factor(), s.max_load_factor());
+  for (int i = 0; i < 10000; ++i) {
+    EXPECT_TRUE(s.contains(static_cast<TypeParam>(i * 7919)));
+  }
+  size_t n = 0;
+  for (auto it = s.begin(); it != s.end(); ++it) ++n;
+  EXPECT_EQ(10000, n);
+}
+
+TYPED_TEST(IntegerHashSetTest, ReserveAndRehash) {
+  integer_hash_set<TypeParam> s;
+  s.reserve(1000);
+  const size_t cap = s.capacity();
+  EXPECT_GE(cap, 1000);
+  for (int i = 0; i < 1000; ++i) s.insert(static_cast<TypeParam>(i));
+  EXPECT_EQ(cap, s.capacity());
+  for (int i = 0; i < 990; ++i) s.erase(static_cast<TypeParam>(i));
+  s.rehash(0);
+  EXPECT_LT(s.capacity(), cap);
+  EXPECT_EQ(10, s.size());
+  for (int i = 990; i < 1000; ++i) {
+    EXPECT_TRUE(s.contains(static_cast<TypeParam>(i)));
+  }
+  s.clear();
+  EXPECT_TRUE(s.empty());
+  s.rehash(0);
+  EXPECT_EQ(0, s.capacity());
+}
+
+TYPED_TEST(IntegerHashSetTest, CopyMoveSwap) {
+  integer_hash_set<TypeParam> a = {0, 1, 2, 3};
+  integer_hash_set<TypeParam> b(a);
+  EXPECT_EQ(a, b);
+  b.insert(4);
+  EXPECT_NE(a, b);
+
+  integer_hash_set<TypeParam> c(std::move(b));
+  EXPECT_THAT(c, UnorderedElementsAre(0, 1, 2, 3, 4));
+  EXPECT_TRUE(b.empty());  // NOLINT(bugprone-use-after-move)
+  b.insert(9);
+  EXPECT_THAT(b, UnorderedElementsAre(9));
+
+  a = c;
+  EXPECT_EQ(a, c);
+  b = std::move(c);
+  EXPECT_EQ(a, b);
+
+  integer_hash_set<TypeParam> d = {7};
+  swap(a, d);
+  EXPECT_THAT(a, UnorderedElementsAre(7));
+  EXPECT_THAT(d, UnorderedElementsAre(0, 1, 2, 3, 4));
+}
+
+TYPED_TEST(IntegerHashSetTest, EraseRange) {
+  integer_hash_set<TypeParam> s;
+  for (int i = 0; i < 100; ++i) s.insert(static_cast<TypeParam>(i));
+  s.erase(s.begin(), s.end());
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(IntegerGroup, Match) {
+  uint32_t keys32[8] = {0, 5, 0, 5, 1, 2, 3, 5};
+  EXPECT_THAT(IntegerGroup<uint32_t>(keys32).Match(5),
+              ::testing::ElementsAre(1, 3, 7));
+  EXPECT_THAT(IntegerGroup<uint32_t>(keys32).Match(0),
+              ::testing::ElementsAre(0, 2));
+  uint64_t keys64[4] = {uint64_t{5} << 32, 5, 0, 5};
+  EXPECT_THAT(IntegerGroup<uint64_t>(keys64).Match(5),
+              ::testing::ElementsAre(1, 3));
+  EXPECT_THAT(IntegerGroup<uint64_t>(keys64).Match(uint64_t{5} << 32),
+              ::testing::ElementsAre(0));
+}
+
+}  // namespace
+}  // namespace container_internal
+}  // namespace absl
@@ -139,6 +139,18 @@ template <class T>
 using hash_default_eq = typename container_internal::HashEq<T>::Eq;
 
 }  // namespace container_internal
+
+namespace hash_internal {
+
+// `absl::Hash` hashes `std::string` and `absl::string_view` alike.
+template <>
+struct HashesLikeAbslHash<container_internal::StringHash, std::string>
+    : std::true_type {};
+template <>
+struct HashesLikeAbslHash<container_internal::StringHash, absl::string_view>
+    : std::true_type {};
+
+}  // namespace hash_internal
 }  // namespace absl
 
 #endif  // ABSL_CONTAINER_INTERNAL_HASH_FUNCTION_DEFAULTS_H_
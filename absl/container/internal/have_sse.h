@@ -34,10 +34,22 @@
 #endif
 #endif
 
+#ifndef SWISSTABLE_HAVE_AVX2
+#ifdef __AVX2__
+#define SWISSTABLE_HAVE_AVX2 1
+#else
+#define SWISSTABLE_HAVE_AVX2 0
+#endif
+#endif
+
 #if SWISSTABLE_HAVE_SSSE3 && !SWISSTABLE_HAVE_SSE2
 #error "Bad configuration!"
 #endif
 
+#if SWISSTABLE_HAVE_AVX2 && !SWISSTABLE_HAVE_SSSE3
+#error "Bad configuration!"
+#endif
+
 #if SWISSTABLE_HAVE_SSE2
 #include <emmintrin.h>
 #endif
@@ -46,4 +58,8 @@
 #include <tmmintrin.h>
 #endif
 
+#if SWISSTABLE_HAVE_AVX2
+#include <immintrin.h>
+#endif
+
 #endif  // ABSL_CONTAINER_INTERNAL_HAVE_SSE_H_
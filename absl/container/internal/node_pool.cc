@@ -0,0 +1,180 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/internal/node_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+namespace absl {
+namespace container_internal {
+
+constexpr size_t NodePool::kDefaultMaxSlabBytes;
+
+namespace {
+
+// Number of blocks in the first slab of a pool. Subsequent slabs double in size
+// until they reach the pool's maximum slab size.
+constexpr size_t kInitialSlabNodes = 32;
+
+size_t RoundUp(size_t n, size_t align) {
+  return (n + align - 1) & ~(align - 1);
+}
+
+uintptr_t Addr(const void* p) { return reinterpret_cast<uintptr_t>(p); }
+
+}  // namespace
+
+// Header placed at the beginning of every slab. Blocks follow it, starting at
+// the first multiple of the node alignment.
+struct NodePool::Slab {
+  Slab* prev;
+  Slab* next;
+  void* free_list;
+  char* bump;
+  char* end;
+  size_t live;
+  size_t bytes;
+  bool in_partial;
+};
+
+NodePool::NodePool(size_t node_size, size_t node_align, size_t max_slab_bytes)
+    : node_size_(RoundUp(std::max(node_size, sizeof(void*)),
+                         std::max(node_align, alignof(void*)))),
+      node_align_(std::max(node_align, alignof(void*))),
+      max_slab_bytes_(max_slab_bytes) {
+  assert((node_align_ & (node_align_ - 1)) == 0 &&
+         "node alignment must be a power of two");
+  assert(node_align_ <= alignof(std::max_align_t) &&
+         "over-aligned nodes are not supported");
+  next_slab_nodes_ = kInitialSlabNodes;
+}
+
+NodePool::~NodePool() {
+  for (Slab* slab : slabs_) ::operator delete(slab);
+}
+
+void* NodePool::Allocate() {
+  Slab* slab = partial_ != nullptr ? partial_ : NewSlab();
+  void* p;
+  if (slab->free_list != nullptr) {
+    p = slab->free_list;
+    slab->free_list = *static_cast<void**>(p);
+  } else {
+    p = slab->bump;
+    slab->bump += node_size_;
+  }
+  if (slab->live++ == 0) --empty_slabs_;
+  if (slab->free_list == nullptr && slab->bump == slab->end) {
+    UnlinkPartial(slab);
+  }
+  ++live_nodes_;
+  return p;
+}
+
+void NodePool::Deallocate(void* p) {
+  Slab* slab = FindSlab(p);
+  assert(slab->live > 0);
+  *static_cast<void**>(p) = slab->free_list;
+  slab->free_list = p;
+  --live_nodes_;
+  if (!slab->in_partial) LinkPartial(slab);
+  if (--slab->live == 0) {
+    if (empty_slabs_ > 0) {
+      ReleaseSlab(slab);
+    } else {
+      // Keep a single empty slab around, rewound so that the next blocks are
+      // handed out in address order again.
+      ++empty_slabs_;
+      slab->free_list = nullptr;
+      slab->bump = reinterpret_cast<char*>(slab) +
+                   RoundUp(sizeof(Slab), node_align_);
+    }
+  }
+}
+
+NodePool::Slab* NodePool::NewSlab() {
+  const size_t header = RoundUp(sizeof(Slab), node_align_);
+  const size_t max_nodes =
+      max_slab_bytes_ > header + node_size_
+          ? (max_slab_bytes_ - header) / node_size_
+          : 1;
+  const size_t nodes = std::min(next_slab_nodes_, max_nodes);
+  next_slab_nodes_ = std::min(nodes * 2, max_nodes);
+
+  const size_t bytes = header + nodes * node_size_;
+  char* mem = static_cast<char*>(::operator new(bytes));
+  Slab* slab = new (mem) Slab;
+  slab->prev = nullptr;
+  slab->next = nullptr;
+  slab->free_list = nullptr;
+  slab->bump = mem + header;
+  slab->end = mem + bytes;
+  slab->live = 0;
+  slab->bytes = bytes;
+  slab->in_partial = false;
+
+  auto it = std::upper_bound(
+      slabs_.begin(), slabs_.end(), Addr(slab),
+      [](uintptr_t a, const Slab* s) { return a < Addr(s); });
+  slabs_.insert(it, slab);
+  bytes_reserved_ += bytes;
+  ++empty_slabs_;
+  LinkPartial(slab);
+  return slab;
+}
+
+void NodePool::ReleaseSlab(Slab* slab) {
+  if (slab->in_partial) UnlinkPartial(slab);
+  auto it = std::lower_bound(
+      slabs_.begin(), slabs_.end(), Addr(slab),
+      [](const Slab* s, uintptr_t a) { return Addr(s) < a; });
+  assert(it != slabs_.end() && *it == slab);
+  slabs_.erase(it);
+  bytes_reserved_ -= slab->bytes;
+  ::operator delete(slab);
+}
+
+NodePool::Slab* NodePool::FindSlab(const void* p) const {
+  auto it = std::upper_bound(
+      slabs_.begin(), slabs_.end(), Addr(p),
+      [](uintptr_t a, const Slab* s) { return a < Addr(s); });
+  assert(it != slabs_.begin() && "pointer does not belong to this pool");
+  Slab* slab = *--it;
+  assert(Addr(p) < Addr(slab->end) && "pointer does not belong to this pool");
+  return slab;
+}
+
+void NodePool::LinkPartial(Slab* slab) {
+  slab->prev = nullptr;
+  slab->next = partial_;
+  if (partial_ != nullptr) partial_->prev = slab;
+  partial_ = slab;
+  slab->in_partial = true;
+}
+
+void NodePool::UnlinkPartial(Slab* slab) {
+  if (slab->prev != nullptr) {
+    slab->prev->next = slab->next;
+  } else {
+    partial_ = slab->next;
+  }
+  if (slab->next != nullptr) slab->next->prev = slab->prev;
+  slab->prev = slab->next = nullptr;
+  slab->in_partial = false;
+}
+
+}  // namespace container_internal
+}  // namespace absl
@@ -0,0 +1,106 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: node_pool.h
+// -----------------------------------------------------------------------------
+//
+// `NodePool` hands out fixed-size blocks carved from large slabs. It backs
+// `absl::node_pool_allocator` and is tuned for the allocation pattern of node
+// based hash tables: many small, same-sized objects whose addresses must stay
+// stable for their whole lifetime.
+//
+// Each slab keeps its own free list and a count of live blocks. Allocation
+// prefers partially used slabs, and a slab that becomes completely empty is
+// returned to the system (one empty slab is kept around to avoid thrashing
+// when a table oscillates around a slab boundary).
+//
+// `NodePool` is not thread-safe.
+//
+// This utility is internal-only. Use at your own risk.
+
+#ifndef ABSL_CONTAINER_INTERNAL_NODE_POOL_H_
+#define ABSL_CONTAINER_INTERNAL_NODE_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace absl {
+namespace container_internal {
+
+class NodePool {
+ public:
+  // Upper bound on the size of a single slab. Slabs start small and double in
+  // size until they reach this limit.
+  static constexpr size_t kDefaultMaxSlabBytes = 64 * 1024;
+
+  // Creates a pool of blocks that can each hold an object of `node_size`
+  // bytes aligned to `node_align`. `node_align` must be a power of two no
+  // larger than `alignof(std::max_align_t)`.
+  NodePool(size_t node_size, size_t node_align,
+           size_t max_slab_bytes = kDefaultMaxSlabBytes);
+  ~NodePool();
+
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+
+  // Returns a block of `node_size()` bytes. Never returns nullptr.
+  void* Allocate();
+
+  // Returns `p`, previously obtained from `Allocate()` on this pool, to the
+  // pool. Releases the owning slab if it becomes empty.
+  void Deallocate(void* p);
+
+  size_t node_size() const { return node_size_; }
+  size_t node_align() const { return node_align_; }
+  size_t max_slab_bytes() const { return max_slab_bytes_; }
+
+  // Number of slabs currently held by the pool.
+  size_t slab_count() const { return slabs_.size(); }
+
+  // Number of blocks handed out and not yet returned.
+  size_t live_nodes() const { return live_nodes_; }
+
+  // Total number of bytes obtained from the system for slabs.
+  size_t bytes_reserved() const { return bytes_reserved_; }
+
+ private:
+  struct Slab;
+
+  Slab* NewSlab();
+  void ReleaseSlab(Slab* slab);
+  Slab* FindSlab(const void* p) const;
+  void LinkPartial(Slab* slab);
+  void UnlinkPartial(Slab* slab);
+
+  const size_t node_size_;
+  const size_t node_align_;
+  const size_t max_slab_bytes_;
+  size_t next_slab_nodes_;
+
+  // All slabs, sorted by address so the owner of a block can be found with a
+  // binary search.
+  std::vector<Slab*> slabs_;
+  // Intrusive list of slabs that still have room for at least one block.
+  Slab* partial_ = nullptr;
+  size_t empty_slabs_ = 0;
+  size_t live_nodes_ = 0;
+  size_t bytes_reserved_ = 0;
+};
+
+}  // namespace container_internal
+}  // namespace absl
+
+#endif  // ABSL_CONTAINER_INTERNAL_NODE_POOL_H_
@@ -91,6 +91,7 @@
 #include "absl/container/internal/hashtablez_sampler.h"
 #include "absl/container/internal/have_sse.h"
 #include "absl/container/internal/layout.h"
+#include "absl/hash/hash.h"
 #include "absl/memory/memory.h"
 #include "absl/meta/type_traits.h"
 #include "absl/utility/utility.h"
@@ -725,7 +726,7 @@ public:
     Inner& inner = sets_[subidx(hash)];
     auto&  set   = inner.set_;
     MutexLock_ m(&inner);
-    return make_iterator(&inner, set.lazy_emplace(key, hash, std::forward<F>(f)));
+    return make_iterator(&inner, set.lazy_emplace_with_hash(key, hash, std::forward<F>(f)));
   }
 
   // Extension API: support for heterogeneous keys.
@@ -911,6 +912,31 @@ public:
     return find(key) != end();
   }
 
+  // Overloads of find(), contains() and count() for a key whose hash was
+  // computed in advance, see absl::HashedKey. The stored hash is used only if
+  // the container hashes its keys with absl::Hash; otherwise the key is
+  // hashed again.
+  template <class K>
+  iterator find(const absl::HashedKey<K>& key) {
+    if (!hash_internal::HashesLikeAbslHash<hasher, K>::value) {
+      return find(key.key());
+    }
+    assert(hash_ref()(key.key()) == key.hash());
+    return find(key.key(), key.hash());
+  }
+  template <class K>
+  const_iterator find(const absl::HashedKey<K>& key) const {
+    return const_cast<parallel_hash_set*>(this)->find(key);
+  }
+  template <class K>
+  bool contains(const absl::HashedKey<K>& key) const {
+    return find(key) != end();
+  }
+  template <class K>
+  size_t count(const absl::HashedKey<K>& key) const {
+    return find(key) == end() ? 0 : 1;
+  }
+
   template <class K = key_type>
   std::pair<iterator, iterator> equal_range(const key_arg<K>& key) {
     auto it = find(key);
@@ -963,6 +989,31 @@ public:
     a.swap(b);
   }
 
+  // Extension API: direct access to the submaps.
+  //
+  // The container is split into `subcnt()` independent hash sets, and an
+  // element whose hash is `h` lives in submap `subidx(h)`. `with_submap(idx,
+  // f)` calls `f(set)` with submap `idx` locked, `set` being a reference to its
+  // `EmbeddedSet`. This allows several operations on one submap, for instance
+  // a batch of lookups, under a single lock. `f` must only insert elements
+  // that belong to submap `idx`, and should pass the precomputed hash to the
+  // `EmbeddedSet` (`set.find(key, hash)`) to avoid hashing twice.
+  // --------------------------------------------------------------------
+  template <class F>
+  void with_submap(size_t idx, F&& f) {
+    Inner& inner = sets_[idx];
+    MutexLock_ m(&inner);
+    std::forward<F>(f)(inner.set_);
+  }
+
+  static size_t subidx(size_t hashval) {
+    return (hashval ^ (hashval >> N)) & mask;
+  }
+
+  static size_t subcnt() {
+    return num_tables;
+  }
+
 private:
   template <class Container, typename Enabler>
   friend struct absl::container_internal::hashtable_debug_internal::
@@ -1064,14 +1115,6 @@ protected:
     return {inner, &sets_[0] + num_tables, it}; 
   }
 
-  static size_t subidx(size_t hashval) {
-    return (hashval ^ (hashval >> N)) & mask;
-  }
-
-  static size_t subcnt() {
-    return num_tables;
-  }
-
 private:
   friend struct RawHashSetTestOnlyAccess;
 
@@ -113,6 +113,7 @@
 #include "absl/container/internal/hashtablez_sampler.h"
 #include "absl/container/internal/have_sse.h"
 #include "absl/container/internal/layout.h"
+#include "absl/hash/hash.h"
 #include "absl/memory/memory.h"
 #include "absl/meta/type_traits.h"
 #include "absl/utility/utility.h"
@@ -1334,6 +1335,31 @@ class raw_hash_set {
     return find(key) != end();
   }
 
+  // Overloads of find(), contains() and count() for a key whose hash was
+  // computed in advance, see absl::HashedKey. The stored hash is used only if
+  // the container hashes its keys with absl::Hash; otherwise the key is
+  // hashed again.
+  template <class K>
+  iterator find(const absl::HashedKey<K>& key) {
+    if (!hash_internal::HashesLikeAbslHash<hasher, K>::value) {
+      return find(key.key());
+    }
+    assert(hash_ref()(key.key()) == key.hash());
+    return find(key.key(), key.hash());
+  }
+  template <class K>
+  const_iterator find(const absl::HashedKey<K>& key) const {
+    return const_cast<raw_hash_set*>(this)->find(key);
+  }
+  template <class K>
+  bool contains(const absl::HashedKey<K>& key) const {
+    return find(key) != end();
+  }
+  template <class K>
+  size_t count(const absl::HashedKey<K>& key) const {
+    return find(key) == end() ? 0 : 1;
+  }
+
   template <class K = key_type>
   std::pair<iterator, iterator> equal_range(const key_arg<K>& key) {
     auto it = find(key);
@@ -69,6 +69,11 @@ class NodeHashMapPolicy;
 //   slots (open, deleted, and empty) within the hash map.
 // * Returns `void` from the `erase(iterator)` overload.
 //
+// Each element is allocated individually through the map's allocator. Maps
+// holding many small elements can pass `absl::node_pool_allocator` (see
+// absl/container/node_pool_allocator.h) to carve nodes from large slabs
+// instead.
+//
 // By default, `node_hash_map` uses the `absl::Hash` hashing framework.
 // All fundamental and Abseil types that support the `absl::Hash` framework have
 // a compatible equality operator for comparing insertions into `node_hash_map`.
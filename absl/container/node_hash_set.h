@@ -65,6 +65,11 @@ struct NodeHashSetPolicy;
 //   slots (open, deleted, and empty) within the hash set.
 // * Returns `void` from the `erase(iterator)` overload.
 //
+// Each element is allocated individually through the set's allocator. Sets
+// holding many small elements can pass `absl::node_pool_allocator` (see
+// absl/container/node_pool_allocator.h) to carve nodes from large slabs
+// instead.
+//
 // By default, `node_hash_set` uses the `absl::Hash` hashing framework.
 // All fundamental and Abseil types that support the `absl::Hash` framework have
 // a compatible equality operator for comparing insertions into `node_hash_set`.
@@ -0,0 +1,161 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: node_pool_allocator.h
+// -----------------------------------------------------------------------------
+//
+// An `absl::node_pool_allocator<T>` is an opt-in allocator for node based
+// containers such as `absl::node_hash_map` and `absl::node_hash_set`. Instead
+// of calling the global allocator once per element, it carves single-element
+// allocations out of large slabs and recycles them through per-slab free lists.
+// Slabs that become completely empty are returned to the system.
+//
+// Compared to the default allocator this removes the per-node malloc header and
+// size-class rounding, performs far fewer calls into the global allocator, and
+// places nodes that are inserted together next to each other in memory.
+// Pointer stability is unaffected: a node never moves once allocated.
+//
+// Allocations of more than one object (such as the table's control bytes and
+// slot array) are forwarded to `std::allocator`.
+//
+// Example:
+//
+//   using Alloc = absl::node_pool_allocator<std::pair<const int, std::string>>;
+//   absl::node_hash_map<int, std::string,
+//                       absl::node_hash_map<int, std::string>::hasher,
+//                       absl::node_hash_map<int, std::string>::key_equal,
+//                       Alloc> map;
+//
+// Every default-constructed `node_pool_allocator` owns a fresh pool, so each
+// container gets its own. Copies of an allocator (including rebound copies)
+// share the pool. Copy-constructing a container gives the copy a new pool,
+// while moving or swapping containers carries the pool along with the nodes.
+//
+// A pool is not thread-safe: containers that share a pool must not be modified
+// concurrently. In practice this means that a container and its allocator are
+// subject to the usual rules for `absl::node_hash_map` and friends.
+
+#ifndef ABSL_CONTAINER_NODE_POOL_ALLOCATOR_H_
+#define ABSL_CONTAINER_NODE_POOL_ALLOCATOR_H_
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "absl/container/internal/node_pool.h"
+
+namespace absl {
+
+template <class T>
+class node_pool_allocator {
+  using Pool = container_internal::NodePool;
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  // Containers keep the pool that allocated their nodes when they are moved or
+  // swapped. A copy-assigned container keeps its own pool.
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  template <class U>
+  struct rebind {
+    using other = node_pool_allocator<U>;
+  };
+
+  // Creates an allocator with a new pool sized for objects of type `T`.
+  node_pool_allocator()
+      : pool_(std::make_shared<Pool>(sizeof(T), alignof(T))) {}
+
+  // Creates an allocator with a new pool sized for objects of type `T` whose
+  // slabs grow to at most `max_slab_bytes` bytes.
+  explicit node_pool_allocator(size_t max_slab_bytes)
+      : pool_(std::make_shared<Pool>(sizeof(T), alignof(T), max_slab_bytes)) {}
+
+  // Copies share the pool. There is intentionally no move constructor: a
+  // moved-from container must keep a usable allocator.
+  node_pool_allocator(const node_pool_allocator& other) : pool_(other.pool_) {}
+
+  template <class U>
+  node_pool_allocator(const node_pool_allocator<U>& other)  // NOLINT
+      : pool_(other.pool_) {}
+
+  node_pool_allocator& operator=(const node_pool_allocator& other) {
+    pool_ = other.pool_;
+    return *this;
+  }
+
+  T* allocate(size_type n) {
+    if (UsesPool(n)) return static_cast<T*>(pool_->Allocate());
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, size_type n) {
+    if (UsesPool(n)) {
+      pool_->Deallocate(p);
+    } else {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  // A copy-constructed container starts with an empty pool of its own, so that
+  // the source and the copy can be used from different threads.
+  node_pool_allocator select_on_container_copy_construction() const {
+    return node_pool_allocator(std::make_shared<Pool>(
+        pool_->node_size(), pool_->node_align(), pool_->max_slab_bytes()));
+  }
+
+  // Number of slabs currently held by the pool.
+  size_t slab_count() const { return pool_->slab_count(); }
+
+  // Number of bytes the pool currently holds for slabs.
+  size_t bytes_reserved() const { return pool_->bytes_reserved(); }
+
+  friend bool operator==(const node_pool_allocator& a,
+                         const node_pool_allocator& b) {
+    return a.pool_ == b.pool_;
+  }
+
+  friend bool operator!=(const node_pool_allocator& a,
+                         const node_pool_allocator& b) {
+    return !(a == b);
+  }
+
+ private:
+  template <class U>
+  friend class node_pool_allocator;
+
+  explicit node_pool_allocator(std::shared_ptr<Pool> pool)
+      : pool_(std::move(pool)) {}
+
+  // Only single objects that fit in a pool block are served by the pool. The
+  // decision depends only on `T` and `n`, so `deallocate` always agrees with
+  // the `allocate` call that produced the pointer.
+  bool UsesPool(size_type n) const {
+    return n == 1 && sizeof(T) <= pool_->node_size() &&
+           alignof(T) <= pool_->node_align();
+  }
+
+  std::shared_ptr<Pool> pool_;
+};
+
+}  // namespace absl
+
+#endif  // ABSL_CONTAINER_NODE_POOL_ALLOCATOR_H_
@@ -0,0 +1,165 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/node_pool_allocator.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/container/internal/node_pool.h"
+#include "absl/container/node_hash_map.h"
+#include "absl/container/node_hash_set.h"
+
+namespace absl {
+namespace container_internal {
+namespace {
+
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+using PoolMap = absl::node_hash_map<
+    int, std::string, hash_default_hash<int>, hash_default_eq<int>,
+    absl::node_pool_allocator<std::pair<const int, std::string>>>;
+using PoolSet = absl::node_hash_set<int64_t, hash_default_hash<int64_t>,
+                                    hash_default_eq<int64_t>,
+                                    absl::node_pool_allocator<int64_t>>;
+
+TEST(NodePool, AllocateDeallocate) {
+  NodePool pool(24, 8);
+  EXPECT_EQ(24, pool.node_size());
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 10000; ++i) {
+    void* p = pool.Allocate();
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(p) % 8);
+    ptrs.push_back(p);
+  }
+  EXPECT_EQ(10000, pool.live_nodes());
+  EXPECT_GT(pool.slab_count(), 1);
+  for (void* p : ptrs) pool.Deallocate(p);
+  EXPECT_EQ(0, pool.live_nodes());
+  // One empty slab is kept around.
+  EXPECT_EQ(1, pool.slab_count());
+}
+
+TEST(NodePool, SmallNodesHoldFreeListPointer) {
+  NodePool pool(1, 1);
+  EXPECT_GE(pool.node_size(), sizeof(void*));
+  void* a = pool.Allocate();
+  void* b = pool.Allocate();
+  EXPECT_NE(a, b);
+  pool.Deallocate(a);
+  EXPECT_EQ(a, pool.Allocate());
+  pool.Deallocate(a);
+  pool.Deallocate(b);
+}
+
+TEST(NodePool, ReleasesEmptySlabsOnly) {
+  NodePool pool(16, 8, 1024);
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 1000; ++i) ptrs.push_back(pool.Allocate());
+  const size_t slabs = pool.slab_count();
+  // Free every other block: no slab becomes empty.
+  for (size_t i = 0; i < ptrs.size(); i += 2) pool.Deallocate(ptrs[i]);
+  EXPECT_EQ(slabs, pool.slab_count());
+  // Freed blocks are reused before new slabs are created.
+  for (size_t i = 0; i < ptrs.size(); i += 2) ptrs[i] = pool.Allocate();
+  EXPECT_EQ(slabs, pool.slab_count());
+  for (void* p : ptrs) pool.Deallocate(p);
+  EXPECT_EQ(1, pool.slab_count());
+  EXPECT_LE(pool.bytes_reserved(), 1024);
+}
+
+TEST(NodePoolAllocator, NodeHashMap) {
+  PoolMap m;
+  std::vector<const std::string*> addrs;
+  for (int i = 0; i < 5000; ++i) {
+    addrs.push_back(&m.emplace(i, std::to_string(i)).first->second);
+  }
+  // Rehashing does not move nodes.
+  for (int i = 0; i < 5000; ++i) {
+    EXPECT_EQ(addrs[i], &m.find(i)->second);
+    EXPECT_EQ(std::to_string(i), m[i]);
+  }
+  const size_t slabs = m.get_allocator().slab_count();
+  EXPECT_GT(slabs, 1);
+  for (int i = 0; i < 5000; ++i) m.erase(i);
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(1, m.get_allocator().slab_count());
+}
+
+TEST(NodePoolAllocator, NodeHashSet) {
+  PoolSet s;
+  for (int64_t i = 0; i < 1000; ++i) s.insert(i);
+  EXPECT_EQ(1000, s.size());
+  for (int64_t i = 0; i < 1000; ++i) EXPECT_TRUE(s.contains(i));
+  s.clear();
+  EXPECT_EQ(1, s.get_allocator().slab_count());
+}
+
+TEST(NodePoolAllocator, CopyGetsOwnPool) {
+  PoolMap a = {{1, "a"}, {2, "b"}};
+  PoolMap b(a);
+  EXPECT_NE(a.get_allocator(), b.get_allocator());
+  b[3] = "c";
+  EXPECT_THAT(a, UnorderedElementsAre(Pair(1, "a"), Pair(2, "b")));
+  EXPECT_THAT(b,
+              UnorderedElementsAre(Pair(1, "a"), Pair(2, "b"), Pair(3, "c")));
+
+  PoolMap c;
+  c = a;
+  EXPECT_NE(a.get_allocator(), c.get_allocator());
+  EXPECT_THAT(c, UnorderedElementsAre(Pair(1, "a"), Pair(2, "b")));
+}
+
+TEST(NodePoolAllocator, MoveAndSwapCarryPool) {
+  PoolMap a = {{1, "a"}, {2, "b"}};
+  const std::string* addr = &a[1];
+  auto alloc = a.get_allocator();
+
+  PoolMap b(std::move(a));
+  EXPECT_EQ(alloc, b.get_allocator());
+  EXPECT_EQ(addr, &b[1]);
+  // The moved-from map is still usable.
+  a[5] = "e";
+  EXPECT_THAT(a, UnorderedElementsAre(Pair(5, "e")));
+
+  PoolMap c;
+  c = std::move(b);
+  EXPECT_EQ(alloc, c.get_allocator());
+  EXPECT_EQ(addr, &c[1]);
+
+  PoolMap d = {{7, "g"}};
+  c.swap(d);
+  EXPECT_EQ(alloc, d.get_allocator());
+  EXPECT_EQ(addr, &d[1]);
+  EXPECT_THAT(c, UnorderedElementsAre(Pair(7, "g")));
+}
+
+TEST(NodePoolAllocator, ArraysBypassPool) {
+  absl::node_pool_allocator<int> alloc;
+  int* p = alloc.allocate(100);
+  p[99] = 1;
+  EXPECT_EQ(0, alloc.slab_count());
+  alloc.deallocate(p, 100);
+  int* q = alloc.allocate(1);
+  EXPECT_EQ(1, alloc.slab_count());
+  alloc.deallocate(q, 1);
+}
+
+}  // namespace
+}  // namespace container_internal
+}  // namespace absl
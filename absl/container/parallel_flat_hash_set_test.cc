@@ -14,6 +14,8 @@
 
 #include "absl/container/parallel_flat_hash_set.h"
 
+#include <functional>
+#include <string>
 #include <vector>
 
 #include "absl/container/internal/hash_generator_testing.h"
@@ -121,6 +123,71 @@ TEST(ParallelFlatHashSet, MergeExtractInsert) {
   EXPECT_THAT(set2, UnorderedElementsAre(Pointee(7), Pointee(23)));
 }
 
+TEST(ParallelFlatHashSet, WithSubmap) {
+  parallel_flat_hash_set<int> set;
+  for (int i = 0; i < 1000; ++i) set.insert(i);
+  using P = parallel_flat_hash_set<int>;
+  size_t total = 0;
+  for (size_t idx = 0; idx < P::subcnt(); ++idx) {
+    set.with_submap(idx, [&](P::EmbeddedSet& submap) {
+      for (int v : submap) {
+        EXPECT_EQ(idx, P::subidx(set.hash_function()(v)));
+      }
+      total += submap.size();
+    });
+  }
+  EXPECT_EQ(1000, total);
+
+  const size_t hash = set.hash_function()(1000);
+  set.with_submap(P::subidx(hash), [&](P::EmbeddedSet& submap) {
+    EXPECT_TRUE(submap.find(1000, hash) == submap.end());
+    submap.emplace(1000);
+  });
+  EXPECT_TRUE(set.contains(1000));
+}
+
+TEST(ParallelFlatHashSet, LazyEmplace) {
+  parallel_flat_hash_set<std::string> set;
+  using Constructor =
+      parallel_flat_hash_set<std::string>::EmbeddedSet::constructor;
+  int constructed = 0;
+  for (int i = 0; i < 2; ++i) {
+    set.lazy_emplace(std::string("abc"), [&](const Constructor& ctor) {
+      ++constructed;
+      ctor("abc");
+    });
+  }
+  EXPECT_EQ(1, constructed);
+  EXPECT_THAT(set, UnorderedElementsAre("abc"));
+}
+
+TEST(ParallelFlatHashSet, HashedKey) {
+  parallel_flat_hash_set<std::string> set = {"status", "code"};
+  const absl::HashedKey<absl::string_view> status("status");
+  const absl::HashedKey<absl::string_view> missing("missing");
+  EXPECT_EQ("status", *set.find(status));
+  EXPECT_TRUE(set.find(missing) == set.end());
+  EXPECT_TRUE(set.contains(status));
+  EXPECT_FALSE(set.contains(missing));
+  EXPECT_EQ(1, set.count(status));
+  EXPECT_EQ(0, set.count(missing));
+}
+
+struct StdStringHash {
+  size_t operator()(const std::string& s) const {
+    return std::hash<std::string>()(s);
+  }
+};
+
+// Containers that do not hash with absl::Hash ignore the stored hash.
+TEST(ParallelFlatHashSet, HashedKeyWithOtherHash) {
+  parallel_flat_hash_set<std::string, StdStringHash> set = {"status"};
+  EXPECT_TRUE(set.contains(absl::HashedKey<std::string>("status")));
+  EXPECT_FALSE(set.contains(absl::HashedKey<std::string>("missing")));
+  parallel_flat_hash_set<std::string> strings = {"status"};
+  EXPECT_EQ("status", *strings.find(absl::HashedKey<const char*>("status")));
+}
+
 }  // namespace
 }  // namespace container_internal
 }  // namespace absl
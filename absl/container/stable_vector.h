@@ -0,0 +1,327 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: stable_vector.h
+// -----------------------------------------------------------------------------
+//
+// An `absl::StableVector<T>` is an append-only sequence whose elements never
+// move, designed for many threads appending concurrently while others read.
+//
+// Elements live in segments of geometrically increasing size: the first holds
+// `N` elements, the second `2 * N`, and so on. Segments are never reallocated,
+// so pointers and references to elements remain valid until the vector is
+// cleared or destroyed. Indexing computes the segment from the index with a
+// single bit scan.
+//
+// `push_back()` and `emplace_back()` may be called from any number of threads
+// without external locking. A slot is claimed with an atomic increment and the
+// element is constructed in place, concurrently with other appends. Readers may
+// call `size()` and `operator[]` concurrently with appends: every index below
+// `size()` refers to a fully constructed element.
+//
+// Publication is serialized in index order: an append does not return until
+// every append that claimed an earlier index has been published, so one slow
+// constructor stalls all appends that claimed a later index.
+//
+// Once an index is claimed, the append must complete, or every later append
+// would wait forever. Elements whose constructor may throw are therefore
+// constructed before an index is claimed and then moved into place, which
+// requires `T` to be nothrow move constructible. Failing to allocate a segment
+// after claiming an index terminates the program.
+//
+// `reserve()` is thread-safe as well; `clear()` and the destructor are not.
+//
+// Example:
+//
+//   absl::StableVector<Event> events;
+//
+//   // On any thread:
+//   size_t index = events.push_back(event);
+//
+//   // On any other thread:
+//   for (size_t i = 0; i < events.size(); ++i) Process(events[i]);
+
+#ifndef ABSL_CONTAINER_STABLE_VECTOR_H_
+#define ABSL_CONTAINER_STABLE_VECTOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <thread>  // NOLINT(build/c++11)
+#include <type_traits>
+#include <utility>
+
+#include "absl/base/internal/bits.h"
+#include "absl/base/internal/throw_delegate.h"
+#include "absl/base/optimization.h"
+
+namespace absl {
+
+template <class T, size_t N = 16>
+class StableVector {
+  static_assert(N > 0 && (N & (N - 1)) == 0,
+                "the first segment size must be a power of two");
+
+  static constexpr int Log2(size_t n) { return n <= 1 ? 0 : 1 + Log2(n / 2); }
+  static constexpr int kLog2N = Log2(N);
+  // Enough segments to address every `size_t` index.
+  static constexpr int kMaxSegments = 64 - kLog2N;
+
+  template <bool kConst>
+  class Iter {
+    using Vec = typename std::conditional<kConst, const StableVector,
+                                          StableVector>::type;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using reference = typename std::conditional<kConst, const T&, T&>::type;
+    using pointer = typename std::conditional<kConst, const T*, T*>::type;
+    using difference_type = ptrdiff_t;
+
+    Iter() = default;
+    template <bool C = kConst, typename std::enable_if<C, int>::type = 0>
+    Iter(const Iter<false>& it) : vec_(it.vec_), i_(it.i_) {}  // NOLINT
+
+    reference operator*() const { return (*vec_)[i_]; }
+    pointer operator->() const { return &(*vec_)[i_]; }
+    reference operator[](difference_type n) const { return (*vec_)[i_ + n]; }
+
+    Iter& operator++() {
+      ++i_;
+      return *this;
+    }
+    Iter operator++(int) { return Iter(vec_, i_++); }
+    Iter& operator--() {
+      --i_;
+      return *this;
+    }
+    Iter operator--(int) { return Iter(vec_, i_--); }
+    Iter& operator+=(difference_type n) {
+      i_ += n;
+      return *this;
+    }
+    Iter& operator-=(difference_type n) {
+      i_ -= n;
+      return *this;
+    }
+    friend Iter operator+(Iter it, difference_type n) { return it += n; }
+    friend Iter operator+(difference_type n, Iter it) { return it += n; }
+    friend Iter operator-(Iter it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const Iter& a, const Iter& b) {
+      return static_cast<difference_type>(a.i_ - b.i_);
+    }
+
+    friend bool operator==(const Iter& a, const Iter& b) {
+      return a.i_ == b.i_;
+    }
+    friend bool operator!=(const Iter& a, const Iter& b) {
+      return a.i_ != b.i_;
+    }
+    friend bool operator<(const Iter& a, const Iter& b) { return a.i_ < b.i_; }
+    friend bool operator>(const Iter& a, const Iter& b) { return a.i_ > b.i_; }
+    friend bool operator<=(const Iter& a, const Iter& b) {
+      return a.i_ <= b.i_;
+    }
+    friend bool operator>=(const Iter& a, const Iter& b) {
+      return a.i_ >= b.i_;
+    }
+
+   private:
+    friend class StableVector;
+    friend class Iter<true>;
+    Iter(Vec* vec, size_t i) : vec_(vec), i_(i) {}
+
+    Vec* vec_ = nullptr;
+    size_t i_ = 0;
+  };
+
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = Iter<false>;
+  using const_iterator = Iter<true>;
+
+  StableVector() : segments_() {}
+  StableVector(const StableVector&) = delete;
+  StableVector& operator=(const StableVector&) = delete;
+  ~StableVector() { clear(); }
+
+  // Appends an element constructed from `args` and returns its index.
+  // Thread-safe. If constructing the element may throw, it is constructed
+  // before claiming an index and then moved into place.
+  template <class... Args>
+  size_t emplace_back(Args&&... args) {
+    return EmplaceBack(std::is_nothrow_constructible<T, Args&&...>(),
+                       std::forward<Args>(args)...);
+  }
+
+  // Appends `v` and returns its index. Thread-safe.
+  size_t push_back(const T& v) { return emplace_back(v); }
+  size_t push_back(T&& v) { return emplace_back(std::move(v)); }
+
+  // Number of elements whose construction has completed and been published.
+  // Thread-safe.
+  size_t size() const { return size_.load(std::memory_order_acquire); }
+  bool empty() const { return size() == 0; }
+
+  // Number of elements that fit in the segments allocated so far.
+  size_t capacity() const {
+    size_t n = 0;
+    // Racing appends may allocate a later segment before an earlier one.
+    for (int k = 0; k < kMaxSegments; ++k) {
+      if (segments_[k].load(std::memory_order_relaxed) != nullptr) {
+        n += SegmentSize(k);
+      }
+    }
+    return n;
+  }
+
+  // Allocates the segments needed to hold `n` elements. Thread-safe.
+  void reserve(size_t n) {
+    if (n == 0) return;
+    const int last = SegmentOf(n - 1);
+    for (int k = 0; k <= last; ++k) Segment(k);
+  }
+
+  // Element access. `i` must be below a value returned by `size()`, or an
+  // index returned by `push_back()` on a thread that synchronized with it.
+  T& operator[](size_t i) { return *Address(i); }
+  const T& operator[](size_t i) const { return *Address(i); }
+
+  T& at(size_t i) {
+    if (i >= size()) base_internal::ThrowStdOutOfRange("StableVector::at");
+    return (*this)[i];
+  }
+  const T& at(size_t i) const {
+    if (i >= size()) base_internal::ThrowStdOutOfRange("StableVector::at");
+    return (*this)[i];
+  }
+
+  T& front() { return (*this)[0]; }
+  const T& front() const { return (*this)[0]; }
+  T& back() { return (*this)[size() - 1]; }
+  const T& back() const { return (*this)[size() - 1]; }
+
+  // Iterators cover the elements published when `end()` is called.
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, size()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size()); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  // Destroys all elements and frees all segments. Not thread-safe.
+  void clear() {
+    const size_t n = size_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < n; ++i) Address(i)->~T();
+    for (int k = 0; k < kMaxSegments; ++k) {
+      T* seg = segments_[k].exchange(nullptr, std::memory_order_relaxed);
+      if (seg != nullptr) std::allocator<T>().deallocate(seg, SegmentSize(k));
+    }
+    claimed_.store(0, std::memory_order_relaxed);
+    size_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr size_t SegmentSize(int k) { return N << k; }
+
+  // Segment `k` holds indices `[N * (2^k - 1), N * (2^(k+1) - 1))`, i.e. the
+  // indices `i` for which `i + N` has its highest bit at position
+  // `k + log2(N)`.
+  static int SegmentOf(size_t i) {
+    const int k =
+        63 - base_internal::CountLeadingZeros64(uint64_t{i} + N) - kLog2N;
+    // `i + N >= N`, so `k` cannot be negative; telling the compiler so keeps
+    // it from warning about out-of-bounds `segments_` accesses.
+    ABSL_ASSUME(k >= 0 && k < kMaxSegments);
+    return k;
+  }
+
+  T* Address(size_t i) const {
+    const int k = SegmentOf(i);
+    const size_t offset = i + N - SegmentSize(k);
+    return segments_[k].load(std::memory_order_acquire) + offset;
+  }
+
+  // Constructs the element in place. Nothing may throw once the index is
+  // claimed, so a failed segment allocation terminates.
+  template <class... Args>
+  size_t EmplaceBack(std::true_type, Args&&... args) noexcept {
+    const size_t i = claimed_.fetch_add(1, std::memory_order_relaxed);
+    ::new (static_cast<void*>(Slot(i))) T(std::forward<Args>(args)...);
+    Publish(i);
+    return i;
+  }
+
+  template <class... Args>
+  size_t EmplaceBack(std::false_type, Args&&... args) {
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+                  "StableVector requires elements to be nothrow constructible "
+                  "from the arguments or nothrow move constructible");
+    T element(std::forward<Args>(args)...);
+    return EmplaceBack(std::true_type(), std::move(element));
+  }
+
+  // Returns the storage for index `i`, allocating its segment if needed.
+  T* Slot(size_t i) {
+    const int k = SegmentOf(i);
+    return Segment(k) + (i + N - SegmentSize(k));
+  }
+
+  // Returns segment `k`, allocating it if needed. When several threads race to
+  // allocate the same segment, one wins and the others free their copy.
+  T* Segment(int k) {
+    T* seg = segments_[k].load(std::memory_order_acquire);
+    if (seg != nullptr) return seg;
+    T* fresh = std::allocator<T>().allocate(SegmentSize(k));
+    if (segments_[k].compare_exchange_strong(seg, fresh,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+      return fresh;
+    }
+    std::allocator<T>().deallocate(fresh, SegmentSize(k));
+    return seg;
+  }
+
+  // Makes element `i` visible to readers once all earlier elements are.
+  void Publish(size_t i) {
+    for (int spins = 0; size_.load(std::memory_order_acquire) != i; ++spins) {
+      if (spins > 64) std::this_thread::yield();
+    }
+    size_.store(i + 1, std::memory_order_release);
+  }
+
+  std::atomic<T*> segments_[kMaxSegments];
+  std::atomic<size_t> claimed_{0};
+  std::atomic<size_t> size_{0};
+};
+
+template <class T, size_t N>
+constexpr int StableVector<T, N>::kLog2N;
+template <class T, size_t N>
+constexpr int StableVector<T, N>::kMaxSegments;
+
+}  // namespace absl
+
+#endif  // ABSL_CONTAINER_STABLE_VECTOR_H_
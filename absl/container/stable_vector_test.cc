@@ -0,0 +1,203 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/stable_vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/container/internal/test_instance_tracker.h"
+
+namespace absl {
+namespace container_internal {
+namespace {
+
+using ::absl::test_internal::CopyableMovableInstance;
+using ::absl::test_internal::InstanceTracker;
+using ::testing::ElementsAre;
+
+TEST(StableVector, Empty) {
+  StableVector<int> v;
+  EXPECT_TRUE(v.empty());
+  EXPECT_EQ(0, v.size());
+  EXPECT_EQ(0, v.capacity());
+  EXPECT_EQ(v.begin(), v.end());
+}
+
+TEST(StableVector, PushBackAndIndex) {
+  StableVector<std::string, 4> v;
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, v.push_back(std::to_string(i)));
+  }
+  EXPECT_EQ(100, v.size());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(std::to_string(i), v[i]);
+    EXPECT_EQ(std::to_string(i), v.at(i));
+  }
+  EXPECT_EQ("0", v.front());
+  EXPECT_EQ("99", v.back());
+  EXPECT_EQ(100, v.emplace_back(3, 'x'));
+  EXPECT_EQ("xxx", v.back());
+#ifdef ABSL_HAVE_EXCEPTIONS
+  EXPECT_THROW(v.at(101), std::out_of_range);
+#endif
+}
+
+TEST(StableVector, AddressesAreStable) {
+  StableVector<int, 2> v;
+  std::vector<const int*> addresses;
+  for (int i = 0; i < 1000; ++i) {
+    v.push_back(i);
+    addresses.push_back(&v[i]);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(addresses[i], &v[i]);
+    EXPECT_EQ(i, *addresses[i]);
+  }
+}
+
+TEST(StableVector, SegmentsGrowGeometrically) {
+  StableVector<int, 4> v;
+  v.push_back(0);
+  EXPECT_EQ(4, v.capacity());
+  for (int i = 1; i < 5; ++i) v.push_back(i);
+  EXPECT_EQ(4 + 8, v.capacity());
+  v.reserve(100);
+  // 4 + 8 + 16 + 32 + 64
+  EXPECT_EQ(124, v.capacity());
+  EXPECT_EQ(5, v.size());
+}
+
+TEST(StableVector, Iterators) {
+  StableVector<int, 2> v;
+  for (int i = 0; i < 10; ++i) v.push_back(i);
+  EXPECT_EQ(45, std::accumulate(v.begin(), v.end(), 0));
+  EXPECT_EQ(10, v.end() - v.begin());
+  EXPECT_EQ(7, v.begin()[7]);
+  EXPECT_EQ(9, *(v.end() - 1));
+
+  const StableVector<int, 2>& cv = v;
+  StableVector<int, 2>::const_iterator it = v.begin();
+  EXPECT_EQ(cv.begin(), it);
+  EXPECT_TRUE(it < cv.end());
+  std::vector<int> copy(cv.begin(), cv.end());
+  EXPECT_THAT(copy, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+
+  for (int& x : v) x *= 2;
+  EXPECT_EQ(18, v[9]);
+  EXPECT_EQ(v.end(), std::find(v.begin(), v.end(), 5));
+}
+
+// A tracked instance that can be constructed in place.
+class NothrowInstance : public CopyableMovableInstance {
+ public:
+  explicit NothrowInstance(int x) noexcept : CopyableMovableInstance(x) {}
+  NothrowInstance(NothrowInstance&& that) noexcept
+      : CopyableMovableInstance(std::move(that)) {}
+};
+
+TEST(StableVector, DestroysElements) {
+  InstanceTracker tracker;
+  {
+    StableVector<NothrowInstance, 2> v;
+    for (int i = 0; i < 50; ++i) v.emplace_back(i);
+    EXPECT_EQ(50, tracker.instances());
+    EXPECT_EQ(0, tracker.copies());
+    EXPECT_EQ(0, tracker.moves());
+    v.clear();
+    EXPECT_EQ(0, tracker.instances());
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(0, v.capacity());
+    v.push_back(NothrowInstance(1));
+    EXPECT_EQ(1, v[0].value());
+  }
+  EXPECT_EQ(0, tracker.instances());
+}
+
+#ifdef ABSL_HAVE_EXCEPTIONS
+// Throws from the constructor when given a negative value.
+struct ThrowingCtor {
+  explicit ThrowingCtor(int x) : value(x) {
+    if (x < 0) throw std::invalid_argument("negative");
+  }
+  ThrowingCtor(ThrowingCtor&& that) noexcept : value(that.value) {}
+  int value;
+};
+
+TEST(StableVector, ThrowingConstructorClaimsNoIndex) {
+  StableVector<ThrowingCtor, 2> v;
+  EXPECT_EQ(0, v.emplace_back(1));
+  EXPECT_THROW(v.emplace_back(-1), std::invalid_argument);
+  // A claimed but unpublished index would make this wait forever.
+  EXPECT_EQ(1, v.emplace_back(2));
+  EXPECT_EQ(2, v.size());
+  EXPECT_EQ(2, v[1].value);
+}
+#endif  // ABSL_HAVE_EXCEPTIONS
+
+TEST(StableVector, ConcurrentAppend) {
+  constexpr int kThreads = 8;
+  constexpr int kPerThread = 20000;
+  StableVector<std::unique_ptr<int>> v;
+  std::atomic<bool> done{false};
+
+  // A reader checks that every published element is fully constructed.
+  std::thread reader([&] {
+    size_t checked = 0;
+    while (!done.load(std::memory_order_acquire) || checked < v.size()) {
+      const size_t n = v.size();
+      for (; checked < n; ++checked) {
+        ASSERT_NE(nullptr, v[checked]);
+        ASSERT_LT(*v[checked], kThreads * kPerThread);
+      }
+    }
+  });
+
+  std::vector<std::thread> writers;
+  std::vector<std::vector<size_t>> indices(kThreads);
+  for (int t = 0; t < kThreads; ++t) {
+    writers.emplace_back([&, t] {
+      for (int i = 0; i < kPerThread; ++i) {
+        const int value = t * kPerThread + i;
+        indices[t].push_back(v.push_back(std::unique_ptr<int>(new int(value))));
+      }
+    });
+  }
+  for (std::thread& w : writers) w.join();
+  done.store(true, std::memory_order_release);
+  reader.join();
+
+  ASSERT_EQ(kThreads * kPerThread, v.size());
+  std::vector<bool> seen(kThreads * kPerThread);
+  for (int t = 0; t < kThreads; ++t) {
+    for (int i = 0; i < kPerThread; ++i) {
+      const int value = *v[indices[t][i]];
+      EXPECT_EQ(t * kPerThread + i, value);
+      seen[value] = true;
+    }
+  }
+  EXPECT_EQ(seen.end(), std::find(seen.begin(), seen.end(), false));
+}
+
+}  // namespace
+}  // namespace container_internal
+}  // namespace absl
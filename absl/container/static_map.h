@@ -0,0 +1,343 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: static_map.h
+// -----------------------------------------------------------------------------
+//
+// An `absl::StaticMap<V, N>` is an immutable map from `N` string keys to values
+// of type `V`, built from a literal list of entries. It is meant for constant
+// tables that are looked up often, such as protocol field names or command
+// names mapped to IDs.
+//
+// The map is laid out as a perfect hash table: construction picks, for every
+// small group of keys, a seed under which all keys land in distinct slots. A
+// lookup hashes the key once, reads that group's seed and compares the key in a
+// single slot; there is no probing and no chain to follow.
+//
+// In C++14 and later the table is computed by the compiler, so a `constexpr`
+// `StaticMap` has no startup cost and lives in read-only memory:
+//
+//   constexpr auto kFields = absl::MakeStaticMap<int>({
+//       {"id", 1},
+//       {"name", 2},
+//       {"email", 3},
+//   });
+//
+//   if (const auto* field = kFields.find(name)) {
+//     Handle(field->second);
+//   }
+//
+// In C++11 the same code builds the table at runtime (declare the map `const`
+// instead of `constexpr`).
+//
+// Keys are `absl::string_view`s and must outlive the map; string literals are
+// the common case. Lookups accept anything convertible to `absl::string_view`,
+// such as `std::string` or `const char*`, without creating temporaries. `V`
+// must be a literal type that is default constructible and copy assignable.
+//
+// Duplicate keys are an error: in a constant expression they fail to compile,
+// otherwise construction throws `std::invalid_argument`.
+
+#ifndef ABSL_CONTAINER_STATIC_MAP_H_
+#define ABSL_CONTAINER_STATIC_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+#include "absl/base/internal/throw_delegate.h"
+#include "absl/strings/string_view.h"
+
+// Building the table needs loops in constexpr functions, which requires C++14.
+#if __cpp_constexpr >= 201304 || (defined(_MSC_VER) && _MSC_VER >= 1910)
+#define ABSL_INTERNAL_STATIC_MAP_CONSTEXPR constexpr
+#else
+#define ABSL_INTERNAL_STATIC_MAP_CONSTEXPR
+#endif
+
+namespace absl {
+namespace container_internal {
+
+constexpr size_t StaticMapNextPow2(size_t n, size_t p = 1) {
+  return p >= n ? p : StaticMapNextPow2(n, p * 2);
+}
+
+constexpr int StaticMapLog2(size_t n) {
+  return n <= 1 ? 0 : 1 + StaticMapLog2(n / 2);
+}
+
+// Number of slots for `n` keys: a power of two with a load factor of at most
+// 3/4, which keeps the seed search short.
+constexpr size_t StaticMapCapacity(size_t n) {
+  return StaticMapNextPow2(n) * (n * 4 > StaticMapNextPow2(n) * 3 ? 2 : 1);
+}
+
+// Number of seed groups for `n` keys, about four keys per group.
+constexpr size_t StaticMapBuckets(size_t n) {
+  return StaticMapNextPow2((n + 3) / 4);
+}
+
+constexpr uint64_t StaticMapMix(uint64_t x) {
+  return (x ^ (x >> 31)) * uint64_t{0x9E3779B97F4A7C15};
+}
+
+// Reads up to 8 bytes as a little-endian word. Written byte by byte so that it
+// can be evaluated at compile time; compilers fuse it into a single load.
+constexpr uint64_t StaticMapLoad(const char* p, size_t len) {
+  return len == 0 ? 0
+                  : static_cast<uint64_t>(static_cast<unsigned char>(p[0])) |
+                        (StaticMapLoad(p + 1, len - 1) << 8);
+}
+
+constexpr uint64_t StaticMapHashImpl(const char* p, size_t len, uint64_t h) {
+  return len <= 8 ? StaticMapMix(StaticMapMix(h ^ StaticMapLoad(p, len)))
+                  : StaticMapHashImpl(p + 8, len - 8,
+                                      StaticMapMix(h ^ StaticMapLoad(p, 8)));
+}
+
+// The hash used to place keys. Usable in constant expressions.
+constexpr uint64_t StaticMapHash(absl::string_view key) {
+  return StaticMapHashImpl(key.data(), key.size(),
+                           uint64_t{0xC6A4A7935BD1E995} ^ key.size());
+}
+
+// Final slot of a key with hash `hash` in a group with seed `seed`.
+constexpr size_t StaticMapSlot(uint64_t hash, uint32_t seed,
+                               int log2_capacity) {
+  return static_cast<size_t>(
+      StaticMapMix(StaticMapMix(hash + seed * uint64_t{0xBF58476D1CE4E5B9})) >>
+      (64 - log2_capacity));
+}
+
+constexpr bool StaticMapKeyEq(absl::string_view a, absl::string_view b,
+                              size_t i = 0) {
+  return a.size() != b.size()
+             ? false
+             : i == a.size() ? true
+                             : a[i] == b[i] && StaticMapKeyEq(a, b, i + 1);
+}
+
+}  // namespace container_internal
+
+// -----------------------------------------------------------------------------
+// absl::StaticMap
+// -----------------------------------------------------------------------------
+//
+// An immutable perfect hash map from `N` string keys to values of type `V`.
+// Create one with `absl::MakeStaticMap()`, see above.
+template <class V, size_t N>
+class StaticMap {
+  static_assert(N > 0, "StaticMap needs at least one entry");
+  static_assert(N < (size_t{1} << 31), "too many entries");
+
+ public:
+  struct value_type {
+    constexpr value_type() : first(), second() {}
+
+    absl::string_view first;
+    V second;
+  };
+  using key_type = absl::string_view;
+  using mapped_type = V;
+  using size_type = size_t;
+
+  static constexpr size_t kCapacity = container_internal::StaticMapCapacity(N);
+  static constexpr size_t kBuckets = container_internal::StaticMapBuckets(N);
+
+  // Iterates over the entries in the order they were given.
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename StaticMap::value_type;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using difference_type = ptrdiff_t;
+
+    const_iterator() = default;
+
+    reference operator*() const { return map_->slots_[map_->order_[i_]]; }
+    pointer operator->() const { return &**this; }
+    const_iterator& operator++() {
+      ++i_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto tmp = *this;
+      ++i_;
+      return tmp;
+    }
+
+    friend bool operator==(const const_iterator& a, const const_iterator& b) {
+      return a.i_ == b.i_;
+    }
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) {
+      return a.i_ != b.i_;
+    }
+
+   private:
+    friend class StaticMap;
+    const_iterator(const StaticMap* map, size_t i) : map_(map), i_(i) {}
+
+    const StaticMap* map_ = nullptr;
+    size_t i_ = 0;
+  };
+  using iterator = const_iterator;
+
+  ABSL_INTERNAL_STATIC_MAP_CONSTEXPR explicit StaticMap(
+      const std::pair<absl::string_view, V> (&entries)[N])
+      : slots_(), seeds_(), order_() {
+    uint64_t hashes[N] = {};
+    size_t bucket_size[kBuckets] = {};
+    size_t max_bucket_size = 0;
+    for (size_t i = 0; i != N; ++i) {
+      hashes[i] = container_internal::StaticMapHash(entries[i].first);
+      const size_t b = hashes[i] & (kBuckets - 1);
+      if (++bucket_size[b] > max_bucket_size) max_bucket_size = bucket_size[b];
+    }
+
+    // Place the largest groups first, while the table is mostly empty.
+    bool used[kCapacity] = {};
+    for (size_t size = max_bucket_size; size != 0; --size) {
+      for (size_t b = 0; b != kBuckets; ++b) {
+        if (bucket_size[b] == size) PlaceBucket(entries, hashes, b, used);
+      }
+    }
+
+    // Empty slots hold a copy of some key that lives in a different slot.
+    // Looking that key up never lands on an empty slot, so empty slots never
+    // match.
+    for (size_t s = 0; s != kCapacity; ++s) {
+      if (!used[s]) {
+        slots_[s].first = entries[0].first;
+        slots_[s].second = entries[0].second;
+      }
+    }
+  }
+
+  // Returns the entry with key `key`, or nullptr if there is none.
+  const value_type* find(absl::string_view key) const {
+    const value_type& slot = slots_[SlotFor(key)];
+    return slot.first == key ? &slot : nullptr;
+  }
+
+  // Same as `find()`, usable in constant expressions (C++14).
+  ABSL_INTERNAL_STATIC_MAP_CONSTEXPR const value_type* constexpr_find(
+      absl::string_view key) const {
+    return container_internal::StaticMapKeyEq(slots_[SlotFor(key)].first, key)
+               ? &slots_[SlotFor(key)]
+               : nullptr;
+  }
+
+  bool contains(absl::string_view key) const { return find(key) != nullptr; }
+  size_t count(absl::string_view key) const { return contains(key) ? 1 : 0; }
+
+  // Returns the value for `key`. Throws `std::out_of_range` if there is none.
+  const V& at(absl::string_view key) const {
+    const value_type* entry = find(key);
+    if (entry == nullptr) {
+      base_internal::ThrowStdOutOfRange("absl::StaticMap::at");
+    }
+    return entry->second;
+  }
+
+  constexpr size_t size() const { return N; }
+  constexpr bool empty() const { return false; }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, N); }
+
+ private:
+  static constexpr int kLog2Capacity =
+      container_internal::StaticMapLog2(kCapacity);
+
+  constexpr size_t SlotFor(absl::string_view key) const {
+    return SlotFor(container_internal::StaticMapHash(key));
+  }
+  constexpr size_t SlotFor(uint64_t hash) const {
+    return container_internal::StaticMapSlot(
+        hash, seeds_[hash & (kBuckets - 1)], kLog2Capacity);
+  }
+
+  // Finds a seed under which every key of bucket `b` lands in a free slot and
+  // claims those slots.
+  ABSL_INTERNAL_STATIC_MAP_CONSTEXPR void PlaceBucket(
+      const std::pair<absl::string_view, V> (&entries)[N],
+      const uint64_t (&hashes)[N], size_t b, bool (&used)[kCapacity]) {
+    size_t members[N] = {};
+    size_t k = 0;
+    for (size_t i = 0; i != N; ++i) {
+      if ((hashes[i] & (kBuckets - 1)) == b) members[k++] = i;
+    }
+    for (size_t i = 0; i != k; ++i) {
+      for (size_t j = 0; j != i; ++j) {
+        if (hashes[members[i]] == hashes[members[j]] &&
+            container_internal::StaticMapKeyEq(entries[members[i]].first,
+                                               entries[members[j]].first)) {
+          base_internal::ThrowStdInvalidArgument(
+              "absl::StaticMap: duplicate key");
+        }
+      }
+    }
+
+    constexpr uint32_t kMaxSeed = uint32_t{1} << 20;
+    for (uint32_t seed = 0; seed != kMaxSeed; ++seed) {
+      size_t slots[N] = {};
+      bool ok = true;
+      for (size_t i = 0; ok && i != k; ++i) {
+        slots[i] = container_internal::StaticMapSlot(hashes[members[i]], seed,
+                                                     kLog2Capacity);
+        if (used[slots[i]]) ok = false;
+        for (size_t j = 0; ok && j != i; ++j) {
+          if (slots[j] == slots[i]) ok = false;
+        }
+      }
+      if (!ok) continue;
+      seeds_[b] = seed;
+      for (size_t i = 0; i != k; ++i) {
+        used[slots[i]] = true;
+        slots_[slots[i]].first = entries[members[i]].first;
+        slots_[slots[i]].second = entries[members[i]].second;
+        order_[members[i]] = static_cast<uint32_t>(slots[i]);
+      }
+      return;
+    }
+    base_internal::ThrowStdLogicError("absl::StaticMap: no perfect hash found");
+  }
+
+  value_type slots_[kCapacity];
+  uint32_t seeds_[kBuckets];
+  uint32_t order_[N];  // slot of the i-th entry, for iteration
+};
+
+template <class V, size_t N>
+constexpr size_t StaticMap<V, N>::kCapacity;
+template <class V, size_t N>
+constexpr size_t StaticMap<V, N>::kBuckets;
+template <class V, size_t N>
+constexpr int StaticMap<V, N>::kLog2Capacity;
+
+// Creates a `StaticMap` from a braced list of entries:
+//
+//   constexpr auto kMap = absl::MakeStaticMap<int>({{"a", 1}, {"b", 2}});
+template <class V, size_t N>
+ABSL_INTERNAL_STATIC_MAP_CONSTEXPR StaticMap<V, N> MakeStaticMap(
+    const std::pair<absl::string_view, V> (&entries)[N]) {
+  return StaticMap<V, N>(entries);
+}
+
+}  // namespace absl
+
+#endif  // ABSL_CONTAINER_STATIC_MAP_H_
@@ -0,0 +1,136 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/static_map.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace absl {
+namespace container_internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+#if __cpp_constexpr >= 201304
+#define ABSL_STATIC_MAP_TEST_CONSTEXPR constexpr
+#else
+#define ABSL_STATIC_MAP_TEST_CONSTEXPR const
+#endif
+
+ABSL_STATIC_MAP_TEST_CONSTEXPR auto kColors = absl::MakeStaticMap<int>({
+    {"red", 1},
+    {"green", 2},
+    {"blue", 3},
+    {"cyan", 4},
+    {"magenta", 5},
+    {"yellow", 6},
+    {"black", 7},
+    {"a much longer key that spans several words", 8},
+});
+
+#if __cpp_constexpr >= 201304
+static_assert(kColors.size() == 8, "");
+static_assert(kColors.constexpr_find("blue")->second == 3, "");
+static_assert(kColors.constexpr_find("magenta")->second == 5, "");
+static_assert(kColors.constexpr_find("purple") == nullptr, "");
+static_assert(kColors.constexpr_find("") == nullptr, "");
+#endif
+
+TEST(StaticMap, Find) {
+  EXPECT_EQ(1, kColors.find("red")->second);
+  EXPECT_EQ(7, kColors.find("black")->second);
+  EXPECT_EQ(8,
+            kColors.find("a much longer key that spans several words")->second);
+  EXPECT_EQ(nullptr, kColors.find("purple"));
+  EXPECT_EQ(nullptr, kColors.find(""));
+  EXPECT_EQ(nullptr, kColors.find("re"));
+  EXPECT_EQ(nullptr, kColors.find("redd"));
+}
+
+TEST(StaticMap, HeterogeneousLookup) {
+  std::string key = "cyan";
+  EXPECT_EQ(4, kColors.find(key)->second);
+  EXPECT_TRUE(kColors.contains(key));
+  const char* cstr = "yellow";
+  EXPECT_EQ(6, kColors.at(cstr));
+  EXPECT_EQ(1, kColors.count(absl::string_view("green")));
+  EXPECT_EQ(0, kColors.count("white"));
+}
+
+TEST(StaticMap, At) {
+  EXPECT_EQ(2, kColors.at("green"));
+#ifdef ABSL_HAVE_EXCEPTIONS
+  EXPECT_THROW(kColors.at("white"), std::out_of_range);
+#endif
+}
+
+TEST(StaticMap, IteratesInDeclarationOrder) {
+  std::vector<std::pair<std::string, int>> entries;
+  for (const auto& e : kColors) {
+    entries.emplace_back(std::string(e.first), e.second);
+  }
+  EXPECT_THAT(entries,
+              ElementsAre(Pair("red", 1), Pair("green", 2), Pair("blue", 3),
+                          Pair("cyan", 4), Pair("magenta", 5),
+                          Pair("yellow", 6), Pair("black", 7),
+                          Pair("a much longer key that spans several words",
+                               8)));
+}
+
+TEST(StaticMap, SingleEntry) {
+  const auto m = absl::MakeStaticMap<std::nullptr_t>({{"only", nullptr}});
+  EXPECT_EQ(1, m.size());
+  EXPECT_TRUE(m.contains("only"));
+  EXPECT_FALSE(m.contains("other"));
+  EXPECT_FALSE(m.contains(""));
+}
+
+TEST(StaticMap, EmptyKey) {
+  const auto m = absl::MakeStaticMap<int>({{"", 1}, {"x", 2}});
+  EXPECT_EQ(1, m.at(""));
+  EXPECT_EQ(2, m.at("x"));
+  EXPECT_FALSE(m.contains("y"));
+}
+
+TEST(StaticMap, ManyKeys) {
+  std::vector<std::string> keys;
+  for (int i = 0; i < 1000; ++i) keys.push_back("key" + std::to_string(i));
+  std::pair<absl::string_view, int> entries[1000];
+  for (int i = 0; i < 1000; ++i) entries[i] = {keys[i], i};
+  const StaticMap<int, 1000> m(entries);
+  for (int i = 0; i < 1000; ++i) EXPECT_EQ(i, m.at(keys[i]));
+  for (int i = 1000; i < 2000; ++i) {
+    EXPECT_FALSE(m.contains("key" + std::to_string(i)));
+  }
+  int expected = 0;
+  for (const auto& e : m) EXPECT_EQ(expected++, e.second);
+}
+
+#ifdef ABSL_HAVE_EXCEPTIONS
+TEST(StaticMap, DuplicateKeyThrows) {
+  EXPECT_THROW(absl::MakeStaticMap<int>({{"a", 1}, {"b", 2}, {"a", 3}}),
+               std::invalid_argument);
+}
+#endif
+
+}  // namespace
+}  // namespace container_internal
+}  // namespace absl
@@ -0,0 +1,126 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/string_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "absl/container/fixed_array.h"
+#include "absl/hash/hash.h"
+
+namespace absl {
+
+namespace {
+
+// Arena chunks start small, so that pools with few strings stay small, and
+// double up to kMaxChunkSize. Strings larger than a quarter of that get a
+// chunk of their own.
+constexpr size_t kMinChunkSize = 1024;
+constexpr size_t kMaxChunkSize = 64 * 1024;
+
+}  // namespace
+
+constexpr size_t StringPool::kSubmaps;
+
+char* StringPool::Arena::Allocate(size_t n) {
+  if (n > left) {
+    if (n > kMaxChunkSize / 4) {
+      chunks.emplace_back(new char[n]);
+      bytes += n;
+      return chunks.back().get();
+    }
+    const size_t size = std::max(next_chunk_size, kMinChunkSize);
+    next_chunk_size = std::min(2 * size, kMaxChunkSize);
+    chunks.emplace_back(new char[size]);
+    bytes += size;
+    next = chunks.back().get();
+    left = size;
+  }
+  char* p = next;
+  next += n;
+  left -= n;
+  return p;
+}
+
+absl::string_view StringPool::InternLocked(Set::EmbeddedSet* set, Arena* arena,
+                                           absl::string_view s, size_t hash) {
+  if (s.empty()) return absl::string_view();
+  auto it = set->lazy_emplace_with_hash(
+      s, hash, [&](const Set::EmbeddedSet::constructor& ctor) {
+        char* p = arena->Allocate(s.size());
+        std::memcpy(p, s.data(), s.size());
+        ctor(p, s.size());
+      });
+  return *it;
+}
+
+absl::string_view StringPool::Intern(absl::string_view s) {
+  if (s.empty()) return absl::string_view();
+  size_t hash = set_.hash_function()(s);
+  const size_t idx = Set::subidx(hash);
+  absl::string_view result;
+  set_.with_submap(idx, [&](Set::EmbeddedSet& set) {
+    result = InternLocked(&set, &arenas_[idx], s, hash);
+  });
+  return result;
+}
+
+void StringPool::Intern(absl::Span<const absl::string_view> strings,
+                        absl::Span<absl::string_view> out) {
+  assert(strings.size() == out.size());
+  const size_t n = strings.size();
+
+  // Counting sort of the indices by submap: the indices of submap `s` end up
+  // in `order[begin[s], begin[s + 1])`.
+  absl::FixedArray<size_t, 256> hashes(n);
+  absl::FixedArray<size_t, 256> order(n);
+  size_t begin[kSubmaps + 1] = {};
+  // `Set` hashes with `absl::Hash<absl::string_view>`, as `HashMany` does.
+  absl::HashMany(strings, absl::MakeSpan(hashes.data(), n));
+  for (size_t i = 0; i < n; ++i) ++begin[Set::subidx(hashes[i]) + 1];
+  for (size_t s = 0; s < kSubmaps; ++s) begin[s + 1] += begin[s];
+  size_t fill[kSubmaps];
+  std::copy(begin, begin + kSubmaps, fill);
+  for (size_t i = 0; i < n; ++i) order[fill[Set::subidx(hashes[i])]++] = i;
+
+  for (size_t s = 0; s < kSubmaps; ++s) {
+    if (begin[s] == begin[s + 1]) continue;
+    set_.with_submap(s, [&](Set::EmbeddedSet& set) {
+      for (size_t k = begin[s]; k < begin[s + 1]; ++k) {
+        const size_t i = order[k];
+        out[i] = InternLocked(&set, &arenas_[s], strings[i], hashes[i]);
+      }
+    });
+  }
+}
+
+size_t StringPool::size() const {
+  size_t size = 0;
+  for (size_t s = 0; s < kSubmaps; ++s) {
+    set_.with_submap(s, [&](Set::EmbeddedSet& set) { size += set.size(); });
+  }
+  return size;
+}
+
+size_t StringPool::bytes_used() const {
+  size_t bytes = 0;
+  for (size_t s = 0; s < kSubmaps; ++s) {
+    set_.with_submap(s, [&](Set::EmbeddedSet&) { bytes += arenas_[s].bytes; });
+  }
+  return bytes;
+}
+
+}  // namespace absl
@@ -0,0 +1,114 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: string_pool.h
+// -----------------------------------------------------------------------------
+//
+// An `absl::StringPool` interns strings: `Intern(s)` returns a view of a copy
+// of `s` owned by the pool, and equal strings always get the same view. The
+// views remain valid for the lifetime of the pool, so interned strings can be
+// compared and hashed by pointer.
+//
+// The pool is safe to use from multiple threads. Strings are indexed by an
+// `absl::parallel_flat_hash_set<absl::string_view>` split into 16 submaps,
+// each with its own lock and its own arena holding the bytes of the strings
+// of that submap, so threads only contend when they intern strings of the
+// same submap. Interning a batch of strings takes each submap lock at most
+// once.
+//
+// Example:
+//
+//   absl::StringPool pool;
+//   absl::string_view a = pool.Intern(GetHostName());
+//   absl::string_view b = pool.Intern(std::string("my") + "host");
+//   assert(a.data() == b.data());  // if both are "myhost"
+
+#ifndef ABSL_CONTAINER_STRING_POOL_H_
+#define ABSL_CONTAINER_STRING_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "absl/container/parallel_flat_hash_set.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+
+namespace absl {
+
+class StringPool {
+ public:
+  StringPool() = default;
+
+  StringPool(const StringPool&) = delete;
+  StringPool& operator=(const StringPool&) = delete;
+
+  // Returns the pool's copy of `s`, copying `s` into the pool if it was not
+  // interned before. The empty string is not stored: interning it returns an
+  // empty view.
+  absl::string_view Intern(absl::string_view s);
+
+  // Interns every element of `strings`, storing the result for `strings[i]`
+  // in `out[i]`. `out` must have the same size as `strings`, and may refer to
+  // the same memory to intern in place.
+  //
+  // The strings are grouped by submap first, so each submap lock is taken at
+  // most once for the whole batch.
+  void Intern(absl::Span<const absl::string_view> strings,
+              absl::Span<absl::string_view> out);
+
+  // Returns the number of distinct non-empty strings in the pool.
+  size_t size() const;
+
+  // Returns the number of bytes allocated to hold string contents.
+  size_t bytes_used() const;
+
+ private:
+  static constexpr size_t kSubmapBits = 4;
+  static constexpr size_t kSubmaps = size_t{1} << kSubmapBits;
+
+  // Stores the contents of the strings of one submap, in chunks of
+  // increasing size.
+  struct Arena {
+    char* Allocate(size_t n);
+
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char* next = nullptr;
+    size_t left = 0;
+    size_t next_chunk_size = 0;
+    size_t bytes = 0;
+  };
+
+  using Set = absl::parallel_flat_hash_set<
+      absl::string_view,
+      absl::container_internal::hash_default_hash<absl::string_view>,
+      absl::container_internal::hash_default_eq<absl::string_view>,
+      std::allocator<absl::string_view>, kSubmapBits, absl::Mutex>;
+
+  // Interns `s`, whose hash is `hash`, into `set`. Requires the lock of the
+  // submap `set`, to which `arena` belongs.
+  static absl::string_view InternLocked(Set::EmbeddedSet* set, Arena* arena,
+                                        absl::string_view s, size_t hash);
+
+  // `set_` is mutable so that the const accessors can lock its submaps.
+  mutable Set set_;
+  // `arenas_[i]` is guarded by the lock of submap `i` of `set_`.
+  Arena arenas_[kSubmaps];
+};
+
+}  // namespace absl
+
+#endif  // ABSL_CONTAINER_STRING_POOL_H_
@@ -0,0 +1,91 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/string_pool.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "absl/container/node_hash_set.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+
+namespace {
+
+// 64K distinct metric-like names, each interned many times.
+const std::vector<std::string>& Names() {
+  static const auto* names = [] {
+    auto* v = new std::vector<std::string>;
+    for (int i = 0; i < 1 << 16; ++i) {
+      v->push_back(absl::StrCat("rpc.server.latency.method_", i * 7919));
+    }
+    return v;
+  }();
+  return *names;
+}
+
+// The baseline: a node-based set behind a single mutex.
+class GlobalMutexPool {
+ public:
+  absl::string_view Intern(absl::string_view s) {
+    absl::MutexLock lock(&mu_);
+    return *set_.emplace(s).first;
+  }
+
+ private:
+  absl::Mutex mu_;
+  absl::node_hash_set<std::string> set_;
+};
+
+// Gives each benchmark thread a different starting point in `Names()`.
+size_t StartIndex() {
+  static std::atomic<size_t> next{0};
+  return next.fetch_add(4099, std::memory_order_relaxed);
+}
+
+template <typename Pool>
+void BM_Intern(benchmark::State& state) {
+  static Pool* pool = new Pool;
+  const auto& names = Names();
+  size_t i = StartIndex();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pool->Intern(names[i++ & (names.size() - 1)]));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_Intern, GlobalMutexPool)
+    ->UseRealTime()
+    ->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(BM_Intern, absl::StringPool)
+    ->UseRealTime()
+    ->ThreadRange(1, 8);
+
+// Batches of 256 strings, interned with one call.
+void BM_InternBatch(benchmark::State& state) {
+  static absl::StringPool* pool = new absl::StringPool;
+  const auto& names = Names();
+  std::vector<absl::string_view> batch(256), out(256);
+  size_t i = StartIndex();
+  for (auto _ : state) {
+    for (auto& s : batch) s = names[i++ & (names.size() - 1)];
+    pool->Intern(batch, absl::MakeSpan(out));
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 256);
+}
+BENCHMARK(BM_InternBatch)->UseRealTime()->ThreadRange(1, 8);
+
+}  // namespace
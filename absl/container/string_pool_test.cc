@@ -0,0 +1,124 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/container/string_pool.h"
+
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+
+namespace {
+
+TEST(StringPoolTest, InternReturnsStableCopy) {
+  absl::StringPool pool;
+  std::string s = "hello";
+  absl::string_view a = pool.Intern(s);
+  EXPECT_EQ("hello", a);
+  EXPECT_NE(s.data(), a.data());
+  s = "world";
+  EXPECT_EQ("hello", a);
+
+  absl::string_view b = pool.Intern(std::string("hel") + "lo");
+  EXPECT_EQ(a.data(), b.data());
+  EXPECT_EQ(a.size(), b.size());
+  EXPECT_NE(a.data(), pool.Intern("hell").data());
+  EXPECT_EQ(2, pool.size());
+}
+
+TEST(StringPoolTest, EmptyString) {
+  absl::StringPool pool;
+  EXPECT_TRUE(pool.Intern("").empty());
+  EXPECT_EQ(0, pool.size());
+  EXPECT_EQ(0, pool.bytes_used());
+}
+
+TEST(StringPoolTest, ManyStrings) {
+  absl::StringPool pool;
+  std::vector<absl::string_view> views;
+  for (int i = 0; i < 10000; ++i) {
+    views.push_back(pool.Intern(absl::StrCat(i)));
+  }
+  // A string larger than any arena chunk.
+  const std::string big(100000, 'x');
+  absl::string_view big_view = pool.Intern(big);
+  EXPECT_EQ(10001, pool.size());
+  EXPECT_GE(pool.bytes_used(), big.size());
+  EXPECT_EQ(big, big_view);
+  for (int i = 0; i < 10000; ++i) {
+    const std::string s = absl::StrCat(i);
+    ASSERT_EQ(s, views[i]);
+    ASSERT_EQ(views[i].data(), pool.Intern(s).data());
+  }
+  EXPECT_EQ(big_view.data(), pool.Intern(big).data());
+}
+
+TEST(StringPoolTest, BatchMatchesSingleIntern) {
+  absl::StringPool pool;
+  std::vector<std::string> strings;
+  for (int i = 0; i < 1000; ++i) {
+    strings.push_back(absl::StrCat("key", i % 300));
+  }
+  strings.push_back("");
+  std::vector<absl::string_view> batch(strings.begin(), strings.end());
+  std::vector<absl::string_view> out(batch.size());
+  pool.Intern(batch, absl::MakeSpan(out));
+  EXPECT_EQ(300, pool.size());
+  for (size_t i = 0; i < strings.size(); ++i) {
+    ASSERT_EQ(strings[i], out[i]);
+    ASSERT_EQ(pool.Intern(strings[i]).data(), out[i].data());
+  }
+
+  // In place.
+  pool.Intern(batch, absl::MakeSpan(batch));
+  EXPECT_EQ(out, batch);
+  for (size_t i = 0; i < out.size(); ++i) {
+    ASSERT_EQ(out[i].data(), batch[i].data());
+  }
+}
+
+TEST(StringPoolTest, ConcurrentIntern) {
+  absl::StringPool pool;
+  constexpr int kThreads = 8;
+  constexpr int kStrings = 2000;
+  std::vector<std::vector<absl::string_view>> results(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&pool, &results, t] {
+      std::vector<std::string> strings;
+      for (int i = 0; i < kStrings; ++i) strings.push_back(absl::StrCat(i));
+      if (t % 2 == 0) {
+        for (const std::string& s : strings) {
+          results[t].push_back(pool.Intern(s));
+        }
+      } else {
+        std::vector<absl::string_view> batch(strings.begin(), strings.end());
+        pool.Intern(batch, absl::MakeSpan(batch));
+        results[t] = batch;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(kStrings, pool.size());
+  for (int t = 1; t < kThreads; ++t) {
+    for (int i = 0; i < kStrings; ++i) {
+      ASSERT_EQ(results[0][i].data(), results[t][i].data());
+    }
+  }
+}
+
+}  // namespace
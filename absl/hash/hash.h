@@ -61,7 +61,12 @@
 #ifndef ABSL_HASH_HASH_H_
 #define ABSL_HASH_HASH_H_
 
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
 #include "absl/hash/internal/hash.h"
+#include "absl/types/span.h"
 
 namespace absl {
 
@@ -203,6 +208,63 @@ namespace absl {
 template <typename T>
 using Hash = absl::hash_internal::Hash<T>;
 
+// HashMany()
+//
+// Hashes a batch of keys: sets `out[i]` to `absl::Hash<T>{}(keys[i])` for every
+// `i`. `out` must be at least as large as `keys`.
+//
+// For integral and `absl::string_view` keys this is faster than calling
+// `absl::Hash` in a loop, as the hashes of several keys are computed at once.
+// Other hashable types are accepted and hashed one at a time.
+//
+// Example:
+//
+//   std::vector<absl::string_view> keys = ...;
+//   std::vector<size_t> hashes(keys.size());
+//   absl::HashMany(absl::MakeConstSpan(keys), absl::MakeSpan(hashes));
+//   for (size_t i = 0; i < keys.size(); ++i) {
+//     auto it = set.find(keys[i], hashes[i]);
+//     ...
+//   }
+template <typename T>
+void HashMany(absl::Span<const T> keys, absl::Span<size_t> out) {
+  static_assert(hash_internal::is_hashable<T>::value,
+                "absl::HashMany requires a hashable key type");
+  assert(out.size() >= keys.size());
+  hash_internal::CityHashState::hash_many(keys.data(), keys.size(), out.data());
+}
+
+// HashedKey
+//
+// A key together with its `absl::Hash`, computed once when the `HashedKey` is
+// constructed. The hash containers accept a `HashedKey` in `find()`,
+// `contains()` and `count()` and use the stored hash instead of hashing the key
+// again, which pays off for keys that are looked up many times:
+//
+//   static const absl::HashedKey<absl::string_view> kStatus("status");
+//   auto it = map.find(kStatus);
+//
+// The stored hash is that of `absl::Hash<K>`. It is used only by containers
+// that hash their keys with `absl::Hash`, as they do by default; other
+// containers hash the key again.
+//
+// `absl::Hash` is seeded differently in every process, so the hash cannot be
+// computed at compile time. Making the `HashedKey` static, as above, computes
+// it once per process.
+template <typename K>
+class HashedKey {
+ public:
+  explicit HashedKey(K key)
+      : key_(std::move(key)), hash_(absl::Hash<K>{}(key_)) {}
+
+  const K& key() const { return key_; }
+  size_t hash() const { return hash_; }
+
+ private:
+  K key_;
+  size_t hash_;
+};
+
 // HashState
 //
 // A type erased version of the hash state concept, for use in user-defined
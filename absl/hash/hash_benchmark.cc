@@ -0,0 +1,299 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Speed and quality benchmarks of absl::Hash.
+//
+// The BM_Hash* benchmarks measure the time to hash one value. The BM_Quality*
+// benchmarks build a table or an avalanche matrix once and report the result
+// as counters, so that a change of the hash can be judged on both:
+//   * stuck_bits: bits equal in every hash, from hashes_bitwise_and/or;
+//   * mean_probes, max_probes: probe lengths of a flat_hash_set of the keys;
+//   * worst_bias, mean_bias: avalanche, see hash_internal::MeasureAvalanche.
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/container/internal/hashtable_debug.h"
+#include "absl/hash/hash.h"
+#include "absl/hash/internal/hash_quality.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/variant.h"
+
+namespace {
+
+// Hashing a single value in a loop measures latency when each hash feeds the
+// next input, and throughput otherwise. Cycling through 64 precomputed inputs
+// measures throughput, which is what a table lookup loop sees.
+constexpr size_t kInputs = 64;
+
+template <typename T, typename Gen>
+void RunHashBenchmark(benchmark::State& state, Gen gen) {
+  std::vector<T> inputs;
+  for (size_t i = 0; i < kInputs; ++i) inputs.push_back(gen(i));
+  absl::Hash<T> hasher;
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hasher(inputs[i++ & (kInputs - 1)]));
+  }
+}
+
+template <typename T>
+void BM_HashInt(benchmark::State& state) {
+  RunHashBenchmark<T>(state,
+                      [](size_t i) { return static_cast<T>(i * 0x9E3779B9); });
+}
+BENCHMARK_TEMPLATE(BM_HashInt, int32_t);
+BENCHMARK_TEMPLATE(BM_HashInt, int64_t);
+
+void BM_HashStringView(benchmark::State& state) {
+  std::vector<std::string> storage;
+  for (size_t i = 0; i < kInputs; ++i) {
+    std::string s(state.range(0), 'a');
+    for (size_t j = 0; j < s.size(); ++j) {
+      s[j] = static_cast<char>('a' + (i * 7 + j * 13) % 26);
+    }
+    storage.push_back(std::move(s));
+  }
+  RunHashBenchmark<absl::string_view>(
+      state, [&](size_t i) { return absl::string_view(storage[i]); });
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HashStringView)
+    ->DenseRange(0, 16, 4)
+    ->DenseRange(24, 64, 8)
+    ->Arg(100)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Arg(4096);
+
+void BM_HashPair(benchmark::State& state) {
+  RunHashBenchmark<std::pair<int64_t, int32_t>>(state, [](size_t i) {
+    return std::make_pair(static_cast<int64_t>(i * 31), static_cast<int32_t>(i));
+  });
+}
+BENCHMARK(BM_HashPair);
+
+void BM_HashTuple(benchmark::State& state) {
+  RunHashBenchmark<std::tuple<int32_t, std::string, double>>(
+      state, [](size_t i) {
+        return std::make_tuple(static_cast<int32_t>(i), absl::StrCat("k", i),
+                               i * 0.5);
+      });
+}
+BENCHMARK(BM_HashTuple);
+
+void BM_HashIntVector(benchmark::State& state) {
+  RunHashBenchmark<std::vector<int32_t>>(state, [&](size_t i) {
+    std::vector<int32_t> v(state.range(0));
+    for (size_t j = 0; j < v.size(); ++j) v[j] = static_cast<int32_t>(i + j);
+    return v;
+  });
+  state.SetBytesProcessed(state.iterations() * state.range(0) *
+                          sizeof(int32_t));
+}
+BENCHMARK(BM_HashIntVector)->Arg(1)->Arg(4)->Arg(16)->Arg(64)->Arg(1024);
+
+void BM_HashDoubleVector(benchmark::State& state) {
+  RunHashBenchmark<std::vector<double>>(state, [&](size_t i) {
+    std::vector<double> v(state.range(0));
+    for (size_t j = 0; j < v.size(); ++j) v[j] = 0.25 * (i + j);
+    return v;
+  });
+  state.SetBytesProcessed(state.iterations() * state.range(0) *
+                          sizeof(double));
+}
+BENCHMARK(BM_HashDoubleVector)->Arg(1)->Arg(4)->Arg(16)->Arg(64)->Arg(1024);
+
+void BM_HashStringVector(benchmark::State& state) {
+  RunHashBenchmark<std::vector<std::string>>(state, [&](size_t i) {
+    std::vector<std::string> v;
+    for (int j = 0; j < state.range(0); ++j) v.push_back(absl::StrCat(i, j));
+    return v;
+  });
+}
+BENCHMARK(BM_HashStringVector)->Arg(1)->Arg(4)->Arg(16);
+
+void BM_HashVariant(benchmark::State& state) {
+  using V = absl::variant<int64_t, std::string>;
+  RunHashBenchmark<V>(state, [](size_t i) {
+    return i % 2 == 0 ? V(static_cast<int64_t>(i)) : V(absl::StrCat("v", i));
+  });
+}
+BENCHMARK(BM_HashVariant);
+
+// Hashing a batch of keys with absl::HashMany, against the loop it replaces.
+// The string batches point into a buffer much larger than the caches, as the
+// keys of a join do.
+
+constexpr size_t kBatch = 1024;
+
+std::vector<int64_t> BatchInts() {
+  std::vector<int64_t> v(kBatch);
+  for (size_t i = 0; i < kBatch; ++i) v[i] = static_cast<int64_t>(i * 2654435761);
+  return v;
+}
+
+std::vector<absl::string_view> BatchStrings(const std::string& buffer,
+                                            size_t len) {
+  std::vector<absl::string_view> v(kBatch);
+  const size_t stride = buffer.size() / kBatch;
+  for (size_t i = 0; i < kBatch; ++i) {
+    v[i] = absl::string_view(buffer.data() + i * stride, len);
+  }
+  return v;
+}
+
+template <typename T>
+void HashLoop(const std::vector<T>& keys, std::vector<size_t>* out) {
+  absl::Hash<T> hasher;
+  for (size_t i = 0; i < keys.size(); ++i) (*out)[i] = hasher(keys[i]);
+}
+
+template <typename T>
+void HashBatch(const std::vector<T>& keys, std::vector<size_t>* out) {
+  absl::HashMany(absl::MakeConstSpan(keys), absl::MakeSpan(*out));
+}
+
+template <void (*Hash)(const std::vector<int64_t>&, std::vector<size_t>*)>
+void BM_HashManyInts(benchmark::State& state) {
+  const auto keys = BatchInts();
+  std::vector<size_t> out(kBatch);
+  for (auto _ : state) {
+    Hash(keys, &out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK_TEMPLATE(BM_HashManyInts, HashLoop<int64_t>);
+BENCHMARK_TEMPLATE(BM_HashManyInts, HashBatch<int64_t>);
+
+template <void (*Hash)(const std::vector<absl::string_view>&,
+                       std::vector<size_t>*)>
+void BM_HashManyStrings(benchmark::State& state) {
+  const std::string buffer(size_t{64} << 20, 'x');
+  const auto keys = BatchStrings(buffer, state.range(0));
+  std::vector<size_t> out(kBatch);
+  for (auto _ : state) {
+    Hash(keys, &out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK_TEMPLATE(BM_HashManyStrings, HashLoop<absl::string_view>)
+    ->Arg(8)
+    ->Arg(24)
+    ->Arg(40);
+BENCHMARK_TEMPLATE(BM_HashManyStrings, HashBatch<absl::string_view>)
+    ->Arg(8)
+    ->Arg(24)
+    ->Arg(40);
+
+// Key sets for the quality benchmarks.
+
+constexpr size_t kNumKeys = 100000;
+
+std::vector<uint64_t> SequentialInts() {
+  std::vector<uint64_t> v;
+  for (uint64_t i = 0; i < kNumKeys; ++i) v.push_back(i);
+  return v;
+}
+
+std::vector<uint64_t> StridedInts() {
+  std::vector<uint64_t> v;
+  for (uint64_t i = 0; i < kNumKeys; ++i) v.push_back(i << 12);
+  return v;
+}
+
+std::vector<std::string> PrefixedStrings() {
+  std::vector<std::string> v;
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    v.push_back(absl::StrCat("rpc.server.latency.", i));
+  }
+  return v;
+}
+
+template <typename T>
+void ReportTableQuality(benchmark::State& state, const std::vector<T>& keys) {
+  absl::flat_hash_set<T> set;
+  for (auto _ : state) {
+    set = absl::flat_hash_set<T>(keys.begin(), keys.end());
+  }
+  const auto histogram =
+      absl::container_internal::GetHashtableDebugNumProbesHistogram(set);
+  state.counters["stuck_bits"] =
+      absl::hash_internal::MeasureBitDistribution(keys, absl::Hash<T>())
+          .stuck_bits();
+  state.counters["mean_probes"] =
+      absl::container_internal::GetHashtableDebugProbeSummary(set).mean;
+  state.counters["max_probes"] = histogram.size() - 1;
+}
+
+void BM_QualitySequentialInts(benchmark::State& state) {
+  ReportTableQuality(state, SequentialInts());
+}
+BENCHMARK(BM_QualitySequentialInts)->Iterations(1);
+
+void BM_QualityStridedInts(benchmark::State& state) {
+  ReportTableQuality(state, StridedInts());
+}
+BENCHMARK(BM_QualityStridedInts)->Iterations(1);
+
+void BM_QualityPrefixedStrings(benchmark::State& state) {
+  ReportTableQuality(state, PrefixedStrings());
+}
+BENCHMARK(BM_QualityPrefixedStrings)->Iterations(1);
+
+template <typename Hash>
+void ReportAvalanche(benchmark::State& state, size_t input_bytes, Hash hash) {
+  absl::hash_internal::AvalancheSummary a;
+  for (auto _ : state) {
+    a = absl::hash_internal::MeasureAvalanche(input_bytes, 2000, hash);
+  }
+  state.counters["worst_bias"] = a.worst_bias;
+  state.counters["mean_bias"] = a.mean_bias;
+}
+
+void BM_QualityAvalancheInt64(benchmark::State& state) {
+  ReportAvalanche(state, 8, [](const unsigned char* p) {
+    int64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return absl::Hash<int64_t>()(v);
+  });
+}
+BENCHMARK(BM_QualityAvalancheInt64)->Iterations(1);
+
+void BM_QualityAvalancheString(benchmark::State& state) {
+  const size_t len = state.range(0);
+  ReportAvalanche(state, len, [len](const unsigned char* p) {
+    return absl::Hash<absl::string_view>()(
+        absl::string_view(reinterpret_cast<const char*>(p), len));
+  });
+}
+BENCHMARK(BM_QualityAvalancheString)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->Arg(24)
+    ->Arg(40)
+    ->Arg(100)
+    ->Iterations(1);
+
+}  // namespace
@@ -0,0 +1,135 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Statistical tests of absl::Hash. The bounds are loose enough to hold for any
+// seed, and tight enough to catch a broken mixing step.
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/container/internal/hashtable_debug.h"
+#include "absl/hash/hash.h"
+#include "absl/hash/internal/hash_quality.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+namespace {
+
+using absl::hash_internal::MeasureAvalanche;
+using absl::hash_internal::MeasureBitDistribution;
+
+constexpr size_t kNumKeys = 100000;
+
+std::vector<uint64_t> SequentialInts() {
+  std::vector<uint64_t> v;
+  for (uint64_t i = 0; i < kNumKeys; ++i) v.push_back(i);
+  return v;
+}
+
+// Keys with zero low bits, like aligned pointers or scaled ids.
+std::vector<uint64_t> StridedInts() {
+  std::vector<uint64_t> v;
+  for (uint64_t i = 0; i < kNumKeys; ++i) v.push_back(i << 12);
+  return v;
+}
+
+// Keys that only differ in their high bits.
+std::vector<uint64_t> HighBitInts() {
+  std::vector<uint64_t> v;
+  for (uint64_t i = 0; i < kNumKeys; ++i) {
+    v.push_back((i << 44) | 0x5555);
+  }
+  return v;
+}
+
+// Strings sharing a long prefix, as in metric names.
+std::vector<std::string> PrefixedStrings(size_t prefix_len) {
+  std::vector<std::string> v;
+  const std::string prefix(prefix_len, 'p');
+  for (size_t i = 0; i < kNumKeys; ++i) v.push_back(absl::StrCat(prefix, i));
+  return v;
+}
+
+template <typename T>
+void ExpectNoStuckBits(const std::vector<T>& keys) {
+  const auto d = MeasureBitDistribution(keys, absl::Hash<T>());
+  EXPECT_EQ(0, d.stuck_bits())
+      << "and=" << d.bitwise_and << " or=" << d.bitwise_or;
+}
+
+TEST(HashQuality, NoStuckBits) {
+  ExpectNoStuckBits(SequentialInts());
+  ExpectNoStuckBits(StridedInts());
+  ExpectNoStuckBits(HighBitInts());
+  for (size_t prefix_len : {0, 8, 20, 60}) {
+    ExpectNoStuckBits(PrefixedStrings(prefix_len));
+  }
+  std::vector<std::pair<int, int>> pairs;
+  for (int i = 0; i < 1000; ++i) pairs.emplace_back(i, i % 7);
+  ExpectNoStuckBits(pairs);
+}
+
+TEST(HashQuality, StringAvalanche) {
+  // 2000 samples give an ideal worst bias of about 0.09. Strings of 1 to 3
+  // bytes are mixed like integers and avalanche as little.
+  for (size_t len : {4, 8, 12, 16, 17, 24, 32, 40, 64, 65, 100}) {
+    const auto a = MeasureAvalanche(len, 2000, [len](const unsigned char* p) {
+      return absl::Hash<absl::string_view>()(
+          absl::string_view(reinterpret_cast<const char*>(p), len));
+    });
+    EXPECT_LT(a.worst_bias, 0.2) << len;
+    EXPECT_LT(a.mean_bias, 0.03) << len;
+  }
+}
+
+TEST(HashQuality, IntegerAvalanche) {
+  // Integers are hashed with a single multiply-fold, which does not avalanche
+  // fully: the mean bias is about 0.5. Only guard against it getting worse;
+  // ProbeLengths checks that it is good enough for the tables.
+  const auto a = MeasureAvalanche(8, 1000, [](const unsigned char* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return absl::Hash<uint64_t>()(v);
+  });
+  EXPECT_LT(a.mean_bias, 0.75);
+}
+
+template <typename T>
+void ExpectShortProbes(const std::vector<T>& keys) {
+  absl::flat_hash_set<T> set(keys.begin(), keys.end());
+  const auto histogram =
+      absl::container_internal::GetHashtableDebugNumProbesHistogram(set);
+  const auto summary =
+      absl::container_internal::GetHashtableDebugProbeSummary(set);
+  // A random hash gives a mean of about 0.1 and a maximum of about 6 at the
+  // load factors reached here.
+  EXPECT_LT(summary.mean, 0.3);
+  EXPECT_LT(histogram.size(), 16);
+}
+
+TEST(HashQuality, ProbeLengths) {
+  ExpectShortProbes(SequentialInts());
+  ExpectShortProbes(StridedInts());
+  ExpectShortProbes(HighBitInts());
+  for (size_t prefix_len : {0, 8, 20, 60}) {
+    ExpectShortProbes(PrefixedStrings(prefix_len));
+  }
+}
+
+}  // namespace
@@ -39,6 +39,7 @@
 #include "gtest/gtest.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/hash/hash_testing.h"
+#include "absl/hash/internal/hash_avx2_test_helper.h"
 #include "absl/hash/internal/spy_hash_state.h"
 #include "absl/meta/type_traits.h"
 #include "absl/numeric/int128.h"
@@ -791,4 +792,87 @@ TEST(HashTest, DoesNotUseImplicitConversionsToBool) {
             absl::Hash<ValueWithBoolConversion>()(ValueWithBoolConversion{1}));
 }
 
+template <typename T>
+void ExpectHashManyMatchesHash(const std::vector<T>& keys) {
+  // Every batch size up to the prefetch distance and beyond.
+  for (size_t n = 0; n <= keys.size(); ++n) {
+    std::vector<size_t> out(n + 1, 17);
+    absl::HashMany(absl::MakeConstSpan(keys.data(), n), absl::MakeSpan(out));
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(absl::Hash<T>()(keys[i]), out[i]) << n << " " << i;
+    }
+    EXPECT_EQ(17, out[n]);
+  }
+}
+
+TEST(HashValueTest, FloatingPointRanges) {
+  // Ranges of floating point values are hashed as bytes, with -0.0
+  // normalized.
+  EXPECT_TRUE(absl::VerifyTypeImplementsAbslHashCorrectly(
+      std::vector<std::vector<double>>{
+          {}, {0.0}, {-0.0}, {1.0}, {0.0, 1.0}, {-0.0, 1.0}, {1.0, 0.0}}));
+  EXPECT_TRUE(absl::VerifyTypeImplementsAbslHashCorrectly(
+      std::vector<std::vector<float>>{
+          {}, {0.0f}, {-0.0f}, {1.0f}, {0.0f, 1.0f}, {-0.0f, 1.0f}}));
+
+  // Long enough for every path of combine_contiguous.
+  std::vector<double> a(1000);
+  std::iota(a.begin(), a.end(), -500.0);
+  std::vector<double> b = a;
+  b[500] = -0.0;
+  ASSERT_EQ(0.0, a[500]);
+  EXPECT_EQ(absl::Hash<std::vector<double>>()(a),
+            absl::Hash<std::vector<double>>()(b));
+  b[501] = 2.0;
+  EXPECT_NE(absl::Hash<std::vector<double>>()(a),
+            absl::Hash<std::vector<double>>()(b));
+}
+
+TEST(HashTest, HashedKey) {
+  const absl::HashedKey<absl::string_view> key("status");
+  EXPECT_EQ("status", key.key());
+  EXPECT_EQ(absl::Hash<absl::string_view>()("status"), key.hash());
+  EXPECT_EQ(absl::Hash<std::string>()("status"), key.hash());
+
+  const absl::HashedKey<std::pair<int, int>> pair_key({1, 2});
+  EXPECT_EQ((absl::Hash<std::pair<int, int>>()({1, 2})), pair_key.hash());
+}
+
+// `absl::Hash` must not depend on the compiler flags of the code that calls
+// it, or a table filled in one file would miss lookups from another.
+TEST(HashTest, SameValuesWhenBuiltWithAvx2) {
+#if defined(__x86_64__) && defined(__GNUC__)
+  if (absl::hash_internal::HashTestHelperBuiltForAvx2() &&
+      !__builtin_cpu_supports("avx2")) {
+    return;
+  }
+#endif
+  std::string s;
+  for (size_t len : {100, 511, 512, 513, 1024, 4096, 5000}) {
+    while (s.size() < len) s += static_cast<char>(s.size() * 37 + 11);
+    EXPECT_EQ(Hash<std::string>()(s),
+              absl::hash_internal::HashStringInAvx2Build(s))
+        << len;
+  }
+}
+
+TEST(HashTest, HashMany) {
+  std::vector<int> ints;
+  std::vector<uint64_t> uint64s;
+  std::vector<std::string> strings;
+  std::vector<std::pair<int, std::string>> pairs;
+  for (int i = 0; i < 11; ++i) {
+    ints.push_back(i * 1000003 - 5000);
+    uint64s.push_back(uint64_t{0x9E3779B97F4A7C15} * i);
+    strings.push_back(std::string(i * 7, static_cast<char>('a' + i)));
+    pairs.emplace_back(i, strings.back());
+  }
+  std::vector<absl::string_view> views(strings.begin(), strings.end());
+  ExpectHashManyMatchesHash(ints);
+  ExpectHashManyMatchesHash(uint64s);
+  ExpectHashManyMatchesHash(views);
+  ExpectHashManyMatchesHash(strings);
+  ExpectHashManyMatchesHash(pairs);
+}
+
 }  // namespace
@@ -48,6 +48,20 @@
 #include "absl/types/variant.h"
 #include "absl/utility/utility.h"
 #include "absl/hash/internal/city.h"
+#include "absl/hash/internal/low_level_hash.h"
+#include "absl/hash/internal/wide_hash.h"
+
+// ABSL_HASH_INTERNAL_USE_LOW_LEVEL_HASH
+//
+// Selects the function `absl::Hash` uses for contiguous ranges of more than 16
+// bytes on 64-bit platforms. When nonzero (the default), they are hashed with
+// `LowLevelHash`, which needs one 64x64->128 bit multiplication per 16 bytes.
+// Ranges of 512 bytes or more use `WideHash` instead, in every build.
+// Define it to 0 to use `CityHash64` instead. Either way, types are hashed
+// through the same `AbslHashValue` overloads; only the hash values change.
+#ifndef ABSL_HASH_INTERNAL_USE_LOW_LEVEL_HASH
+#define ABSL_HASH_INTERNAL_USE_LOW_LEVEL_HASH 1
+#endif
 
 namespace absl {
 namespace hash_internal {
@@ -525,9 +539,49 @@ hash_range_or_bytes(H hash_state, const T* data, size_t size) {
   return H::combine_contiguous(std::move(hash_state), bytes, sizeof(T) * size);
 }
 
+// hash_range_or_bytes()
+//
+// Overload for ranges of `float` and `double`. These are hashed as their bytes,
+// like uniquely represented types, except that each -0.0 is hashed as +0.0 so
+// that values that compare equal hash equal. This agrees with the hash of a
+// single value, and lets long arrays use the fast paths of
+// `combine_contiguous`.
+template <typename H, typename T>
+typename std::enable_if<std::is_same<T, float>::value ||
+                            std::is_same<T, double>::value,
+                        H>::type
+hash_range_or_bytes(H hash_state, const T* data, size_t size) {
+  using Bits = absl::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+  static_assert(sizeof(Bits) == sizeof(T), "unexpected floating point size");
+  constexpr Bits kNegativeZero = Bits{1} << (sizeof(Bits) * 8 - 1);
+  // The scan has no early exit and no branch, since -0.0 is rare.
+  bool has_negative_zero = false;
+  for (size_t i = 0; i < size; ++i) {
+    Bits bits;
+    std::memcpy(&bits, data + i, sizeof(bits));
+    has_negative_zero |= bits == kNegativeZero;
+  }
+  if (ABSL_PREDICT_FALSE(has_negative_zero)) {
+    absl::FixedArray<T> normalized(data, data + size);
+    for (T& v : normalized) {
+      if (v == 0) v = 0;
+    }
+    return H::combine_contiguous(
+        std::move(hash_state),
+        reinterpret_cast<const unsigned char*>(normalized.data()),
+        sizeof(T) * size);
+  }
+  return H::combine_contiguous(std::move(hash_state),
+                               reinterpret_cast<const unsigned char*>(data),
+                               sizeof(T) * size);
+}
+
 // hash_range_or_bytes()
 template <typename H, typename T>
-typename std::enable_if<!is_uniquely_represented<T>::value, H>::type
+typename std::enable_if<!is_uniquely_represented<T>::value &&
+                            !std::is_same<T, float>::value &&
+                            !std::is_same<T, double>::value,
+                        H>::type
 hash_range_or_bytes(H hash_state, const T* data, size_t size) {
   for (const auto end = data + size; data < end; ++data) {
     hash_state = H::combine(std::move(hash_state), *data);
@@ -682,6 +736,41 @@ class CityHashState : public HashStateBase<CityHashState> {
     return static_cast<size_t>(combine(CityHashState{}, value).state_);
   }
 
+  // CityHashState::hash_many()
+  //
+  // Sets `out[i]` to `hash(keys[i])` for every `i` in `[0, n)`.
+  //
+  // The keys are independent, so the work for several of them can be in
+  // flight at once. For integers a plain loop over `Mix` already achieves
+  // that; for strings we also prefetch the bytes of a later key, which are
+  // usually not in cache yet.
+  template <typename T, absl::enable_if_t<IntegralFastPath<T>::value, int> = 0>
+  static void hash_many(const T* keys, size_t n, size_t* out) {
+    const uint64_t seed = Seed();
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = static_cast<size_t>(Mix(seed, static_cast<uint64_t>(keys[i])));
+    }
+  }
+
+  // Overload of CityHashState::hash_many()
+  static void hash_many(const absl::string_view* keys, size_t n, size_t* out) {
+    constexpr size_t kPrefetchDistance = 8;
+    for (size_t i = 0; i < n; ++i) {
+#if defined(__GNUC__)
+      if (i + kPrefetchDistance < n) {
+        __builtin_prefetch(keys[i + kPrefetchDistance].data());
+      }
+#endif  // __GNUC__
+      out[i] = hash(keys[i]);
+    }
+  }
+
+  // Overload of CityHashState::hash_many()
+  template <typename T, absl::enable_if_t<!IntegralFastPath<T>::value, int> = 0>
+  static void hash_many(const T* keys, size_t n, size_t* out) {
+    for (size_t i = 0; i < n; ++i) out[i] = hash(keys[i]);
+  }
+
  private:
   // Invoked only once for a given argument; that plus the fact that this is
   // move-only ensures that there is only one non-moved-from object.
@@ -791,11 +880,18 @@ inline uint64_t CityHashState::CombineContiguousImpl(
 inline uint64_t CityHashState::CombineContiguousImpl(
     uint64_t state, const unsigned char* first, size_t len,
     std::integral_constant<int, 8> /* sizeof_size_t */) {
-  // For large values we use CityHash, for small ones we just use a
-  // multiplicative hash.
+  // For large values we use LowLevelHash or CityHash, for small ones we just
+  // use a multiplicative hash.
   uint64_t v;
   if (len > 16) {
+#if ABSL_HASH_INTERNAL_USE_LOW_LEVEL_HASH
+    // LowLevelHash and WideHash mix `state` in as their seed, so their result
+    // needs no further mixing.
+    if (len >= 512) return absl::hash_internal::WideHash(first, len, state);
+    return absl::hash_internal::LowLevelHash(first, len, state);
+#else   // ABSL_HASH_INTERNAL_USE_LOW_LEVEL_HASH
     v = absl::hash_internal::CityHash64(reinterpret_cast<const char*>(first), len);
+#endif  // ABSL_HASH_INTERNAL_USE_LOW_LEVEL_HASH
   } else if (len > 8) {
     auto p = Read9To16(first, len);
     state = Mix(state, p.first);
@@ -834,6 +930,15 @@ template <typename T>
 struct Hash
     : absl::conditional_t<is_hashable<T>::value, HashImpl<T>, PoisonedHash> {};
 
+// HashesLikeAbslHash
+//
+// Whether the hasher `H` hashes a `K` to `absl::Hash<K>{}(key)`, so that a
+// container hashing with `H` can use the hash stored in an
+// `absl::HashedKey<K>`. Hashers that forward to `absl::Hash` for some key types
+// specialize it.
+template <typename H, typename K>
+struct HashesLikeAbslHash : std::is_same<H, Hash<K>> {};
+
 template <typename H>
 template <typename T, typename... Ts>
 H HashStateBase<H>::combine(H state, const T& value, const Ts&... values) {
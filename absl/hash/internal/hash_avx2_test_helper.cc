@@ -0,0 +1,35 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/hash/internal/hash_avx2_test_helper.h"
+
+#include "absl/hash/hash.h"
+
+namespace absl {
+namespace hash_internal {
+
+bool HashTestHelperBuiltForAvx2() {
+#ifdef __AVX2__
+  return true;
+#else
+  return false;
+#endif
+}
+
+size_t HashStringInAvx2Build(const std::string& s) {
+  return absl::Hash<std::string>()(s);
+}
+
+}  // namespace hash_internal
+}  // namespace absl
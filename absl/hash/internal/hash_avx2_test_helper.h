@@ -0,0 +1,37 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Computes `absl::Hash` values in a file that is built with `-mavx2` where the
+// compiler supports it, so that tests can compare them with the values
+// computed in files built with the default flags.
+
+#ifndef ABSL_HASH_INTERNAL_HASH_AVX2_TEST_HELPER_H_
+#define ABSL_HASH_INTERNAL_HASH_AVX2_TEST_HELPER_H_
+
+#include <cstddef>
+#include <string>
+
+namespace absl {
+namespace hash_internal {
+
+// Whether the file defining these functions was built for AVX2.
+bool HashTestHelperBuiltForAvx2();
+
+// Returns `absl::Hash<std::string>()(s)`, computed in that file.
+size_t HashStringInAvx2Build(const std::string& s);
+
+}  // namespace hash_internal
+}  // namespace absl
+
+#endif  // ABSL_HASH_INTERNAL_HASH_AVX2_TEST_HELPER_H_
@@ -0,0 +1,120 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Measurements of the statistical quality of a hash function, used by the
+// quality test and the benchmark of absl::Hash.
+//
+// These are the properties a hash table depends on:
+//   * Every bit of the hash must vary across the keys of a table. The table
+//     takes its probe start from the low bits and its control bytes from the
+//     high bits, so a stuck bit wastes capacity or metadata. This is what
+//     hashtablez records in `hashes_bitwise_and` and `hashes_bitwise_or`.
+//   * Flipping any one bit of the input must flip every bit of the output with
+//     probability close to 1/2 (avalanche). Otherwise keys that differ in few
+//     bits, such as consecutive integers or strings with a counter suffix,
+//     cluster in the table.
+
+#ifndef ABSL_HASH_INTERNAL_HASH_QUALITY_H_
+#define ABSL_HASH_INTERNAL_HASH_QUALITY_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace absl {
+namespace hash_internal {
+
+// The bitwise and and or of a set of hashes, as recorded by hashtablez.
+struct HashBitDistribution {
+  size_t bitwise_and = ~size_t{};
+  size_t bitwise_or = 0;
+
+  void Add(size_t hash) {
+    bitwise_and &= hash;
+    bitwise_or |= hash;
+  }
+
+  // The number of bits that have the same value in every hash added so far.
+  int stuck_bits() const {
+    size_t stuck = bitwise_and | ~bitwise_or;
+    int n = 0;
+    for (; stuck != 0; stuck &= stuck - 1) ++n;
+    return n;
+  }
+};
+
+// Computes the `HashBitDistribution` of `hash(k)` for every `k` in `keys`.
+template <typename Keys, typename Hash>
+HashBitDistribution MeasureBitDistribution(const Keys& keys, Hash hash) {
+  HashBitDistribution d;
+  for (const auto& k : keys) d.Add(hash(k));
+  return d;
+}
+
+// Summary of an avalanche matrix: for each input bit `i` and output bit `o`,
+// `p(i, o)` is the fraction of inputs for which flipping `i` flips `o`. The
+// bias of an entry is `|2 * p(i, o) - 1|`: 0 is ideal, 1 means the output bit
+// never or always flips.
+struct AvalancheSummary {
+  double worst_bias = 0;
+  double mean_bias = 0;
+};
+
+// Measures the avalanche of `hash` on `samples` pseudorandom inputs of
+// `input_bytes` bytes. `hash` is called as `hash(const unsigned char*)`, reads
+// `input_bytes` bytes and returns a `size_t`.
+//
+// With `n` samples an ideal hash has a mean bias of about `0.8 / sqrt(n)` and a
+// worst bias of a few times `1 / sqrt(n)`.
+template <typename Hash>
+AvalancheSummary MeasureAvalanche(size_t input_bytes, size_t samples,
+                                  Hash hash) {
+  constexpr size_t kOutputBits = sizeof(size_t) * 8;
+  const size_t input_bits = input_bytes * 8;
+  std::vector<size_t> flips(input_bits * kOutputBits);
+  std::vector<unsigned char> input(input_bytes);
+  uint64_t rng = 0x2545f4914f6cdd1d;
+  for (size_t s = 0; s < samples; ++s) {
+    for (unsigned char& c : input) {
+      rng ^= rng << 13;
+      rng ^= rng >> 7;
+      rng ^= rng << 17;
+      c = static_cast<unsigned char>(rng);
+    }
+    const size_t h = hash(input.data());
+    for (size_t i = 0; i < input_bits; ++i) {
+      input[i / 8] ^= static_cast<unsigned char>(1 << (i % 8));
+      const size_t diff = h ^ hash(input.data());
+      input[i / 8] ^= static_cast<unsigned char>(1 << (i % 8));
+      for (size_t o = 0; o < kOutputBits; ++o) {
+        flips[i * kOutputBits + o] += (diff >> o) & 1;
+      }
+    }
+  }
+  AvalancheSummary summary;
+  for (size_t f : flips) {
+    const double bias = std::fabs(2.0 * f / samples - 1);
+    summary.worst_bias = (std::max)(summary.worst_bias, bias);
+    summary.mean_bias += bias;
+  }
+  if (!flips.empty()) summary.mean_bias /= flips.size();
+  return summary;
+}
+
+}  // namespace hash_internal
+}  // namespace absl
+
+#endif  // ABSL_HASH_INTERNAL_HASH_QUALITY_H_
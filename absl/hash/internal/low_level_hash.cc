@@ -0,0 +1,111 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/hash/internal/low_level_hash.h"
+
+#include "absl/base/config.h"
+#include "absl/base/internal/endian.h"
+#include "absl/numeric/int128.h"
+
+namespace absl {
+namespace hash_internal {
+
+namespace {
+
+// Arbitrary odd constants with roughly half of their bits set (the first
+// digits of pi), xored into the input words so that zero words still affect
+// the products.
+constexpr uint64_t kSalt[5] = {
+    0x243f6a8885a308d3, 0x13198a2e03707344, 0xa4093822299f31d0,
+    0x082efa98ec4e6c89, 0x452821e638d01377,
+};
+
+// Multiplies `v0` by `v1` and folds the 128-bit product into 64 bits.
+inline uint64_t Mix(uint64_t v0, uint64_t v1) {
+#ifdef ABSL_HAVE_INTRINSIC_INT128
+  __uint128_t p = v0;
+  p *= v1;
+  return static_cast<uint64_t>(p) ^ static_cast<uint64_t>(p >> 64);
+#else   // ABSL_HAVE_INTRINSIC_INT128
+  absl::uint128 p = v0;
+  p *= v1;
+  return absl::Uint128Low64(p) ^ absl::Uint128High64(p);
+#endif  // ABSL_HAVE_INTRINSIC_INT128
+}
+
+}  // namespace
+
+uint64_t LowLevelHash(const void* data, size_t len, uint64_t seed) {
+  const unsigned char* ptr = static_cast<const unsigned char*>(data);
+  const uint64_t starting_length = static_cast<uint64_t>(len);
+  uint64_t current_state = seed ^ kSalt[0];
+
+  if (len > 64) {
+    // Two chains of two multiplications each, so that their latencies
+    // overlap.
+    uint64_t duplicated_state = current_state;
+    do {
+      const uint64_t a = little_endian::Load64(ptr);
+      const uint64_t b = little_endian::Load64(ptr + 8);
+      const uint64_t c = little_endian::Load64(ptr + 16);
+      const uint64_t d = little_endian::Load64(ptr + 24);
+      const uint64_t e = little_endian::Load64(ptr + 32);
+      const uint64_t f = little_endian::Load64(ptr + 40);
+      const uint64_t g = little_endian::Load64(ptr + 48);
+      const uint64_t h = little_endian::Load64(ptr + 56);
+
+      const uint64_t cs0 = Mix(a ^ kSalt[1], b ^ current_state);
+      const uint64_t cs1 = Mix(c ^ kSalt[2], d ^ current_state);
+      current_state = cs0 ^ cs1;
+
+      const uint64_t ds0 = Mix(e ^ kSalt[3], f ^ duplicated_state);
+      const uint64_t ds1 = Mix(g ^ kSalt[4], h ^ duplicated_state);
+      duplicated_state = ds0 ^ ds1;
+
+      ptr += 64;
+      len -= 64;
+    } while (len > 64);
+    current_state ^= duplicated_state;
+  }
+
+  // At most 64 bytes are left.
+  while (len > 16) {
+    const uint64_t a = little_endian::Load64(ptr);
+    const uint64_t b = little_endian::Load64(ptr + 8);
+    current_state = Mix(a ^ kSalt[1], b ^ current_state);
+    ptr += 16;
+    len -= 16;
+  }
+
+  // At most 16 bytes are left. The reads below overlap rather than pad.
+  uint64_t a = 0;
+  uint64_t b = 0;
+  if (len > 8) {
+    a = little_endian::Load64(ptr);
+    b = little_endian::Load64(ptr + len - 8);
+  } else if (len > 3) {
+    a = little_endian::Load32(ptr);
+    b = little_endian::Load32(ptr + len - 4);
+  } else if (len > 0) {
+    a = (uint64_t{ptr[0]} << 16) | (uint64_t{ptr[len >> 1]} << 8) |
+        ptr[len - 1];
+  }
+
+  const uint64_t w = Mix(a ^ kSalt[1], b ^ current_state);
+  const uint64_t z = kSalt[1] ^ starting_length;
+  return Mix(w, z);
+}
+
+}  // namespace hash_internal
+}  // namespace absl
@@ -0,0 +1,45 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file provides LowLevelHash, a hash function for byte arrays built on
+// 64x64->128 bit multiplications whose two halves are folded together with an
+// xor, in the style of wyhash (https://github.com/wangyi-fudan/wyhash).
+//
+// Each multiplication mixes 16 bytes of input, and inputs of more than 64
+// bytes are consumed by two independent chains to make use of the multiplier
+// throughput of modern CPUs. On 64-bit platforms with a fast 128-bit multiply
+// this is noticeably faster than CityHash64 for inputs of 17 to a few hundred
+// bytes, which is why `absl::Hash` uses it for those lengths.
+//
+// Like CityHash, LowLevelHash is not suitable for cryptography, and its values
+// may change from release to release.
+
+#ifndef ABSL_HASH_INTERNAL_LOW_LEVEL_HASH_H_
+#define ABSL_HASH_INTERNAL_LOW_LEVEL_HASH_H_
+
+#include <stdint.h>
+#include <stdlib.h>  // for size_t.
+
+namespace absl {
+namespace hash_internal {
+
+// Hash function for a byte array. The 64-bit seed is mixed into the result, so
+// that chaining `LowLevelHash(s2, n2, LowLevelHash(s1, n1, seed))` hashes the
+// sequence of the two arrays.
+uint64_t LowLevelHash(const void* data, size_t len, uint64_t seed);
+
+}  // namespace hash_internal
+}  // namespace absl
+
+#endif  // ABSL_HASH_INTERNAL_LOW_LEVEL_HASH_H_
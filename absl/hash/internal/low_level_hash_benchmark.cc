@@ -0,0 +1,79 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "absl/hash/hash.h"
+#include "absl/hash/internal/city.h"
+#include "absl/hash/internal/low_level_hash.h"
+#include "absl/strings/string_view.h"
+
+namespace {
+
+// Strings of length state.range(0), cycled through so that the benchmark
+// measures throughput over independent inputs rather than a single one.
+std::vector<std::string> Inputs(size_t len) {
+  std::vector<std::string> v;
+  for (int i = 0; i < 64; ++i) {
+    std::string s(len, 'a');
+    for (size_t j = 0; j < len; ++j) s[j] = static_cast<char>(i * 131 + j * 7);
+    v.push_back(std::move(s));
+  }
+  return v;
+}
+
+void BM_CityHash64(benchmark::State& state) {
+  const auto inputs = Inputs(state.range(0));
+  size_t i = 0;
+  for (auto _ : state) {
+    const std::string& s = inputs[i++ & 63];
+    benchmark::DoNotOptimize(
+        absl::hash_internal::CityHash64(s.data(), s.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CityHash64)->DenseRange(8, 64, 8)->Arg(100)->Arg(256)->Arg(1024);
+
+void BM_LowLevelHash(benchmark::State& state) {
+  const auto inputs = Inputs(state.range(0));
+  size_t i = 0;
+  for (auto _ : state) {
+    const std::string& s = inputs[i++ & 63];
+    benchmark::DoNotOptimize(
+        absl::hash_internal::LowLevelHash(s.data(), s.size(), 0));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LowLevelHash)->DenseRange(8, 64, 8)->Arg(100)->Arg(256)->Arg(1024);
+
+// The whole absl::Hash path, which uses whichever function
+// ABSL_HASH_INTERNAL_USE_LOW_LEVEL_HASH selects.
+void BM_AbslHashStringView(benchmark::State& state) {
+  const auto inputs = Inputs(state.range(0));
+  absl::Hash<absl::string_view> hasher;
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hasher(inputs[i++ & 63]));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AbslHashStringView)
+    ->DenseRange(8, 64, 8)
+    ->Arg(100)
+    ->Arg(256)
+    ->Arg(1024);
+
+}  // namespace
@@ -0,0 +1,97 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/hash/internal/low_level_hash.h"
+
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace absl {
+namespace hash_internal {
+namespace {
+
+// Pseudorandom bytes, so that no input is degenerate.
+std::string RandomBytes(size_t len) {
+  std::string s(len, '\0');
+  uint64_t x = 0x9e3779b97f4a7c15;
+  for (char& c : s) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    c = static_cast<char>(x);
+  }
+  return s;
+}
+
+TEST(LowLevelHash, Deterministic) {
+  const std::string s = RandomBytes(1000);
+  for (size_t len = 0; len <= s.size(); ++len) {
+    const std::string copy = s.substr(0, len);
+    ASSERT_EQ(LowLevelHash(s.data(), len, 42),
+              LowLevelHash(copy.data(), len, 42))
+        << len;
+  }
+}
+
+TEST(LowLevelHash, DistinctPrefixesAndSeeds) {
+  // Covers every tail length and both the 16 and 64 byte loops.
+  const std::string s = RandomBytes(300);
+  std::set<uint64_t> hashes;
+  for (size_t len = 0; len <= s.size(); ++len) {
+    for (uint64_t seed : {0, 1, 2, 0x12345678}) {
+      hashes.insert(LowLevelHash(s.data(), len, seed));
+    }
+  }
+  EXPECT_EQ(4 * (s.size() + 1), hashes.size());
+}
+
+TEST(LowLevelHash, ZeroBytesOfDifferentLengths) {
+  const std::string zeros(200, '\0');
+  std::set<uint64_t> hashes;
+  for (size_t len = 0; len <= zeros.size(); ++len) {
+    hashes.insert(LowLevelHash(zeros.data(), len, 0));
+  }
+  EXPECT_EQ(zeros.size() + 1, hashes.size());
+}
+
+TEST(LowLevelHash, EveryBitMatters) {
+  for (size_t len : {1, 3, 4, 7, 8, 9, 16, 17, 31, 40, 64, 65, 100, 128, 200}) {
+    std::string s = RandomBytes(len);
+    const uint64_t h = LowLevelHash(s.data(), len, 7);
+    for (size_t bit = 0; bit < 8 * len; ++bit) {
+      s[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+      ASSERT_NE(h, LowLevelHash(s.data(), len, 7)) << len << " " << bit;
+      s[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+    }
+  }
+}
+
+TEST(LowLevelHash, ReadsOnlyTheRange) {
+  std::string s = RandomBytes(300);
+  for (size_t len : {1, 5, 12, 16, 33, 64, 70, 129}) {
+    const uint64_t h = LowLevelHash(s.data() + 100, len, 0);
+    std::string t = s;
+    std::memset(&t[0], 0, 100);
+    std::memset(&t[100 + len], 0, t.size() - 100 - len);
+    EXPECT_EQ(h, LowLevelHash(t.data() + 100, len, 0)) << len;
+  }
+}
+
+}  // namespace
+}  // namespace hash_internal
+}  // namespace absl
@@ -0,0 +1,306 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/hash/internal/wide_hash.h"
+
+#include <cassert>
+#include <cstddef>
+
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
+#include "absl/base/internal/endian.h"
+#include "absl/numeric/int128.h"
+
+#if defined(__SSE2__) ||  \
+    (defined(_MSC_VER) && \
+     (defined(_M_X64) || (defined(_M_IX86) && _M_IX86_FP >= 2)))
+#define ABSL_HASH_INTERNAL_WIDE_HASH_SSE2 1
+#include <emmintrin.h>
+#else
+#define ABSL_HASH_INTERNAL_WIDE_HASH_SSE2 0
+#endif
+
+// ABSL_HASH_INTERNAL_WIDE_HASH_AVX2
+//
+// Whether the AVX2 implementation is compiled. Without `-mavx2`, GCC and Clang
+// compile it for x86-64 function by function, and it is used only on CPUs
+// that support it. The choice is made here rather than in the header, so that
+// every caller uses the same implementation whatever its compiler flags.
+#if defined(__AVX2__)
+#define ABSL_HASH_INTERNAL_WIDE_HASH_AVX2 1
+#define ABSL_HASH_INTERNAL_WIDE_HASH_AVX2_DISPATCH 0
+#define ABSL_HASH_INTERNAL_WIDE_HASH_TARGET_AVX2
+#elif defined(__x86_64__) && (defined(__clang__) || __GNUC__ >= 5)
+#define ABSL_HASH_INTERNAL_WIDE_HASH_AVX2 1
+#define ABSL_HASH_INTERNAL_WIDE_HASH_AVX2_DISPATCH 1
+#define ABSL_HASH_INTERNAL_WIDE_HASH_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ABSL_HASH_INTERNAL_WIDE_HASH_AVX2 0
+#define ABSL_HASH_INTERNAL_WIDE_HASH_AVX2_DISPATCH 0
+#endif
+
+#if ABSL_HASH_INTERNAL_WIDE_HASH_AVX2
+#include <immintrin.h>
+#endif
+
+namespace absl {
+namespace hash_internal {
+
+namespace {
+
+constexpr size_t kLanes = 8;
+constexpr size_t kStripeSize = kLanes * sizeof(uint64_t);
+constexpr size_t kStripesPerBlock = 16;
+constexpr size_t kBlockSize = kStripeSize * kStripesPerBlock;
+
+// Stripe `s` of a block uses the keys `kSecret[s, s + 8)`. The scrambling step
+// and the last stripe use `kSecret[16, 24)`. These are the first outputs of
+// splitmix64 seeded with 0.
+constexpr uint64_t kSecret[24] = {
+    0xe220a8397b1dcdaf, 0x6e789e6aa1b965f4, 0x06c45d188009454f,
+    0xf88bb8a8724c81ec, 0x1b39896a51a8749b, 0x53cb9f0c747ea2ea,
+    0x2c829abe1f4532e1, 0xc584133ac916ab3c, 0x3ee5789041c98ac3,
+    0xf3b8488c368cb0a6, 0x657eecdd3cb13d09, 0xc2d326e0055bdef6,
+    0x8621a03fe0bbdb7b, 0x8e1f7555983aa92f, 0xb54e0f1600cc4d19,
+    0x84bb3f97971d80ab, 0x7d29825c75521255, 0xc3cf17102b7f7f86,
+    0x3466e9a083914f64, 0xd81a8d2b5a4485ac, 0xdb01602b100b9ed7,
+    0xa9038a921825f10d, 0xedf5f1d90dca2f6a, 0x54496ad67bd2634c,
+};
+constexpr const uint64_t* kLastKeys = kSecret + 16;
+
+// Multiplier of the scrambling step. It fits in 32 bits, so that SSE2 can
+// multiply by it with two 32x32->64 bit multiplications.
+constexpr uint32_t kScrambleMul = 0x9e3779b1;
+
+// Multiplies `v0` by `v1` and folds the 128-bit product into 64 bits.
+inline uint64_t Mix(uint64_t v0, uint64_t v1) {
+#ifdef ABSL_HAVE_INTRINSIC_INT128
+  __uint128_t p = v0;
+  p *= v1;
+  return static_cast<uint64_t>(p) ^ static_cast<uint64_t>(p >> 64);
+#else   // ABSL_HAVE_INTRINSIC_INT128
+  absl::uint128 p = v0;
+  p *= v1;
+  return absl::Uint128Low64(p) ^ absl::Uint128High64(p);
+#endif  // ABSL_HAVE_INTRINSIC_INT128
+}
+
+// The accumulators are members of the implementations, so that the compiler
+// can keep them in registers for the whole loop.
+class Portable {
+ public:
+  explicit Portable(uint64_t seed) {
+    for (size_t i = 0; i < kLanes; ++i) acc_[i] = kSecret[i] ^ seed;
+  }
+
+  void Accumulate(const unsigned char* p, const uint64_t* keys) {
+    for (size_t i = 0; i < kLanes; ++i) {
+      const uint64_t w = little_endian::Load64(p + 8 * i);
+      const uint64_t k = w ^ keys[i];
+      acc_[i ^ 1] += w;
+      acc_[i] += (k & 0xffffffff) * (k >> 32);
+    }
+  }
+
+  void Scramble() {
+    for (size_t i = 0; i < kLanes; ++i) {
+      uint64_t a = acc_[i];
+      a ^= a >> 47;
+      a ^= kLastKeys[i];
+      acc_[i] = a * kScrambleMul;
+    }
+  }
+
+  void Store(uint64_t* out) const {
+    for (size_t i = 0; i < kLanes; ++i) out[i] = acc_[i];
+  }
+
+ private:
+  uint64_t acc_[kLanes];
+};
+
+#if ABSL_HASH_INTERNAL_WIDE_HASH_SSE2
+// Works on two lanes per 128-bit register. `kSecret` is read with unaligned
+// loads: on x86 its words are stored little endian, like the input.
+class Sse2 {
+ public:
+  explicit Sse2(uint64_t seed) {
+    const __m128i s = _mm_set1_epi64x(static_cast<long long>(seed));
+    for (size_t i = 0; i < kLanes / 2; ++i) {
+      acc_[i] = _mm_xor_si128(Load(kSecret + 2 * i), s);
+    }
+  }
+
+  void Accumulate(const unsigned char* p, const uint64_t* keys) {
+    for (size_t i = 0; i < kLanes / 2; ++i) {
+      const __m128i w = Load(p + 16 * i);
+      const __m128i k = _mm_xor_si128(w, Load(keys + 2 * i));
+      // lo32(k) * hi32(k) in each 64-bit lane.
+      const __m128i product =
+          _mm_mul_epu32(k, _mm_shuffle_epi32(k, _MM_SHUFFLE(0, 3, 0, 1)));
+      // The words of the neighbouring lanes.
+      const __m128i swapped = _mm_shuffle_epi32(w, _MM_SHUFFLE(1, 0, 3, 2));
+      acc_[i] = _mm_add_epi64(_mm_add_epi64(acc_[i], swapped), product);
+    }
+  }
+
+  void Scramble() {
+    const __m128i mul = _mm_set1_epi32(static_cast<int>(kScrambleMul));
+    for (size_t i = 0; i < kLanes / 2; ++i) {
+      __m128i v = acc_[i];
+      v = _mm_xor_si128(v, _mm_srli_epi64(v, 47));
+      v = _mm_xor_si128(v, Load(kLastKeys + 2 * i));
+      // 64x32 bit multiplication from two 32x32->64 bit ones.
+      const __m128i lo = _mm_mul_epu32(v, mul);
+      const __m128i hi =
+          _mm_mul_epu32(_mm_shuffle_epi32(v, _MM_SHUFFLE(0, 3, 0, 1)), mul);
+      acc_[i] = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+    }
+  }
+
+  void Store(uint64_t* out) const {
+    for (size_t i = 0; i < kLanes / 2; ++i) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out) + i, acc_[i]);
+    }
+  }
+
+ private:
+  static __m128i Load(const void* p) {
+    return _mm_loadu_si128(static_cast<const __m128i*>(p));
+  }
+
+  __m128i acc_[kLanes / 2];
+};
+#endif  // ABSL_HASH_INTERNAL_WIDE_HASH_SSE2
+
+#if ABSL_HASH_INTERNAL_WIDE_HASH_AVX2
+// Works on four lanes per 256-bit register, otherwise like `Sse2`.
+class Avx2 {
+ public:
+  ABSL_HASH_INTERNAL_WIDE_HASH_TARGET_AVX2 explicit Avx2(uint64_t seed) {
+    const __m256i s = _mm256_set1_epi64x(static_cast<long long>(seed));
+    for (size_t i = 0; i < kLanes / 4; ++i) {
+      acc_[i] = _mm256_xor_si256(Load(kSecret + 4 * i), s);
+    }
+  }
+
+  ABSL_HASH_INTERNAL_WIDE_HASH_TARGET_AVX2 void Accumulate(
+      const unsigned char* p, const uint64_t* keys) {
+    for (size_t i = 0; i < kLanes / 4; ++i) {
+      const __m256i w = Load(p + 32 * i);
+      const __m256i k = _mm256_xor_si256(w, Load(keys + 4 * i));
+      const __m256i product =
+          _mm256_mul_epu32(k, _mm256_shuffle_epi32(k, _MM_SHUFFLE(0, 3, 0, 1)));
+      const __m256i swapped = _mm256_shuffle_epi32(w, _MM_SHUFFLE(1, 0, 3, 2));
+      acc_[i] = _mm256_add_epi64(_mm256_add_epi64(acc_[i], swapped), product);
+    }
+  }
+
+  ABSL_HASH_INTERNAL_WIDE_HASH_TARGET_AVX2 void Scramble() {
+    const __m256i mul = _mm256_set1_epi32(static_cast<int>(kScrambleMul));
+    for (size_t i = 0; i < kLanes / 4; ++i) {
+      __m256i v = acc_[i];
+      v = _mm256_xor_si256(v, _mm256_srli_epi64(v, 47));
+      v = _mm256_xor_si256(v, Load(kLastKeys + 4 * i));
+      const __m256i lo = _mm256_mul_epu32(v, mul);
+      const __m256i hi = _mm256_mul_epu32(
+          _mm256_shuffle_epi32(v, _MM_SHUFFLE(0, 3, 0, 1)), mul);
+      acc_[i] = _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+    }
+  }
+
+  ABSL_HASH_INTERNAL_WIDE_HASH_TARGET_AVX2 void Store(uint64_t* out) const {
+    for (size_t i = 0; i < kLanes / 4; ++i) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out) + i, acc_[i]);
+    }
+  }
+
+ private:
+  ABSL_HASH_INTERNAL_WIDE_HASH_TARGET_AVX2 static __m256i Load(const void* p) {
+    return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+  }
+
+  __m256i acc_[kLanes / 4];
+};
+#endif  // ABSL_HASH_INTERNAL_WIDE_HASH_AVX2
+
+// Always inlined, so that it is compiled for AVX2 inside `WideHashAvx2()`.
+template <typename Impl>
+ABSL_ATTRIBUTE_ALWAYS_INLINE inline uint64_t WideHashImpl(const void* data, size_t len, uint64_t seed) {
+  assert(len >= kWideHashMinLength);
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  const unsigned char* const end = p + len;
+  Impl impl(seed);
+
+  // All the full blocks but the last, so that at least one byte is left.
+  for (; end - p > static_cast<ptrdiff_t>(kBlockSize); p += kBlockSize) {
+    for (size_t s = 0; s < kStripesPerBlock; ++s) {
+      impl.Accumulate(p + s * kStripeSize, kSecret + s);
+    }
+    impl.Scramble();
+  }
+  // The full stripes of the last block but the last, then the last 64 bytes.
+  for (size_t s = 0; end - p > static_cast<ptrdiff_t>(kStripeSize);
+       ++s, p += kStripeSize) {
+    impl.Accumulate(p, kSecret + s);
+  }
+  impl.Accumulate(end - kStripeSize, kLastKeys);
+
+  uint64_t acc[kLanes];
+  impl.Store(acc);
+  uint64_t h = static_cast<uint64_t>(len) * kSecret[0];
+  for (size_t i = 0; i < kLanes; i += 2) {
+    h += Mix(acc[i] ^ kSecret[i + 8], acc[i + 1] ^ kSecret[i + 9]);
+  }
+  return Mix(h ^ seed, kSecret[23]);
+}
+
+#if ABSL_HASH_INTERNAL_WIDE_HASH_AVX2
+ABSL_HASH_INTERNAL_WIDE_HASH_TARGET_AVX2 uint64_t WideHashAvx2(const void* data,
+                                                               size_t len,
+                                                               uint64_t seed) {
+  return WideHashImpl<Avx2>(data, len, seed);
+}
+#endif  // ABSL_HASH_INTERNAL_WIDE_HASH_AVX2
+
+#if ABSL_HASH_INTERNAL_WIDE_HASH_AVX2_DISPATCH
+bool CpuHasAvx2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+#endif  // ABSL_HASH_INTERNAL_WIDE_HASH_AVX2_DISPATCH
+
+}  // namespace
+
+uint64_t WideHash(const void* data, size_t len, uint64_t seed) {
+#if ABSL_HASH_INTERNAL_WIDE_HASH_AVX2_DISPATCH
+  static const bool has_avx2 = CpuHasAvx2();
+  if (has_avx2) return WideHashAvx2(data, len, seed);
+#endif
+#if ABSL_HASH_INTERNAL_WIDE_HASH_AVX2 && \
+    !ABSL_HASH_INTERNAL_WIDE_HASH_AVX2_DISPATCH
+  return WideHashAvx2(data, len, seed);
+#elif ABSL_HASH_INTERNAL_WIDE_HASH_SSE2
+  return WideHashImpl<Sse2>(data, len, seed);
+#else
+  return WideHashImpl<Portable>(data, len, seed);
+#endif
+}
+
+uint64_t WideHashPortable(const void* data, size_t len, uint64_t seed) {
+  return WideHashImpl<Portable>(data, len, seed);
+}
+
+}  // namespace hash_internal
+}  // namespace absl
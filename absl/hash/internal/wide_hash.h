@@ -0,0 +1,57 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file provides WideHash, a hash function for large byte arrays whose
+// inner loop maps onto SIMD instructions. It follows the structure of the long
+// input path of XXH3 (https://github.com/Cyan4973/xxHash):
+//
+//   * The input is read in 64-byte stripes into eight 64-bit accumulators.
+//     Each 8-byte word `w` is xored with a key `k` and the accumulator of its
+//     lane gains `lo32(w ^ k) * hi32(w ^ k)`, while the neighbouring lane gains
+//     `w` itself. The key depends on the position of the stripe in its block,
+//     so that reordering stripes changes the result.
+//   * Every 16 stripes (a 1024-byte block) the accumulators are scrambled with
+//     a shift, an xor and a multiplication.
+//   * The last stripe is read from the last 64 bytes of the input, and the
+//     accumulators are folded into 64 bits with 64x64->128 bit
+//     multiplications.
+//
+// The result is fully specified by the description above: the AVX2, SSE2 and
+// portable implementations compute the same values on every platform. Which
+// one runs is decided in wide_hash.cc, on x86-64 by the CPU, never by the
+// compiler flags of the caller.
+
+#ifndef ABSL_HASH_INTERNAL_WIDE_HASH_H_
+#define ABSL_HASH_INTERNAL_WIDE_HASH_H_
+
+#include <stdint.h>
+#include <stdlib.h>  // for size_t.
+
+namespace absl {
+namespace hash_internal {
+
+// The shortest input WideHash accepts.
+constexpr size_t kWideHashMinLength = 64;
+
+// Hash function for a byte array of at least `kWideHashMinLength` bytes. The
+// 64-bit seed is mixed into the result.
+uint64_t WideHash(const void* data, size_t len, uint64_t seed);
+
+// Same as `WideHash()`, without SIMD instructions. Exposed for testing.
+uint64_t WideHashPortable(const void* data, size_t len, uint64_t seed);
+
+}  // namespace hash_internal
+}  // namespace absl
+
+#endif  // ABSL_HASH_INTERNAL_WIDE_HASH_H_
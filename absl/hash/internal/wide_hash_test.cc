@@ -0,0 +1,89 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/hash/internal/wide_hash.h"
+
+#include <cstring>
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/hash/internal/hash_quality.h"
+
+namespace absl {
+namespace hash_internal {
+namespace {
+
+std::string RandomBytes(size_t len) {
+  std::string s(len, '\0');
+  uint64_t x = 0x9e3779b97f4a7c15;
+  for (char& c : s) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    c = static_cast<char>(x);
+  }
+  return s;
+}
+
+TEST(WideHash, MatchesPortable) {
+  // Covers partial and full last stripes and blocks.
+  const std::string s = RandomBytes(5000);
+  for (size_t len = kWideHashMinLength; len <= s.size(); ++len) {
+    for (uint64_t seed : {uint64_t{0}, uint64_t{0x0123456789abcdef}}) {
+      ASSERT_EQ(WideHashPortable(s.data(), len, seed),
+                WideHash(s.data(), len, seed))
+          << len;
+    }
+  }
+}
+
+TEST(WideHash, DistinctPrefixesAndSeeds) {
+  const std::string s = RandomBytes(3000);
+  std::set<uint64_t> hashes;
+  for (size_t len = kWideHashMinLength; len <= s.size(); ++len) {
+    for (uint64_t seed : {0, 1, 2}) {
+      hashes.insert(WideHash(s.data(), len, seed));
+    }
+  }
+  EXPECT_EQ(3 * (s.size() - kWideHashMinLength + 1), hashes.size());
+}
+
+TEST(WideHash, StripeOrderMatters) {
+  for (size_t len : {128, 1024, 2048 + 64}) {
+    std::string s = RandomBytes(len);
+    const uint64_t h = WideHash(s.data(), len, 0);
+    // Swap the first two stripes.
+    std::string t = s;
+    std::memcpy(&t[0], s.data() + 64, 64);
+    std::memcpy(&t[64], s.data(), 64);
+    EXPECT_NE(h, WideHash(t.data(), len, 0)) << len;
+  }
+}
+
+TEST(WideHash, Avalanche) {
+  // 1000 samples give an ideal worst bias of about 0.15 over this many
+  // entries.
+  for (size_t len : {64, 100, 1030}) {
+    const auto a = MeasureAvalanche(len, 1000, [len](const unsigned char* p) {
+      return static_cast<size_t>(WideHash(p, len, 42));
+    });
+    EXPECT_LT(a.worst_bias, 0.25) << len;
+    EXPECT_LT(a.mean_bias, 0.03) << len;
+  }
+}
+
+}  // namespace
+}  // namespace hash_internal
+}  // namespace absl
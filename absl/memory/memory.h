@@ -649,6 +649,38 @@ struct default_allocator_is_nothrow : std::true_type {};
 struct default_allocator_is_nothrow : std::false_type {};
 #endif
 
+// -----------------------------------------------------------------------------
+// Class Template: is_trivially_relocatable
+// -----------------------------------------------------------------------------
+//
+// `absl::is_trivially_relocatable<T>` derives from `std::true_type` when an
+// object of type `T` may be moved to another address by copying its bytes and
+// then forgetting the original without running its destructor. Containers use
+// it to relocate elements with `memcpy()` when they grow, shrink or swap.
+//
+// The trait holds for trivially copyable types and for `std::unique_ptr` and
+// `std::shared_ptr`. Other types may opt in by specializing it:
+//
+//   namespace absl {
+//   template <>
+//   struct is_trivially_relocatable<MyType> : std::true_type {};
+//   }  // namespace absl
+//
+// Types that hold pointers into themselves must not opt in. Notably this
+// includes `std::string` in libstdc++, whose short-string buffer is addressed
+// through an internal pointer.
+template <typename T>
+struct is_trivially_relocatable
+    : std::integral_constant<bool,
+                             absl::is_trivially_copy_constructible<T>::value &&
+                                 absl::is_trivially_destructible<T>::value> {};
+
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+template <typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
 namespace memory_internal {
 template <typename Allocator, typename Iterator, typename... Args>
 void ConstructRange(Allocator& alloc, Iterator first, Iterator last,
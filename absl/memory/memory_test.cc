@@ -649,4 +649,21 @@ TEST(AllocatorNoThrowTest, CustomAllocator) {
   EXPECT_FALSE(absl::allocator_is_nothrow<UnspecifiedAllocator>::value);
 }
 
+TEST(IsTriviallyRelocatableTest, Defaults) {
+  struct Pod {
+    int a;
+    double b;
+  };
+  struct NonTrivial {
+    NonTrivial(const NonTrivial&) {}
+  };
+  EXPECT_TRUE(absl::is_trivially_relocatable<int>::value);
+  EXPECT_TRUE(absl::is_trivially_relocatable<int*>::value);
+  EXPECT_TRUE(absl::is_trivially_relocatable<Pod>::value);
+  EXPECT_FALSE(absl::is_trivially_relocatable<NonTrivial>::value);
+  EXPECT_TRUE(absl::is_trivially_relocatable<std::unique_ptr<int>>::value);
+  EXPECT_TRUE(absl::is_trivially_relocatable<std::shared_ptr<Pod>>::value);
+  EXPECT_FALSE(absl::is_trivially_relocatable<std::string>::value);
+}
+
 }  // namespace
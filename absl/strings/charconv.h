@@ -80,6 +80,44 @@ absl::from_chars_result from_chars(const char* first, const char* last,
                                    float& value,  // NOLINT
                                    chars_format fmt = chars_format::general);
 
+// The return result of a number-to-string conversion.
+//
+// `ec` is set to `value_too_large` if the output did not fit in the given
+// range, in which case `ptr` is the `last` argument to to_chars and the
+// contents of the range are unspecified.  Otherwise `ec` is std::errc() and
+// `ptr` is one past the last character written.
+struct to_chars_result {
+  char* ptr;
+  std::errc ec;
+};
+
+// Workalike compatibility version of std::to_chars from C++17, for the
+// `double` and `float` types.  No terminating NUL is written.
+//
+// Writes the shortest decimal that from_chars() reads back as exactly `value`
+// into [first, last): the one with the fewest significant digits, and of
+// those the one closest to `value`.  The overload without `fmt` picks fixed or
+// scientific notation, whichever is shorter, preferring fixed on a tie.  For
+// example, 0.3 is written as "0.3", 1e23 as "1e+23" and 5e-324 as "5e-324".
+//
+// With `fmt`, `fixed` always writes fixed notation (1e23 is written as
+// "100000000000000000000000"), `scientific` always writes scientific
+// notation with an exponent of at least two digits, as printf's "%e" does,
+// and `general` behaves as the overload without `fmt`.  `hex` is not
+// supported and results in `invalid_argument`.
+//
+// Infinities are written as "inf" and NaNs as "nan", with a leading '-' if
+// the sign bit is set, as it also is for negative zero.
+//
+// This is several times faster than the "%.17g" printf() conversion, and
+// its output is shorter.
+absl::to_chars_result to_chars(char* first, char* last, double value);
+absl::to_chars_result to_chars(char* first, char* last, float value);
+absl::to_chars_result to_chars(char* first, char* last, double value,
+                               chars_format fmt);
+absl::to_chars_result to_chars(char* first, char* last, float value,
+                               chars_format fmt);
+
 // std::chars_format is specified as a bitmask type, which means the following
 // operations must be provided:
 inline constexpr chars_format operator&(chars_format lhs, chars_format rhs) {
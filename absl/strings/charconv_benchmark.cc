@@ -14,9 +14,13 @@
 
 #include "absl/strings/charconv.h"
 
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "benchmark/benchmark.h"
 
@@ -175,6 +179,87 @@ void BM_Absl_Big_And_Difficult(benchmark::State& state) {
 }
 BENCHMARK(BM_Absl_Big_And_Difficult)->Range(3, 5000);
 
+// Doubles with a spread of magnitudes and digit counts, as a JSON encoder
+// sees them.
+std::vector<double> MakeDoubles() {
+  std::vector<double> values;
+  std::mt19937_64 rng(1);
+  std::uniform_real_distribution<double> uniform(-1000, 1000);
+  for (int i = 0; i < 1024; ++i) {
+    double v = uniform(rng);
+    values.push_back(i % 4 == 0 ? std::round(v) : v * std::pow(10, i % 16 - 8));
+  }
+  return values;
+}
+
+void BM_Snprintf_17g(benchmark::State& state) {
+  const std::vector<double> values = MakeDoubles();
+  char buf[32];
+  size_t i = 0;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        snprintf(buf, sizeof(buf), "%.17g", values[i++ % values.size()]));
+  }
+}
+BENCHMARK(BM_Snprintf_17g);
+
+void BM_Absl_ToChars(benchmark::State& state) {
+  const std::vector<double> values = MakeDoubles();
+  char buf[32];
+  size_t i = 0;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        absl::to_chars(buf, buf + sizeof(buf), values[i++ % values.size()]));
+  }
+}
+BENCHMARK(BM_Absl_ToChars);
+
+void BM_Absl_ToChars_float(benchmark::State& state) {
+  const std::vector<double> values = MakeDoubles();
+  char buf[32];
+  size_t i = 0;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(absl::to_chars(
+        buf, buf + sizeof(buf),
+        static_cast<float>(values[i++ % values.size()])));
+  }
+}
+BENCHMARK(BM_Absl_ToChars_float);
+
+// The values of MakeDoubles() printed with 17 significant digits, as a JSON
+// decoder sees them.
+std::vector<std::string> MakeDoubleStrings() {
+  std::vector<std::string> strings;
+  for (double v : MakeDoubles()) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.17g", v);
+    strings.push_back(buf);
+  }
+  return strings;
+}
+
+void BM_Strtod_Doubles(benchmark::State& state) {
+  const std::vector<std::string> strings = MakeDoubleStrings();
+  size_t i = 0;
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        strtod(strings[i++ % strings.size()].c_str(), nullptr));
+  }
+}
+BENCHMARK(BM_Strtod_Doubles);
+
+void BM_Absl_Doubles(benchmark::State& state) {
+  const std::vector<std::string> strings = MakeDoubleStrings();
+  size_t i = 0;
+  for (auto s : state) {
+    const std::string& str = strings[i++ % strings.size()];
+    double v;
+    absl::from_chars(str.data(), str.data() + str.size(), v);
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(BM_Absl_Doubles);
+
 }  // namespace
 
 // ------------------------------------------------------------------------
@@ -14,7 +14,11 @@
 
 #include "absl/strings/charconv.h"
 
+#include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
 #include <string>
 
 #include "gmock/gmock.h"
@@ -571,6 +575,58 @@ TEST(FromChars, TestVersusStrtof) {
   }
 }
 
+// Inputs of more than 19 significant digits are truncated before conversion,
+// and are decided by the fast path only when both ends of the truncation
+// interval round alike.  Check random digit strings of up to 40 digits, most
+// of which hit that path, against strtod().
+TEST(FromChars, LongMantissasVersusStrtod) {
+  std::mt19937_64 rng(48);
+  for (int i = 0; i < 100000; ++i) {
+    std::string candidate;
+    const int digits = 1 + static_cast<int>(rng() % 40);
+    for (int d = 0; d < digits; ++d) {
+      candidate.push_back(static_cast<char>('0' + rng() % 10));
+    }
+    candidate.insert(rng() % candidate.size(), ".");
+    absl::StrAppend(&candidate, "e", static_cast<int>(rng() % 640) - 320);
+    double strtod_value = strtod(candidate.c_str(), nullptr);
+    double absl_value = 0;
+    absl::from_chars_result result = absl::from_chars(
+        candidate.data(), candidate.data() + candidate.size(), absl_value);
+    // Out-of-range results are covered by the Overflow and Underflow tests.
+    if (result.ec != std::errc()) continue;
+    ASSERT_EQ(strtod_value, absl_value) << candidate;
+  }
+}
+
+// Inputs within a few units in the 41st digit of the midpoint between two
+// adjacent doubles are the cases the fast path must hand off to exact
+// arithmetic.  Check them, and the midpoints themselves, against strtod().
+TEST(FromChars, HalfwayCasesVersusStrtod) {
+  std::mt19937_64 rng(2048);
+  for (int i = 0; i < 20000; ++i) {
+    double low;
+    const uint64_t bits = rng() >> 2;
+    std::memcpy(&low, &bits, sizeof(low));
+    const double high = std::nextafter(low, HUGE_VAL);
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%#.40Le",
+             (static_cast<long double>(low) + high) / 2);
+    const absl::string_view text(buf);
+    const absl::string_view digits = text.substr(0, text.find('e'));
+    const absl::string_view exponent = text.substr(digits.size());
+    for (const std::string& candidate :
+         {std::string(text), absl::StrCat(digits, "1", exponent),
+          absl::StrCat(digits.substr(0, digits.size() - 1), exponent)}) {
+      double strtod_value = strtod(candidate.c_str(), nullptr);
+      double absl_value = 0;
+      absl::from_chars(candidate.data(), candidate.data() + candidate.size(),
+                       absl_value);
+      ASSERT_EQ(strtod_value, absl_value) << candidate;
+    }
+  }
+}
+
 // Tests if two floating point values have identical bit layouts.  (EXPECT_EQ
 // is not suitable for NaN testing, since NaNs are never equal.)
 template <typename Float>
@@ -770,4 +826,175 @@ TEST(FromChars, DecimalFloatLimits) {
   TestOverflowAndUnderflow<float>(input_gen, expected_gen, -45, 38);
 }
 
+template <typename Float>
+std::string ToChars(Float value) {
+  char buf[64];
+  absl::to_chars_result result = absl::to_chars(buf, buf + sizeof(buf), value);
+  EXPECT_EQ(result.ec, std::errc());
+  return std::string(buf, result.ptr);
+}
+
+template <typename Float>
+std::string ToChars(Float value, absl::chars_format fmt) {
+  char buf[400];
+  absl::to_chars_result result =
+      absl::to_chars(buf, buf + sizeof(buf), value, fmt);
+  EXPECT_EQ(result.ec, std::errc());
+  return std::string(buf, result.ptr);
+}
+
+TEST(ToChars, Doubles) {
+  EXPECT_EQ(ToChars(0.0), "0");
+  EXPECT_EQ(ToChars(-0.0), "-0");
+  EXPECT_EQ(ToChars(1.0), "1");
+  EXPECT_EQ(ToChars(-1.5), "-1.5");
+  EXPECT_EQ(ToChars(0.1), "0.1");
+  EXPECT_EQ(ToChars(0.3), "0.3");
+  EXPECT_EQ(ToChars(0.1 + 0.2), "0.30000000000000004");
+  EXPECT_EQ(ToChars(123456.0), "123456");
+  EXPECT_EQ(ToChars(1e22), "1e+22");
+  EXPECT_EQ(ToChars(1e23), "1e+23");
+  EXPECT_EQ(ToChars(12e3), "12000");
+  EXPECT_EQ(ToChars(1.2e6), "1200000");
+  EXPECT_EQ(ToChars(1.2e7), "1.2e+07");
+  EXPECT_EQ(ToChars(0.001), "0.001");
+  EXPECT_EQ(ToChars(0.0001), "1e-04");
+  EXPECT_EQ(ToChars(0.00012), "0.00012");
+  EXPECT_EQ(ToChars(9007199254740993.0), "9007199254740992");
+  EXPECT_EQ(ToChars(std::numeric_limits<double>::max()),
+            "1.7976931348623157e+308");
+  EXPECT_EQ(ToChars(std::numeric_limits<double>::min()),
+            "2.2250738585072014e-308");
+  EXPECT_EQ(ToChars(std::numeric_limits<double>::denorm_min()), "5e-324");
+  EXPECT_EQ(ToChars(std::numeric_limits<double>::infinity()), "inf");
+  EXPECT_EQ(ToChars(-std::numeric_limits<double>::infinity()), "-inf");
+  EXPECT_EQ(ToChars(std::numeric_limits<double>::quiet_NaN()), "nan");
+}
+
+TEST(ToChars, Floats) {
+  EXPECT_EQ(ToChars(0.0f), "0");
+  EXPECT_EQ(ToChars(0.1f), "0.1");
+  EXPECT_EQ(ToChars(0.3f), "0.3");
+  EXPECT_EQ(ToChars(16777216.0f), "16777216");
+  EXPECT_EQ(ToChars(16777217.0f), "16777216");
+  EXPECT_EQ(ToChars(1e10f), "1e+10");
+  EXPECT_EQ(ToChars(std::numeric_limits<float>::max()), "3.4028235e+38");
+  EXPECT_EQ(ToChars(std::numeric_limits<float>::min()), "1.1754944e-38");
+  EXPECT_EQ(ToChars(std::numeric_limits<float>::denorm_min()), "1e-45");
+}
+
+TEST(ToChars, Formats) {
+  EXPECT_EQ(ToChars(1e23, absl::chars_format::fixed),
+            "100000000000000000000000");
+  EXPECT_EQ(ToChars(0.0001, absl::chars_format::fixed), "0.0001");
+  EXPECT_EQ(ToChars(123.25, absl::chars_format::fixed), "123.25");
+  EXPECT_EQ(ToChars(5e-324, absl::chars_format::fixed),
+            "0." + std::string(323, '0') + "5");
+  EXPECT_EQ(ToChars(123.25, absl::chars_format::scientific), "1.2325e+02");
+  EXPECT_EQ(ToChars(1.0, absl::chars_format::scientific), "1e+00");
+  EXPECT_EQ(ToChars(0.0, absl::chars_format::scientific), "0e+00");
+  EXPECT_EQ(ToChars(1e-100, absl::chars_format::scientific), "1e-100");
+  EXPECT_EQ(ToChars(0.5f, absl::chars_format::scientific), "5e-01");
+  EXPECT_EQ(ToChars(123.25, absl::chars_format::general), "123.25");
+
+  char buf[8];
+  absl::to_chars_result result =
+      absl::to_chars(buf, buf + sizeof(buf), 1.0, absl::chars_format::hex);
+  EXPECT_EQ(result.ec, std::errc::invalid_argument);
+}
+
+TEST(ToChars, ValueTooLarge) {
+  char buf[8];
+  absl::to_chars_result result = absl::to_chars(buf, buf + 3, 0.125);
+  EXPECT_EQ(result.ec, std::errc::value_too_large);
+  EXPECT_EQ(result.ptr, buf + 3);
+  result = absl::to_chars(buf, buf + 4, -0.25);
+  EXPECT_EQ(result.ec, std::errc::value_too_large);
+  result = absl::to_chars(buf, buf + 5, -0.25);
+  EXPECT_EQ(result.ec, std::errc());
+  EXPECT_EQ(std::string(buf, result.ptr), "-0.25");
+  result = absl::to_chars(buf, buf + 2, -std::numeric_limits<float>::infinity());
+  EXPECT_EQ(result.ec, std::errc::value_too_large);
+}
+
+// Returns the fewest significant digits with which "%.*e" prints a string
+// that strtod() reads back as `value`.
+template <typename Float>
+int FewestPrintfDigits(Float value) {
+  for (int digits = 1;; ++digits) {
+    std::string text = absl::StrFormat("%.*e", digits - 1, value);
+    Float back = 0;
+    absl::from_chars(text.data(), text.data() + text.size(), back);
+    if (back == value) return digits;
+  }
+}
+
+int SignificantDigits(absl::string_view text) {
+  text = text.substr(0, text.find('e'));
+  int digits = 0;
+  bool leading = true;
+  for (char c : text) {
+    if (c == '0' && leading) continue;
+    if (c >= '0' && c <= '9') {
+      ++digits;
+      leading = false;
+    }
+  }
+  // Trailing zeros of an integer are not significant.
+  for (auto it = text.rbegin(); it != text.rend() && *it == '0'; ++it) {
+    if (text.find('.') != absl::string_view::npos) break;
+    --digits;
+  }
+  return digits;
+}
+
+// Checks that random values round-trip through to_chars and from_chars, with
+// no more digits than the shortest printf rendering that does.
+template <typename Float, typename Bits>
+void TestRandomRoundTrips() {
+  std::mt19937_64 rng(2018);
+  for (int i = 0; i < 10000; ++i) {
+    Bits bits = static_cast<Bits>(rng());
+    Float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (!std::isfinite(value)) continue;
+    std::string text = ToChars(value);
+    SCOPED_TRACE(text);
+    Float back = 0;
+    absl::from_chars_result result =
+        absl::from_chars(text.data(), text.data() + text.size(), back);
+    ASSERT_EQ(result.ptr, text.data() + text.size());
+    ASSERT_TRUE(Identical(back, value));
+    if (value != 0) {
+      ASSERT_LE(SignificantDigits(text), FewestPrintfDigits(value));
+    }
+  }
+}
+
+TEST(ToChars, RandomDoublesRoundTrip) {
+  TestRandomRoundTrips<double, uint64_t>();
+}
+
+TEST(ToChars, RandomFloatsRoundTrip) {
+  TestRandomRoundTrips<float, uint32_t>();
+}
+
+// Powers of two are where the rounding interval is lopsided.
+TEST(ToChars, PowersOfTwoRoundTrip) {
+  for (int exp = -1074; exp <= 1023; ++exp) {
+    double value = std::ldexp(1.0, exp);
+    std::string text = ToChars(value);
+    double back = 0;
+    absl::from_chars(text.data(), text.data() + text.size(), back);
+    EXPECT_EQ(back, value) << text;
+  }
+  for (int exp = -149; exp <= 127; ++exp) {
+    float value = std::ldexp(1.0f, exp);
+    std::string text = ToChars(value);
+    float back = 0;
+    absl::from_chars(text.data(), text.data() + text.size(), back);
+    EXPECT_EQ(back, value) << text;
+  }
+}
+
 }  // namespace
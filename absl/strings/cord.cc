@@ -0,0 +1,536 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/cord.h"
+
+#include <cassert>
+#include <new>
+#include <vector>
+
+#include "absl/strings/internal/resize_uninitialized.h"
+
+namespace absl {
+
+namespace cord_internal {
+
+void Destroy(CordRep* rep) {
+  switch (rep->kind) {
+    case CordRepKind::kConcat: {
+      CordRepConcat* concat = rep->concat();
+      Unref(concat->left);
+      Unref(concat->right);
+      delete concat;
+      break;
+    }
+    case CordRepKind::kFlat:
+      rep->flat()->~CordRepFlat();
+      ::operator delete(rep);
+      break;
+    case CordRepKind::kExternal: {
+      CordRepExternal* external = static_cast<CordRepExternal*>(rep);
+      external->release(external);
+      break;
+    }
+    case CordRepKind::kSubstring: {
+      CordRepSubstring* substring = static_cast<CordRepSubstring*>(rep);
+      Unref(substring->child);
+      delete substring;
+      break;
+    }
+  }
+}
+
+}  // namespace cord_internal
+
+namespace {
+
+using cord_internal::CordRep;
+using cord_internal::CordRepConcat;
+using cord_internal::CordRepExternalImpl;
+using cord_internal::CordRepFlat;
+using cord_internal::CordRepKind;
+using cord_internal::CordRepSubstring;
+using cord_internal::Depth;
+using cord_internal::kMaxBytesToCopy;
+using cord_internal::LeafData;
+using cord_internal::Ref;
+using cord_internal::Unref;
+
+// Flats that appends grow into are between these sizes; the largest makes
+// for an allocation of 4 KiB.
+constexpr size_t kMinFlatLength = 32;
+constexpr size_t kMaxFlatLength = 4096 - sizeof(CordRepFlat);
+
+// Trees deeper than this are rebuilt. Appending and prepending keep trees
+// balanced on their own, so this takes mixing the two with concatenating
+// large cords.
+constexpr int kMaxDepth = 48;
+
+bool IsUnique(const CordRep* rep) {
+  return rep->refcount.load(std::memory_order_acquire) == 1;
+}
+
+CordRepFlat* NewFlat(size_t capacity) {
+  void* mem = ::operator new(sizeof(CordRepFlat) + capacity);
+  return new (mem) CordRepFlat(capacity);
+}
+
+CordRep* NewFlat(absl::string_view data, size_t capacity) {
+  assert(capacity >= data.size());
+  CordRepFlat* flat = NewFlat(capacity);
+  std::memcpy(flat->data(), data.data(), data.size());
+  flat->length = data.size();
+  return flat;
+}
+
+CordRep* NewConcat(CordRep* left, CordRep* right) {
+  return new CordRepConcat(
+      left, right, static_cast<uint8_t>(1 + std::max(Depth(left),
+                                                     Depth(right))));
+}
+
+// Copies as much of `data` as fits into the last leaf of `rep`, if that is a
+// flat that only this tree refers to, and returns how much.
+size_t AppendToTailFlat(CordRep* rep, absl::string_view data) {
+  if (!IsUnique(rep)) return 0;
+  size_t n;
+  if (rep->kind == CordRepKind::kConcat) {
+    n = AppendToTailFlat(rep->concat()->right, data);
+  } else if (rep->kind == CordRepKind::kFlat) {
+    CordRepFlat* flat = rep->flat();
+    n = std::min(flat->capacity - flat->length, data.size());
+    std::memcpy(flat->data() + flat->length, data.data(), n);
+  } else {
+    return 0;
+  }
+  rep->length += n;
+  return n;
+}
+
+// Returns the concatenation of `root` and `tree`, taking over both
+// references. While the right subtree of `root` is shallower than its left,
+// `tree` goes into the right subtree instead, so that appending leaves one
+// at a time builds a balanced tree the way a binary counter counts.
+CordRep* AppendToTree(CordRep* root, CordRep* tree) {
+  if (root->kind == CordRepKind::kConcat) {
+    CordRepConcat* concat = root->concat();
+    const int right_depth = Depth(concat->right);
+    if (right_depth < Depth(concat->left) && Depth(tree) <= right_depth) {
+      if (IsUnique(concat)) {
+        concat->right = AppendToTree(concat->right, tree);
+        concat->length = concat->left->length + concat->right->length;
+        concat->depth = static_cast<uint8_t>(
+            1 + std::max(Depth(concat->left), Depth(concat->right)));
+        return concat;
+      }
+      CordRep* left = Ref(concat->left);
+      CordRep* right = AppendToTree(Ref(concat->right), tree);
+      Unref(concat);
+      return NewConcat(left, right);
+    }
+  }
+  return NewConcat(root, tree);
+}
+
+// The mirror image of `AppendToTree()`.
+CordRep* PrependToTree(CordRep* root, CordRep* tree) {
+  if (root->kind == CordRepKind::kConcat) {
+    CordRepConcat* concat = root->concat();
+    const int left_depth = Depth(concat->left);
+    if (left_depth < Depth(concat->right) && Depth(tree) <= left_depth) {
+      if (IsUnique(concat)) {
+        concat->left = PrependToTree(concat->left, tree);
+        concat->length = concat->left->length + concat->right->length;
+        concat->depth = static_cast<uint8_t>(
+            1 + std::max(Depth(concat->left), Depth(concat->right)));
+        return concat;
+      }
+      CordRep* right = Ref(concat->right);
+      CordRep* left = PrependToTree(Ref(concat->left), tree);
+      Unref(concat);
+      return NewConcat(left, right);
+    }
+  }
+  return NewConcat(tree, root);
+}
+
+void CollectLeaves(CordRep* rep, std::vector<CordRep*>* leaves) {
+  if (rep->kind == CordRepKind::kConcat) {
+    CollectLeaves(rep->concat()->left, leaves);
+    CollectLeaves(rep->concat()->right, leaves);
+  } else {
+    leaves->push_back(Ref(rep));
+  }
+}
+
+CordRep* BuildBalanced(CordRep* const* leaves, size_t n) {
+  if (n == 1) return leaves[0];
+  const size_t half = n / 2;
+  return NewConcat(BuildBalanced(leaves, half),
+                   BuildBalanced(leaves + half, n - half));
+}
+
+// Returns a balanced tree with the leaves of `root`, taking over its
+// reference.
+CordRep* Rebalance(CordRep* root) {
+  std::vector<CordRep*> leaves;
+  CollectLeaves(root, &leaves);
+  Unref(root);
+  return BuildBalanced(leaves.data(), leaves.size());
+}
+
+// Returns a new reference to the `n` bytes of `rep` at `pos`, sharing its
+// leaves. The range must be non-empty and within `rep`.
+CordRep* NewSubRange(CordRep* rep, size_t pos, size_t n) {
+  assert(n > 0 && pos + n <= rep->length);
+  if (pos == 0 && n == rep->length) return Ref(rep);
+  switch (rep->kind) {
+    case CordRepKind::kConcat: {
+      CordRepConcat* concat = rep->concat();
+      const size_t left_length = concat->left->length;
+      if (pos + n <= left_length) return NewSubRange(concat->left, pos, n);
+      if (pos >= left_length) {
+        return NewSubRange(concat->right, pos - left_length, n);
+      }
+      CordRep* left = NewSubRange(concat->left, pos, left_length - pos);
+      CordRep* right = NewSubRange(concat->right, 0, n - (left_length - pos));
+      return NewConcat(left, right);
+    }
+    case CordRepKind::kSubstring: {
+      CordRepSubstring* substring = static_cast<CordRepSubstring*>(rep);
+      return new CordRepSubstring(Ref(substring->child),
+                                  substring->start + pos, n);
+    }
+    case CordRepKind::kFlat:
+    case CordRepKind::kExternal:
+      break;
+  }
+  return new CordRepSubstring(Ref(rep), pos, n);
+}
+
+// Copies the contents of `cord`, which are at most `kMaxBytesToCopy` bytes,
+// into `buffer` and returns them.
+absl::string_view CopyShortCord(const Cord& cord, char* buffer) {
+  assert(cord.size() <= kMaxBytesToCopy);
+  char* out = buffer;
+  for (absl::string_view chunk : cord.Chunks()) {
+    std::memcpy(out, chunk.data(), chunk.size());
+    out += chunk.size();
+  }
+  return absl::string_view(buffer, out - buffer);
+}
+
+// Returns true if the bytes of `cord` at `pos` are `s`.
+bool MatchesAt(const Cord& cord, size_t pos, absl::string_view s) {
+  for (absl::string_view chunk : cord.Chunks()) {
+    if (s.empty()) break;
+    if (pos >= chunk.size()) {
+      pos -= chunk.size();
+      continue;
+    }
+    chunk.remove_prefix(pos);
+    pos = 0;
+    const size_t n = std::min(chunk.size(), s.size());
+    if (std::memcmp(chunk.data(), s.data(), n) != 0) return false;
+    s.remove_prefix(n);
+  }
+  return s.empty();
+}
+
+}  // namespace
+
+constexpr size_t Cord::kHashBlockSize;
+
+Cord::Cord(absl::string_view src)
+    : root_(src.empty() ? nullptr : NewFlat(src, src.size())) {}
+
+Cord::Cord(const Cord& src) : root_(src.root_) {
+  if (root_ != nullptr) Ref(root_);
+}
+
+Cord& Cord::operator=(const Cord& src) {
+  if (src.root_ != nullptr) Ref(src.root_);
+  if (root_ != nullptr) Unref(root_);
+  root_ = src.root_;
+  return *this;
+}
+
+Cord& Cord::operator=(Cord&& src) noexcept {
+  if (this != &src) {
+    Clear();
+    swap(src);
+  }
+  return *this;
+}
+
+Cord& Cord::operator=(absl::string_view src) {
+  // `src` may be part of this cord, so it is copied before the old contents
+  // are released.
+  Cord copy(src);
+  swap(copy);
+  return *this;
+}
+
+void Cord::Clear() {
+  if (root_ != nullptr) {
+    Unref(root_);
+    root_ = nullptr;
+  }
+}
+
+void Cord::AppendTree(CordRep* tree) {
+  if (root_ == nullptr) {
+    root_ = tree;
+    return;
+  }
+  root_ = AppendToTree(root_, tree);
+  if (Depth(root_) > kMaxDepth) root_ = Rebalance(root_);
+}
+
+void Cord::PrependTree(CordRep* tree) {
+  if (root_ == nullptr) {
+    root_ = tree;
+    return;
+  }
+  root_ = PrependToTree(root_, tree);
+  if (Depth(root_) > kMaxDepth) root_ = Rebalance(root_);
+}
+
+void Cord::Append(absl::string_view src) {
+  if (src.empty()) return;
+  if (root_ != nullptr) {
+    src.remove_prefix(AppendToTailFlat(root_, src));
+    if (src.empty()) return;
+  }
+  // The new flat has room to grow with the cord, as a string's buffer would,
+  // up to the largest flat.
+  const size_t capacity = std::max(
+      src.size(), std::min(kMaxFlatLength, std::max(kMinFlatLength, size())));
+  AppendTree(NewFlat(src, capacity));
+}
+
+void Cord::Append(const Cord& src) {
+  if (src.empty()) return;
+  if (empty()) {
+    *this = src;
+    return;
+  }
+  if (src.size() <= kMaxBytesToCopy) {
+    // A short cord is copied rather than shared, so that appending many of
+    // them does not make a tree of tiny leaves. It goes through a buffer
+    // since `src` may be this cord.
+    char buffer[kMaxBytesToCopy];
+    Append(CopyShortCord(src, buffer));
+    return;
+  }
+  AppendTree(Ref(src.root_));
+}
+
+void Cord::Append(Cord&& src) {
+  if (empty()) {
+    swap(src);
+    return;
+  }
+  if (src.size() <= kMaxBytesToCopy || this == &src) {
+    Append(static_cast<const Cord&>(src));
+    return;
+  }
+  AppendTree(src.root_);
+  src.root_ = nullptr;
+}
+
+void Cord::AppendString(std::string&& src) {
+  using Impl = CordRepExternalImpl<cord_internal::StringReleaser>;
+  Impl* rep = new Impl(absl::string_view(),
+                       cord_internal::StringReleaser{std::move(src)});
+  // The string has moved into the node, so its bytes are found there.
+  rep->base = rep->releaser.data.data();
+  rep->length = rep->releaser.data.size();
+  AppendTree(rep);
+}
+
+void Cord::Prepend(absl::string_view src) {
+  if (src.empty()) return;
+  PrependTree(NewFlat(src, src.size()));
+}
+
+void Cord::Prepend(const Cord& src) {
+  if (src.empty()) return;
+  if (empty()) {
+    *this = src;
+    return;
+  }
+  if (src.size() <= kMaxBytesToCopy) {
+    char buffer[kMaxBytesToCopy];
+    Prepend(CopyShortCord(src, buffer));
+    return;
+  }
+  PrependTree(Ref(src.root_));
+}
+
+void Cord::RemovePrefix(size_t n) {
+  assert(n <= size());
+  if (n == 0) return;
+  if (n == size()) {
+    Clear();
+    return;
+  }
+  CordRep* rest = NewSubRange(root_, n, size() - n);
+  Unref(root_);
+  root_ = rest;
+}
+
+void Cord::RemoveSuffix(size_t n) {
+  assert(n <= size());
+  if (n == 0) return;
+  if (n == size()) {
+    Clear();
+    return;
+  }
+  CordRep* rest = NewSubRange(root_, 0, size() - n);
+  Unref(root_);
+  root_ = rest;
+}
+
+Cord Cord::Subcord(size_t pos, size_t new_size) const {
+  if (pos >= size()) return Cord();
+  new_size = std::min(new_size, size() - pos);
+  if (new_size == 0) return Cord();
+  return Cord(NewSubRange(root_, pos, new_size));
+}
+
+char Cord::operator[](size_t i) const {
+  assert(i < size());
+  const CordRep* rep = root_;
+  while (rep->kind == CordRepKind::kConcat) {
+    const CordRepConcat* concat = rep->concat();
+    if (i < concat->left->length) {
+      rep = concat->left;
+    } else {
+      i -= concat->left->length;
+      rep = concat->right;
+    }
+  }
+  return LeafData(rep)[i];
+}
+
+absl::string_view Cord::Flatten() {
+  absl::string_view flat;
+  if (TryFlat(&flat)) return flat;
+  const size_t length = size();
+  CordRepFlat* rep = NewFlat(length);
+  char* out = rep->data();
+  for (absl::string_view chunk : Chunks()) {
+    std::memcpy(out, chunk.data(), chunk.size());
+    out += chunk.size();
+  }
+  rep->length = length;
+  Unref(root_);
+  root_ = rep;
+  return LeafData(rep);
+}
+
+bool Cord::TryFlat(absl::string_view* chunk) const {
+  if (root_ == nullptr) {
+    *chunk = absl::string_view();
+    return true;
+  }
+  if (root_->kind == CordRepKind::kConcat) return false;
+  *chunk = LeafData(root_);
+  return true;
+}
+
+Cord::operator std::string() const {
+  std::string result;
+  strings_internal::STLStringResizeUninitialized(&result, size());
+  char* out = &result[0];
+  for (absl::string_view chunk : Chunks()) {
+    std::memcpy(out, chunk.data(), chunk.size());
+    out += chunk.size();
+  }
+  return result;
+}
+
+int Cord::Compare(absl::string_view rhs) const {
+  for (absl::string_view chunk : Chunks()) {
+    const size_t n = std::min(chunk.size(), rhs.size());
+    if (n != 0) {
+      const int result = std::memcmp(chunk.data(), rhs.data(), n);
+      if (result != 0) return result;
+    }
+    if (n < chunk.size()) return 1;
+    rhs.remove_prefix(n);
+  }
+  return rhs.empty() ? 0 : -1;
+}
+
+int Cord::Compare(const Cord& rhs) const {
+  if (root_ == rhs.root_) return 0;
+  ChunkIterator lhs_it = chunk_begin();
+  ChunkIterator rhs_it = rhs.chunk_begin();
+  absl::string_view lhs_chunk;
+  absl::string_view rhs_chunk;
+  for (;;) {
+    // Chunks are never empty, so an empty one means the cord is exhausted.
+    if (lhs_chunk.empty() && lhs_it != chunk_end()) lhs_chunk = *lhs_it++;
+    if (rhs_chunk.empty() && rhs_it != rhs.chunk_end()) rhs_chunk = *rhs_it++;
+    if (lhs_chunk.empty() || rhs_chunk.empty()) {
+      return static_cast<int>(!lhs_chunk.empty()) -
+             static_cast<int>(!rhs_chunk.empty());
+    }
+    const size_t n = std::min(lhs_chunk.size(), rhs_chunk.size());
+    const int result = std::memcmp(lhs_chunk.data(), rhs_chunk.data(), n);
+    if (result != 0) return result;
+    lhs_chunk.remove_prefix(n);
+    rhs_chunk.remove_prefix(n);
+  }
+}
+
+bool Cord::StartsWith(absl::string_view prefix) const {
+  return prefix.size() <= size() && MatchesAt(*this, 0, prefix);
+}
+
+bool Cord::EndsWith(absl::string_view suffix) const {
+  return suffix.size() <= size() &&
+         MatchesAt(*this, size() - suffix.size(), suffix);
+}
+
+Cord::ChunkIterator::ChunkIterator(const CordRep* root) {
+  if (root == nullptr) return;
+  bytes_remaining_ = root->length;
+  PushLeftmostLeaf(root);
+}
+
+void Cord::ChunkIterator::PushLeftmostLeaf(const CordRep* node) {
+  while (node->kind == CordRepKind::kConcat) {
+    stack_.push_back(node->concat()->right);
+    node = node->concat()->left;
+  }
+  current_chunk_ = LeafData(node);
+}
+
+Cord::ChunkIterator& Cord::ChunkIterator::operator++() {
+  assert(bytes_remaining_ >= current_chunk_.size());
+  bytes_remaining_ -= current_chunk_.size();
+  if (stack_.empty()) {
+    current_chunk_ = absl::string_view();
+  } else {
+    const CordRep* next = stack_.back();
+    stack_.pop_back();
+    PushLeftmostLeaf(next);
+  }
+  return *this;
+}
+
+}  // namespace absl
@@ -0,0 +1,399 @@
+//
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: cord.h
+// -----------------------------------------------------------------------------
+//
+// This header file contains `absl::Cord`, a string of bytes held in a tree of
+// reference-counted chunks. Copying a `Cord`, appending or prepending one
+// `Cord` to another, and taking a substring share the chunks rather than
+// copying their bytes, so that large buffers can be passed through layers of
+// a program, framed and split, without being copied.
+//
+// The chunks of a `Cord` are not contiguous in general. They can be visited
+// as `absl::string_view`s with `Cord::Chunks()`, or copied into one with
+// `Cord::Flatten()` or into a `std::string`.
+//
+// Memory owned elsewhere can become a chunk without a copy through
+// `absl::MakeCordFromExternal()`, which hands it back to a releaser once the
+// last `Cord` that refers to it is gone.
+//
+// Example:
+//
+//   absl::Cord body = absl::MakeCordFromExternal(
+//       payload, [buffer](absl::string_view) { buffer->Unref(); });
+//   absl::Cord message(header);
+//   message.Append(body);  // Shares `body` rather than copying it.
+//   for (absl::string_view chunk : message.Chunks()) {
+//     Write(chunk);
+//   }
+//
+// A `Cord` may be read from several threads at once, as `std::string` may;
+// the chunks it shares with other cords can be, in any case.
+
+#ifndef ABSL_STRINGS_CORD_H_
+#define ABSL_STRINGS_CORD_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/internal/cord_internal.h"
+#include "absl/strings/string_view.h"
+
+namespace absl {
+
+class Cord;
+template <typename Releaser>
+Cord MakeCordFromExternal(absl::string_view data, Releaser&& releaser);
+
+// Cord
+class Cord {
+ private:
+  template <typename T>
+  using EnableIfString =
+      typename std::enable_if<std::is_same<T, std::string>::value, int>::type;
+
+ public:
+  // Creates an empty cord.
+  constexpr Cord() noexcept : root_(nullptr) {}
+
+  // Creates a cord holding a copy of `src`.
+  explicit Cord(absl::string_view src);
+
+  // Creates a cord that takes over `src`. Long strings become a chunk of
+  // their own instead of being copied.
+  template <typename T, EnableIfString<T> = 0>
+  explicit Cord(T&& src);
+
+  Cord(const Cord& src);
+  Cord(Cord&& src) noexcept : root_(src.root_) { src.root_ = nullptr; }
+  Cord& operator=(const Cord& src);
+  Cord& operator=(Cord&& src) noexcept;
+  Cord& operator=(absl::string_view src);
+  ~Cord() {
+    if (root_ != nullptr) cord_internal::Unref(root_);
+  }
+
+  void swap(Cord& other) noexcept { std::swap(root_, other.root_); }
+  friend void swap(Cord& a, Cord& b) noexcept { a.swap(b); }
+
+  size_t size() const { return root_ == nullptr ? 0 : root_->length; }
+  bool empty() const { return root_ == nullptr; }
+
+  void Clear();
+
+  // Cord::Append()
+  //
+  // Appends to the end of the cord. Appending a cord shares its chunks, in
+  // O(log n) time, unless it is short enough that copying its bytes is
+  // cheaper. Appended bytes fill the spare capacity of the last chunk when it
+  // is not shared, and otherwise go into a new chunk.
+  void Append(const Cord& src);
+  void Append(Cord&& src);
+  void Append(absl::string_view src);
+  template <typename T, EnableIfString<T> = 0>
+  void Append(T&& src);
+
+  // Cord::Prepend()
+  //
+  // Prepends to the beginning of the cord, sharing the chunks of a cord as
+  // `Append()` does. Prepended bytes always go into a new chunk.
+  void Prepend(const Cord& src);
+  void Prepend(absl::string_view src);
+
+  // Removes the first or last `n` bytes, which must not be more than
+  // `size()`. The chunks that remain partly in the cord are shared.
+  void RemovePrefix(size_t n);
+  void RemoveSuffix(size_t n);
+
+  // Cord::Subcord()
+  //
+  // Returns the `new_size` bytes starting at `pos`, sharing the chunks of
+  // this cord. The range is clamped to the end of the cord.
+  Cord Subcord(size_t pos, size_t new_size) const;
+
+  // Returns the byte at index `i`, which must be less than `size()`. This
+  // walks the tree; iterate over `Chunks()` to visit many bytes.
+  char operator[](size_t i) const;
+
+  // Cord::Flatten()
+  //
+  // Returns the contents as one `absl::string_view`, copying them into a
+  // single chunk unless they already are one. The result is valid until the
+  // cord is next changed.
+  absl::string_view Flatten();
+
+  // Returns true, and sets `*chunk` to the contents, if they are a single
+  // chunk; an empty cord is one empty chunk.
+  bool TryFlat(absl::string_view* chunk) const;
+
+  explicit operator std::string() const;
+
+  // Cord::Compare()
+  //
+  // Compares the contents bytewise, returning a negative value, zero or a
+  // positive value as `absl::string_view::compare()` does.
+  int Compare(absl::string_view rhs) const;
+  int Compare(const Cord& rhs) const;
+
+  bool StartsWith(absl::string_view prefix) const;
+  bool EndsWith(absl::string_view suffix) const;
+
+  // Cord::ChunkIterator
+  //
+  // An input iterator over the chunks of a cord, as `absl::string_view`s,
+  // none of them empty. Changing the cord invalidates it.
+  class ChunkIterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = absl::string_view;
+    using difference_type = ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = value_type;
+
+    ChunkIterator() = default;
+
+    ChunkIterator& operator++();
+    ChunkIterator operator++(int) {
+      ChunkIterator tmp(*this);
+      operator++();
+      return tmp;
+    }
+    // Iterators into the same cord are equal if they are at the same offset.
+    bool operator==(const ChunkIterator& other) const {
+      return bytes_remaining_ == other.bytes_remaining_;
+    }
+    bool operator!=(const ChunkIterator& other) const {
+      return !(*this == other);
+    }
+    reference operator*() const { return current_chunk_; }
+    pointer operator->() const { return &current_chunk_; }
+
+   private:
+    friend class Cord;
+
+    explicit ChunkIterator(const cord_internal::CordRep* root);
+
+    // Descends from `node` to its leftmost leaf, keeping the right subtrees
+    // on the way to visit later.
+    void PushLeftmostLeaf(const cord_internal::CordRep* node);
+
+    absl::string_view current_chunk_;
+    size_t bytes_remaining_ = 0;
+    // The subtrees still to visit, the next one last.
+    absl::InlinedVector<const cord_internal::CordRep*, 8> stack_;
+  };
+
+  ChunkIterator chunk_begin() const { return ChunkIterator(root_); }
+  ChunkIterator chunk_end() const { return ChunkIterator(); }
+
+  // Cord::ChunkRange
+  //
+  // The chunks of a cord, for use in a range-based for loop:
+  //
+  //   for (absl::string_view chunk : cord.Chunks()) { ... }
+  class ChunkRange {
+   public:
+    explicit ChunkRange(const Cord* cord) : cord_(cord) {}
+    ChunkIterator begin() const { return cord_->chunk_begin(); }
+    ChunkIterator end() const { return cord_->chunk_end(); }
+
+   private:
+    const Cord* cord_;
+  };
+
+  ChunkRange Chunks() const { return ChunkRange(this); }
+
+  // Hashes the contents such that equal cords hash equally, however their
+  // bytes are split into chunks.
+  template <typename H>
+  friend H AbslHashValue(H hash_state, const Cord& cord) {
+    return cord.HashContents(std::move(hash_state));
+  }
+
+ private:
+  template <typename Releaser>
+  friend Cord MakeCordFromExternal(absl::string_view data,
+                                   Releaser&& releaser);
+
+  // The size of the blocks that the contents are hashed in. Hashing a chunk
+  // at a time would make the hash depend on where the chunks begin.
+  static constexpr size_t kHashBlockSize = 1024;
+
+  explicit Cord(cord_internal::CordRep* root) : root_(root) {}
+
+  // Appends or prepends `tree`, taking over its reference.
+  void AppendTree(cord_internal::CordRep* tree);
+  void PrependTree(cord_internal::CordRep* tree);
+
+  // Appends a string of at least `kMaxBytesToCopy` bytes as a chunk.
+  void AppendString(std::string&& src);
+
+  template <typename H>
+  H HashContents(H hash_state) const;
+
+  // The tree, or null if the cord is empty. Every node in it is non-empty.
+  cord_internal::CordRep* root_;
+};
+
+// MakeCordFromExternal()
+//
+// Creates a cord whose only chunk is `data`, without copying it. `data` must
+// remain valid until `releaser` is invoked, once, when no cord refers to it
+// any more; this may be right away if `data` is empty. `releaser` is a
+// movable callable that takes either no arguments or an `absl::string_view`
+// of `data`.
+//
+// Example:
+//
+//   std::string* buffer = ReadRequestBody();
+//   absl::Cord body = absl::MakeCordFromExternal(
+//       *buffer, [buffer] { delete buffer; });
+template <typename Releaser>
+Cord MakeCordFromExternal(absl::string_view data, Releaser&& releaser) {
+  using Impl = cord_internal::CordRepExternalImpl<
+      typename std::decay<Releaser>::type>;
+  Impl* rep = new Impl(data, std::forward<Releaser>(releaser));
+  if (data.empty()) {
+    Impl::Release(rep);
+    return Cord();
+  }
+  return Cord(rep);
+}
+
+namespace cord_internal {
+
+// Strings at least this long are adopted by a cord rather than copied.
+constexpr size_t kMaxBytesToCopy = 511;
+
+// The releaser of the chunk that a cord makes out of a `std::string`.
+struct StringReleaser {
+  void operator()() const {}
+  std::string data;
+};
+
+}  // namespace cord_internal
+
+template <typename T, Cord::EnableIfString<T>>
+Cord::Cord(T&& src) : root_(nullptr) {
+  if (src.size() <= cord_internal::kMaxBytesToCopy) {
+    *this = Cord(absl::string_view(src));
+  } else {
+    AppendString(std::move(src));
+  }
+}
+
+template <typename T, Cord::EnableIfString<T>>
+void Cord::Append(T&& src) {
+  if (src.size() <= cord_internal::kMaxBytesToCopy) {
+    Append(absl::string_view(src));
+  } else {
+    AppendString(std::move(src));
+  }
+}
+
+template <typename H>
+H Cord::HashContents(H hash_state) const {
+  char block[kHashBlockSize];
+  size_t filled = 0;
+  for (absl::string_view chunk : Chunks()) {
+    while (!chunk.empty()) {
+      if (filled == 0 && chunk.size() >= kHashBlockSize) {
+        // A whole block within the chunk is hashed where it is.
+        hash_state = H::combine_contiguous(std::move(hash_state),
+                                           chunk.data(), kHashBlockSize);
+        chunk.remove_prefix(kHashBlockSize);
+        continue;
+      }
+      const size_t n = std::min(chunk.size(), kHashBlockSize - filled);
+      std::memcpy(block + filled, chunk.data(), n);
+      filled += n;
+      chunk.remove_prefix(n);
+      if (filled == kHashBlockSize) {
+        hash_state =
+            H::combine_contiguous(std::move(hash_state), block, filled);
+        filled = 0;
+      }
+    }
+  }
+  hash_state = H::combine_contiguous(std::move(hash_state), block, filled);
+  return H::combine(std::move(hash_state), size());
+}
+
+// Comparisons, with each other and with anything that converts to
+// `absl::string_view`.
+inline bool operator==(const Cord& lhs, const Cord& rhs) {
+  return lhs.size() == rhs.size() && lhs.Compare(rhs) == 0;
+}
+inline bool operator==(const Cord& lhs, absl::string_view rhs) {
+  return lhs.size() == rhs.size() && lhs.Compare(rhs) == 0;
+}
+inline bool operator==(absl::string_view lhs, const Cord& rhs) {
+  return rhs == lhs;
+}
+inline bool operator!=(const Cord& lhs, const Cord& rhs) {
+  return !(lhs == rhs);
+}
+inline bool operator!=(const Cord& lhs, absl::string_view rhs) {
+  return !(lhs == rhs);
+}
+inline bool operator!=(absl::string_view lhs, const Cord& rhs) {
+  return !(lhs == rhs);
+}
+inline bool operator<(const Cord& lhs, const Cord& rhs) {
+  return lhs.Compare(rhs) < 0;
+}
+inline bool operator<(const Cord& lhs, absl::string_view rhs) {
+  return lhs.Compare(rhs) < 0;
+}
+inline bool operator<(absl::string_view lhs, const Cord& rhs) {
+  return rhs.Compare(lhs) > 0;
+}
+inline bool operator>(const Cord& lhs, const Cord& rhs) { return rhs < lhs; }
+inline bool operator>(const Cord& lhs, absl::string_view rhs) {
+  return rhs < lhs;
+}
+inline bool operator>(absl::string_view lhs, const Cord& rhs) {
+  return rhs < lhs;
+}
+inline bool operator<=(const Cord& lhs, const Cord& rhs) {
+  return !(rhs < lhs);
+}
+inline bool operator<=(const Cord& lhs, absl::string_view rhs) {
+  return !(rhs < lhs);
+}
+inline bool operator<=(absl::string_view lhs, const Cord& rhs) {
+  return !(rhs < lhs);
+}
+inline bool operator>=(const Cord& lhs, const Cord& rhs) {
+  return !(lhs < rhs);
+}
+inline bool operator>=(const Cord& lhs, absl::string_view rhs) {
+  return !(lhs < rhs);
+}
+inline bool operator>=(absl::string_view lhs, const Cord& rhs) {
+  return !(lhs < rhs);
+}
+
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_CORD_H_
@@ -0,0 +1,103 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+namespace {
+
+// Frames a payload of `state.range(0)` bytes with a header and a trailer, as
+// an RPC layer does with a request body.
+void BM_FrameStrCat(benchmark::State& state) {
+  const std::string body(state.range(0), 'x');
+  for (auto _ : state) {
+    std::string message = absl::StrCat("header:", body.size(), "\n", body,
+                                       "\ntrailer");
+    benchmark::DoNotOptimize(message);
+  }
+  state.SetBytesProcessed(state.iterations() * body.size());
+}
+BENCHMARK(BM_FrameStrCat)->Arg(1 << 10)->Arg(1 << 16)->Arg(4 << 20);
+
+void BM_FrameCord(benchmark::State& state) {
+  const absl::Cord body(std::string(state.range(0), 'x'));
+  for (auto _ : state) {
+    absl::Cord message(absl::StrCat("header:", body.size(), "\n"));
+    message.Append(body);
+    message.Append("\ntrailer");
+    benchmark::DoNotOptimize(message);
+  }
+  state.SetBytesProcessed(state.iterations() * body.size());
+}
+BENCHMARK(BM_FrameCord)->Arg(1 << 10)->Arg(1 << 16)->Arg(4 << 20);
+
+// Appends `state.range(0)` bytes 16 at a time.
+void BM_SmallAppendsString(benchmark::State& state) {
+  const absl::string_view piece("0123456789abcdef");
+  for (auto _ : state) {
+    std::string s;
+    for (int64_t i = 0; i < state.range(0); i += piece.size()) {
+      s.append(piece.data(), piece.size());
+    }
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SmallAppendsString)->Arg(1 << 10)->Arg(1 << 20);
+
+void BM_SmallAppendsCord(benchmark::State& state) {
+  const absl::string_view piece("0123456789abcdef");
+  for (auto _ : state) {
+    absl::Cord cord;
+    for (int64_t i = 0; i < state.range(0); i += piece.size()) {
+      cord.Append(piece);
+    }
+    benchmark::DoNotOptimize(cord);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SmallAppendsCord)->Arg(1 << 10)->Arg(1 << 20);
+
+// Splits a large cord into 4 KiB subcords, as a reader of a stream does.
+void BM_SubcordSplit(benchmark::State& state) {
+  absl::Cord cord;
+  for (int i = 0; i < 256; ++i) cord.Append(std::string(16 << 10, 'x'));
+  for (auto _ : state) {
+    for (size_t pos = 0; pos < cord.size(); pos += 4096) {
+      benchmark::DoNotOptimize(cord.Subcord(pos, 4096));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * cord.size());
+}
+BENCHMARK(BM_SubcordSplit);
+
+void BM_IterateChunks(benchmark::State& state) {
+  absl::Cord cord;
+  for (int i = 0; i < state.range(0); ++i) {
+    cord.Append(std::string(1024, 'x'));
+  }
+  for (auto _ : state) {
+    size_t total = 0;
+    for (absl::string_view chunk : cord.Chunks()) total += chunk.size();
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IterateChunks)->Arg(16)->Arg(4096);
+
+}  // namespace
@@ -0,0 +1,374 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/cord.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/hash/hash.h"
+#include "absl/hash/hash_testing.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+
+namespace {
+
+using ::testing::ElementsAre;
+
+std::vector<std::string> ChunksOf(const absl::Cord& cord) {
+  std::vector<std::string> chunks;
+  for (absl::string_view chunk : cord.Chunks()) chunks.emplace_back(chunk);
+  return chunks;
+}
+
+// A cord made by appending `pieces`. Each is a chunk of its own, unless it is
+// short enough to be copied into the chunk before.
+absl::Cord MakeFragmented(const std::vector<std::string>& pieces) {
+  absl::Cord cord;
+  for (const std::string& piece : pieces) {
+    std::string* owned = new std::string(piece);
+    cord.Append(absl::MakeCordFromExternal(*owned, [owned] { delete owned; }));
+  }
+  return cord;
+}
+
+// Text long enough that cords of it are shared rather than copied.
+std::string LongText(char c, size_t n = 1000) {
+  std::string text;
+  for (size_t i = 0; i < n; ++i) text += static_cast<char>(c + i % 7);
+  return text;
+}
+
+TEST(Cord, Empty) {
+  absl::Cord cord;
+  EXPECT_TRUE(cord.empty());
+  EXPECT_EQ(0, cord.size());
+  EXPECT_EQ("", std::string(cord));
+  EXPECT_EQ(cord.chunk_begin(), cord.chunk_end());
+  EXPECT_EQ("", cord.Flatten());
+  EXPECT_TRUE(absl::Cord("").empty());
+}
+
+TEST(Cord, FromString) {
+  const absl::Cord cord("hello");
+  EXPECT_EQ(5, cord.size());
+  EXPECT_EQ("hello", std::string(cord));
+  EXPECT_THAT(ChunksOf(cord), ElementsAre("hello"));
+}
+
+TEST(Cord, AdoptsLongStrings) {
+  std::string long_string = LongText('a');
+  const char* data = long_string.data();
+  const absl::Cord cord(std::move(long_string));
+  absl::string_view flat;
+  ASSERT_TRUE(cord.TryFlat(&flat));
+  EXPECT_EQ(data, flat.data());
+  EXPECT_EQ(LongText('a'), flat);
+
+  absl::Cord appended("x");
+  std::string other = LongText('b');
+  data = other.data();
+  appended.Append(std::move(other));
+  std::vector<absl::string_view> chunks(appended.chunk_begin(),
+                                        appended.chunk_end());
+  ASSERT_EQ(2, chunks.size());
+  EXPECT_EQ(data, chunks[1].data());
+  EXPECT_EQ(absl::StrCat("x", LongText('b')), std::string(appended));
+}
+
+TEST(Cord, AppendAndPrependStrings) {
+  absl::Cord cord;
+  std::string expected;
+  for (int i = 0; i < 1000; ++i) {
+    const std::string piece = absl::StrCat(i, ",");
+    if (i % 3 == 0) {
+      cord.Prepend(piece);
+      expected.insert(0, piece);
+    } else {
+      cord.Append(piece);
+      expected.append(piece);
+    }
+  }
+  EXPECT_EQ(expected.size(), cord.size());
+  EXPECT_EQ(expected, std::string(cord));
+}
+
+TEST(Cord, SmallAppendsFillChunks) {
+  absl::Cord cord;
+  for (int i = 0; i < 10000; ++i) cord.Append("x");
+  EXPECT_EQ(std::string(10000, 'x'), std::string(cord));
+  // Bytes go into the spare room of the last chunk rather than a chunk each.
+  EXPECT_LT(ChunksOf(cord).size(), 16);
+}
+
+TEST(Cord, AppendSharesChunks) {
+  const std::string a = LongText('a');
+  const std::string b = LongText('b');
+  const absl::Cord ca = absl::MakeCordFromExternal(a, [] {});
+  const absl::Cord cb = absl::MakeCordFromExternal(b, [] {});
+  absl::Cord cord = ca;
+  cord.Append(cb);
+  cord.Prepend(cb);
+  std::vector<absl::string_view> chunks(cord.chunk_begin(), cord.chunk_end());
+  ASSERT_EQ(3, chunks.size());
+  EXPECT_EQ(b.data(), chunks[0].data());
+  EXPECT_EQ(a.data(), chunks[1].data());
+  EXPECT_EQ(b.data(), chunks[2].data());
+  // The sources are unchanged.
+  EXPECT_EQ(a, std::string(ca));
+  EXPECT_EQ(b, std::string(cb));
+}
+
+TEST(Cord, AppendDoesNotChangeSharedChunks) {
+  absl::Cord a("abc");
+  absl::Cord b = a;
+  a.Append("def");
+  b.Append("xyz");
+  EXPECT_EQ("abcdef", std::string(a));
+  EXPECT_EQ("abcxyz", std::string(b));
+
+  // A shared subtree, as well as a shared chunk.
+  absl::Cord tree = MakeFragmented({LongText('a'), LongText('b')});
+  tree.Append("tail");
+  absl::Cord copy = tree;
+  tree.Append("1");
+  copy.Append("2");
+  EXPECT_TRUE(tree.EndsWith("tail1"));
+  EXPECT_TRUE(copy.EndsWith("tail2"));
+  EXPECT_EQ(tree.size(), copy.size());
+}
+
+TEST(Cord, AppendSelf) {
+  absl::Cord cord("ab");
+  cord.Append(cord);
+  EXPECT_EQ("abab", std::string(cord));
+  absl::Cord long_cord(LongText('a'));
+  long_cord.Append(long_cord);
+  long_cord.Prepend(long_cord);
+  EXPECT_EQ(absl::StrCat(LongText('a'), LongText('a'), LongText('a'),
+                         LongText('a')),
+            std::string(long_cord));
+  cord.Append(std::move(cord));
+  EXPECT_EQ("abababab", std::string(cord));
+}
+
+TEST(Cord, AppendMoved) {
+  absl::Cord cord("a");
+  absl::Cord other(LongText('b'));
+  cord.Append(std::move(other));
+  EXPECT_EQ(absl::StrCat("a", LongText('b')), std::string(cord));
+}
+
+TEST(Cord, Subcord) {
+  std::vector<std::string> pieces;
+  std::string expected;
+  for (int i = 0; i < 50; ++i) {
+    pieces.push_back(LongText('a' + i % 20, 600 + i));
+    expected += pieces.back();
+  }
+  const absl::Cord cord = MakeFragmented(pieces);
+  ASSERT_EQ(expected, std::string(cord));
+  for (size_t pos = 0; pos <= expected.size(); pos += 37) {
+    for (size_t n : {size_t{0}, size_t{1}, size_t{9}, size_t{100},
+                     size_t{1000}, expected.size()}) {
+      const absl::Cord sub = cord.Subcord(pos, n);
+      EXPECT_EQ(expected.substr(pos, n), std::string(sub))
+          << pos << " " << n;
+      // Subcords of subcords.
+      if (sub.size() >= 3) {
+        EXPECT_EQ(expected.substr(pos, n).substr(3, 50),
+                  std::string(sub.Subcord(3, 50)));
+      }
+    }
+  }
+  EXPECT_TRUE(cord.Subcord(expected.size() + 1, 10).empty());
+}
+
+TEST(Cord, SubcordSharesChunks) {
+  const std::string text = LongText('a');
+  const absl::Cord cord = absl::MakeCordFromExternal(text, [] {});
+  const absl::Cord sub = cord.Subcord(100, 200);
+  absl::string_view flat;
+  ASSERT_TRUE(sub.TryFlat(&flat));
+  EXPECT_EQ(text.data() + 100, flat.data());
+  EXPECT_EQ(200, flat.size());
+}
+
+TEST(Cord, RemovePrefixAndSuffix) {
+  absl::Cord cord = MakeFragmented({"abc", "defg", "hi"});
+  cord.RemovePrefix(2);
+  EXPECT_EQ("cdefghi", std::string(cord));
+  cord.RemoveSuffix(3);
+  EXPECT_EQ("cdef", std::string(cord));
+  cord.RemovePrefix(0);
+  cord.RemoveSuffix(0);
+  EXPECT_THAT(ChunksOf(cord), ElementsAre("c", "def"));
+  cord.RemovePrefix(4);
+  EXPECT_TRUE(cord.empty());
+}
+
+TEST(Cord, Index) {
+  const absl::Cord cord = MakeFragmented({"ab", "c", "defg"});
+  std::string s;
+  for (size_t i = 0; i < cord.size(); ++i) s += cord[i];
+  EXPECT_EQ("abcdefg", s);
+}
+
+TEST(Cord, Flatten) {
+  absl::Cord cord = MakeFragmented({"ab", "c", "defg"});
+  absl::string_view flat;
+  EXPECT_FALSE(cord.TryFlat(&flat));
+  EXPECT_EQ("abcdefg", cord.Flatten());
+  EXPECT_TRUE(cord.TryFlat(&flat));
+  EXPECT_EQ("abcdefg", flat);
+  EXPECT_EQ(flat.data(), cord.Flatten().data());
+}
+
+TEST(Cord, ExternalReleaser) {
+  int releases = 0;
+  std::string seen;
+  {
+    absl::Cord cord = absl::MakeCordFromExternal(
+        "external", [&](absl::string_view data) {
+          ++releases;
+          seen = std::string(data);
+        });
+    absl::Cord sub = cord.Subcord(1, 3);
+    cord.Clear();
+    EXPECT_EQ(0, releases);
+    EXPECT_EQ("xte", std::string(sub));
+  }
+  EXPECT_EQ(1, releases);
+  EXPECT_EQ("external", seen);
+
+  // An empty buffer is released right away.
+  releases = 0;
+  const absl::Cord empty =
+      absl::MakeCordFromExternal("", [&releases] { ++releases; });
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(1, releases);
+}
+
+TEST(Cord, Compare) {
+  const absl::Cord abc = MakeFragmented({"a", "bc"});
+  EXPECT_EQ(abc, "abc");
+  EXPECT_EQ("abc", abc);
+  EXPECT_EQ(abc, absl::Cord("abc"));
+  EXPECT_EQ(abc, MakeFragmented({"ab", "c"}));
+  EXPECT_NE(abc, "abd");
+  EXPECT_NE(abc, absl::Cord("ab"));
+  EXPECT_LT(abc, "abd");
+  EXPECT_LT(abc, MakeFragmented({"ab", "cd"}));
+  EXPECT_LT(MakeFragmented({"ab"}), abc);
+  EXPECT_GT(abc, "ab");
+  EXPECT_GT(abc, absl::Cord());
+  EXPECT_LE(abc, "abc");
+  EXPECT_GE(abc, std::string("abc"));
+  EXPECT_EQ(0, absl::Cord().Compare(absl::Cord()));
+  EXPECT_EQ(0, absl::Cord().Compare(""));
+  EXPECT_GT(0, absl::Cord().Compare("a"));
+  EXPECT_LT(0, abc.Compare(""));
+}
+
+TEST(Cord, StartsWithEndsWith) {
+  const absl::Cord cord = MakeFragmented({"ab", "c", "defg"});
+  EXPECT_TRUE(cord.StartsWith(""));
+  EXPECT_TRUE(cord.StartsWith("abcd"));
+  EXPECT_TRUE(cord.StartsWith("abcdefg"));
+  EXPECT_FALSE(cord.StartsWith("abd"));
+  EXPECT_FALSE(cord.StartsWith("abcdefgh"));
+  EXPECT_TRUE(cord.EndsWith(""));
+  EXPECT_TRUE(cord.EndsWith("cdefg"));
+  EXPECT_FALSE(cord.EndsWith("cdeg"));
+  EXPECT_FALSE(cord.EndsWith("xabcdefg"));
+}
+
+TEST(Cord, Hash) {
+  std::string long_text = LongText('a', 5000);
+  EXPECT_TRUE(absl::VerifyTypeImplementsAbslHashCorrectly({
+      absl::Cord(), absl::Cord("a"), MakeFragmented({"a", "b"}),
+      MakeFragmented({"ab"}), absl::Cord("ab"),
+      absl::Cord(long_text),
+      MakeFragmented({long_text.substr(0, 1000), long_text.substr(1000)}),
+      MakeFragmented({long_text.substr(0, 3), long_text.substr(3, 2000),
+                      long_text.substr(2003)}),
+      absl::Cord(long_text.substr(1)),
+  }));
+  // Equal cords hash equally however they are split.
+  std::mt19937 rng(5);
+  for (int trial = 0; trial < 20; ++trial) {
+    std::vector<std::string> pieces;
+    for (size_t pos = 0; pos < long_text.size();) {
+      const size_t n = std::uniform_int_distribution<size_t>(1, 1500)(rng);
+      pieces.push_back(long_text.substr(pos, n));
+      pos += n;
+    }
+    EXPECT_EQ(absl::Hash<absl::Cord>()(absl::Cord(long_text)),
+              absl::Hash<absl::Cord>()(MakeFragmented(pieces)));
+  }
+}
+
+TEST(Cord, Format) {
+  absl::Cord cord("[");
+  EXPECT_TRUE(absl::Format(&cord, "%d %s", 42, "answer"));
+  cord.Append("]");
+  EXPECT_EQ("[42 answer]", std::string(cord));
+}
+
+TEST(Cord, DeepConcatenationStaysUsable) {
+  // Alternating between sharing appends and prepends of large cords, which
+  // the tree does not balance on its own.
+  const absl::Cord piece(LongText('a', 600));
+  absl::Cord cord;
+  for (int i = 0; i < 5000; ++i) {
+    if (i % 2 == 0) {
+      cord.Append(piece);
+    } else {
+      cord.Prepend(piece);
+    }
+  }
+  EXPECT_EQ(5000 * piece.size(), cord.size());
+  size_t total = 0;
+  for (absl::string_view chunk : cord.Chunks()) {
+    EXPECT_EQ(piece, chunk);
+    total += chunk.size();
+  }
+  EXPECT_EQ(cord.size(), total);
+}
+
+TEST(Cord, CopiesAndAssignment) {
+  absl::Cord a("first");
+  absl::Cord b(a);
+  absl::Cord c;
+  c = a;
+  a = "second";
+  EXPECT_EQ("second", std::string(a));
+  EXPECT_EQ("first", std::string(b));
+  EXPECT_EQ("first", std::string(c));
+  a = std::move(b);
+  EXPECT_EQ("first", std::string(a));
+  a = a;
+  EXPECT_EQ("first", std::string(a));
+  a = absl::string_view(std::string(a)).substr(1);
+  EXPECT_EQ("irst", std::string(a));
+  swap(a, c);
+  EXPECT_EQ("first", std::string(a));
+  EXPECT_EQ("irst", std::string(c));
+}
+
+}  // namespace
@@ -0,0 +1,114 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/csv.h"
+
+#include <cassert>
+
+namespace absl {
+
+namespace {
+
+strings_internal::CharSetFinder FieldEndFinder(char delimiter) {
+  const char chars[] = {delimiter, '\n', '\r'};
+  return strings_internal::CharSetFinder(
+      absl::string_view(chars, sizeof(chars)));
+}
+
+bool IsLineBreak(char c) { return c == '\n' || c == '\r'; }
+
+}  // namespace
+
+CsvReader::CsvReader(absl::string_view input, CsvDialect dialect)
+    : input_(input),
+      dialect_(dialect),
+      field_end_(FieldEndFinder(dialect.delimiter)),
+      pos_(0),
+      ok_(true) {
+  assert(dialect.delimiter != dialect.quote);
+  assert(!IsLineBreak(dialect.delimiter) && !IsLineBreak(dialect.quote));
+}
+
+bool CsvReader::Next(std::vector<absl::string_view>* fields) {
+  fields->clear();
+  escaped_.clear();
+  if (!ok_ || pos_ >= input_.size()) return false;
+
+  const char* p = input_.data() + pos_;
+  const char* const end = input_.data() + input_.size();
+  for (;;) {
+    if (p != end && *p == dialect_.quote) {
+      // A quoted field ends at the first quote that is not doubled.
+      const char* const start = ++p;
+      bool escaped = false;
+      for (;;) {
+        p = strings_internal::FindChar(p, end, dialect_.quote);
+        if (p == end) {
+          ok_ = false;
+          fields->clear();
+          return false;
+        }
+        if (p + 1 == end || p[1] != dialect_.quote) break;
+        escaped = true;
+        p += 2;
+      }
+      if (escaped) escaped_.push_back(fields->size());
+      fields->push_back(absl::string_view(start, p - start));
+      ++p;
+      if (p != end && *p != dialect_.delimiter && !IsLineBreak(*p)) {
+        ok_ = false;
+        fields->clear();
+        return false;
+      }
+    } else {
+      const char* const start = p;
+      p = field_end_.Find(p, end);
+      fields->push_back(absl::string_view(start, p - start));
+    }
+    if (p == end) break;
+    if (*p == dialect_.delimiter) {
+      ++p;
+      continue;
+    }
+    // A line break: "\r\n" counts as one.
+    if (*p == '\r' && p + 1 != end && p[1] == '\n') ++p;
+    ++p;
+    break;
+  }
+  pos_ = p - input_.data();
+  if (!escaped_.empty()) Unescape(fields);
+  return true;
+}
+
+void CsvReader::Unescape(std::vector<absl::string_view>* fields) {
+  // Reserve first, so that appending does not move the fields unescaped
+  // earlier.
+  size_t size = 0;
+  for (size_t i : escaped_) size += (*fields)[i].size();
+  buffer_.clear();
+  buffer_.reserve(size);
+  for (size_t i : escaped_) {
+    const absl::string_view raw = (*fields)[i];
+    const size_t begin = buffer_.size();
+    for (size_t j = 0; j < raw.size(); ++j) {
+      buffer_.push_back(raw[j]);
+      // Quotes are doubled within the field, so skip the second one.
+      if (raw[j] == dialect_.quote) ++j;
+    }
+    (*fields)[i] = absl::string_view(buffer_.data() + begin,
+                                     buffer_.size() - begin);
+  }
+}
+
+}  // namespace absl
@@ -0,0 +1,118 @@
+//
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: csv.h
+// -----------------------------------------------------------------------------
+//
+// This header file contains `absl::CsvReader`, which splits text in the
+// comma-separated values format of RFC 4180 into records and fields. Unlike
+// `absl::StrSplit()`, it understands quoted fields:
+//
+//   * A field that starts with a quote extends to the matching closing quote,
+//     and may contain delimiters and line breaks.
+//   * Within a quoted field, two quotes stand for one.
+//   * Records end at "\n", "\r\n" or "\r" outside of quotes. A line break at
+//     the end of the input does not start another record.
+//
+// Fields are returned as `absl::string_view`s into the input, except for
+// quoted fields containing doubled quotes, which are unescaped into a buffer
+// owned by the reader. The same reader reads tab-separated values when given
+// a `CsvDialect` with a tab delimiter.
+//
+// Example:
+//
+//   absl::CsvReader reader("name,quote\nAda,\"Says \"\"hi\"\"\"\n");
+//   std::vector<absl::string_view> fields;
+//   while (reader.Next(&fields)) {
+//     // {"name", "quote"}, then {"Ada", "Says \"hi\""}
+//   }
+//   if (!reader.ok()) {
+//     // The input is malformed at reader.position().
+//   }
+
+#ifndef ABSL_STRINGS_CSV_H_
+#define ABSL_STRINGS_CSV_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "absl/strings/internal/delimiter_scan.h"
+#include "absl/strings/string_view.h"
+
+namespace absl {
+
+// CsvDialect
+//
+// The characters that separate and quote the fields of a `CsvReader`. They
+// must differ from each other and from '\n' and '\r'.
+struct CsvDialect {
+  char delimiter = ',';
+  char quote = '"';
+};
+
+// CsvReader
+//
+// Reads the records of a CSV or TSV text one at a time. The reader does not
+// copy the input, which must outlive it and the fields it returns.
+//
+// A quote in a field that does not start with one is kept as a literal
+// character. The input is malformed, and reading stops, if a quoted field is
+// not closed or if its closing quote is followed by anything but a delimiter
+// or a line break.
+class CsvReader {
+ public:
+  explicit CsvReader(absl::string_view input,
+                     CsvDialect dialect = CsvDialect());
+
+  CsvReader(const CsvReader&) = delete;
+  CsvReader& operator=(const CsvReader&) = delete;
+
+  // Reads the next record into `fields`, replacing its contents, and returns
+  // true. Returns false, with `fields` empty, at the end of the input or if
+  // the next record is malformed; `ok()` tells the two apart.
+  //
+  // The fields remain valid until the next call, since unescaped fields live
+  // in a buffer of the reader. Reusing the same vector avoids allocating once
+  // its capacity suffices.
+  bool Next(std::vector<absl::string_view>* fields);
+
+  // Returns false if reading stopped at a malformed record.
+  bool ok() const { return ok_; }
+
+  // Returns the offset in the input of the next record, or of the malformed
+  // record if `ok()` is false.
+  size_t position() const { return pos_; }
+
+ private:
+  // Unescapes the fields at `escaped_` into `buffer_`.
+  void Unescape(std::vector<absl::string_view>* fields);
+
+  const absl::string_view input_;
+  const CsvDialect dialect_;
+  // Where an unquoted field can end: the delimiter or a line break.
+  const strings_internal::CharSetFinder field_end_;
+  size_t pos_;
+  bool ok_;
+  // Indices in the current record of the quoted fields that contain doubled
+  // quotes, and the buffer that holds them once unescaped.
+  std::vector<size_t> escaped_;
+  std::string buffer_;
+};
+
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_CSV_H_
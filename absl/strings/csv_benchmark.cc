@@ -0,0 +1,115 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "absl/strings/csv.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+
+namespace {
+
+// 10000 records of 8 fields. One field in `quoted_every` is quoted, and one
+// quoted field in four contains doubled quotes. 0 quotes no field.
+std::string MakeCsv(int quoted_every) {
+  std::string csv;
+  int n = 0;
+  for (int record = 0; record < 10000; ++record) {
+    for (int field = 0; field < 8; ++field, ++n) {
+      if (field > 0) csv += ',';
+      if (quoted_every > 0 && n % quoted_every == 0) {
+        if (n % (4 * quoted_every) == 0) {
+          absl::StrAppend(&csv, "\"say \"\"", n, "\"\", then go\"");
+        } else {
+          absl::StrAppend(&csv, "\"", n, ", quoted\"");
+        }
+      } else {
+        absl::StrAppend(&csv, field % 2 == 0 ? "value" : "", n);
+      }
+    }
+    csv += '\n';
+  }
+  return csv;
+}
+
+void BM_CsvReader(benchmark::State& state) {
+  const std::string csv = MakeCsv(state.range(0));
+  std::vector<absl::string_view> fields;
+  for (auto _ : state) {
+    absl::CsvReader reader(csv);
+    while (reader.Next(&fields)) benchmark::DoNotOptimize(fields.data());
+  }
+  state.SetBytesProcessed(state.iterations() * csv.size());
+}
+BENCHMARK(BM_CsvReader)->Arg(0)->Arg(2)->Arg(10);
+
+// A byte-at-a-time state machine, as a typical hand-written CSV parser is.
+// Every field is copied.
+void BM_CsvByteLoop(benchmark::State& state) {
+  const std::string csv = MakeCsv(state.range(0));
+  std::vector<std::string> fields;
+  for (auto _ : state) {
+    size_t num_fields = 0;
+    bool in_quotes = false;
+    std::string field;
+    for (size_t i = 0; i < csv.size(); ++i) {
+      const char c = csv[i];
+      if (in_quotes) {
+        if (c != '"') {
+          field += c;
+        } else if (i + 1 < csv.size() && csv[i + 1] == '"') {
+          field += '"';
+          ++i;
+        } else {
+          in_quotes = false;
+        }
+      } else if (c == '"') {
+        in_quotes = true;
+      } else if (c == ',' || c == '\n') {
+        if (num_fields == fields.size()) fields.emplace_back();
+        fields[num_fields++].swap(field);
+        field.clear();
+        if (c == '\n') {
+          benchmark::DoNotOptimize(fields.data());
+          num_fields = 0;
+        }
+      } else {
+        field += c;
+      }
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * csv.size());
+}
+BENCHMARK(BM_CsvByteLoop)->Arg(0)->Arg(2)->Arg(10);
+
+// StrSplit() by lines and then by commas, which is only correct without
+// quotes. The bound for CsvReader on unquoted input.
+void BM_CsvStrSplit(benchmark::State& state) {
+  const std::string csv = MakeCsv(0);
+  absl::string_view fields[16];
+  for (auto _ : state) {
+    for (absl::string_view line :
+         absl::StrSplit(csv, '\n', absl::SkipEmpty())) {
+      benchmark::DoNotOptimize(
+          absl::StrSplitInto(line, ',', absl::MakeSpan(fields)));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * csv.size());
+}
+BENCHMARK(BM_CsvStrSplit);
+
+}  // namespace
@@ -0,0 +1,146 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/csv.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+// Reads all records of `input`, expecting it to be well formed.
+std::vector<std::vector<std::string>> ReadAll(
+    absl::string_view input, absl::CsvDialect dialect = absl::CsvDialect()) {
+  absl::CsvReader reader(input, dialect);
+  std::vector<std::vector<std::string>> records;
+  std::vector<absl::string_view> fields;
+  while (reader.Next(&fields)) {
+    records.emplace_back(fields.begin(), fields.end());
+  }
+  EXPECT_TRUE(reader.ok()) << input;
+  EXPECT_EQ(input.size(), reader.position());
+  return records;
+}
+
+using Records = std::vector<std::vector<std::string>>;
+
+TEST(CsvReader, UnquotedFields) {
+  EXPECT_EQ(ReadAll("a,b,c"), (Records{{"a", "b", "c"}}));
+  EXPECT_EQ(ReadAll("a,b\nc,d\n"), (Records{{"a", "b"}, {"c", "d"}}));
+  EXPECT_EQ(ReadAll("a,,b,"), (Records{{"a", "", "b", ""}}));
+  EXPECT_EQ(ReadAll(","), (Records{{"", ""}}));
+}
+
+TEST(CsvReader, LineBreaks) {
+  EXPECT_EQ(ReadAll("a\r\nb\rc\nd"), (Records{{"a"}, {"b"}, {"c"}, {"d"}}));
+  // A final line break ends the last record; an empty line is a record with
+  // one empty field, as StrSplit() would return.
+  EXPECT_EQ(ReadAll("a\n\nb\n"), (Records{{"a"}, {""}, {"b"}}));
+  EXPECT_EQ(ReadAll("a\r\n\r\n"), (Records{{"a"}, {""}}));
+}
+
+TEST(CsvReader, EmptyInput) {
+  EXPECT_THAT(ReadAll(""), IsEmpty());
+  EXPECT_EQ(ReadAll("\n"), (Records{{""}}));
+}
+
+TEST(CsvReader, QuotedFields) {
+  EXPECT_EQ(ReadAll("\"a,b\",c"), (Records{{"a,b", "c"}}));
+  EXPECT_EQ(ReadAll("\"\",\"\""), (Records{{"", ""}}));
+  EXPECT_EQ(ReadAll("\"line\nbreak\",\"cr\r\nlf\"\nnext"),
+            (Records{{"line\nbreak", "cr\r\nlf"}, {"next"}}));
+  EXPECT_EQ(ReadAll("a,\"b\"\r\nc"), (Records{{"a", "b"}, {"c"}}));
+}
+
+TEST(CsvReader, EscapedQuotes) {
+  EXPECT_EQ(ReadAll("\"say \"\"hi\"\"\",x"),
+            (Records{{"say \"hi\"", "x"}}));
+  EXPECT_EQ(ReadAll("\"\"\"\""), (Records{{"\""}}));
+  EXPECT_EQ(ReadAll("\"a\"\"\",\"\"\"b\",\"c\"\"\"\"d\""),
+            (Records{{"a\"", "\"b", "c\"\"d"}}));
+}
+
+TEST(CsvReader, QuoteInUnquotedFieldIsLiteral) {
+  EXPECT_EQ(ReadAll("a\"b,c\""), (Records{{"a\"b", "c\""}}));
+}
+
+TEST(CsvReader, FieldsReferToInputUnlessUnescaped) {
+  const std::string input = "plain,\"quoted\",\"esc\"\"aped\"";
+  absl::CsvReader reader(input);
+  std::vector<absl::string_view> fields;
+  ASSERT_TRUE(reader.Next(&fields));
+  ASSERT_THAT(fields, ElementsAre("plain", "quoted", "esc\"aped"));
+  EXPECT_EQ(input.data(), fields[0].data());
+  EXPECT_EQ(input.data() + 7, fields[1].data());
+  EXPECT_FALSE(input.data() <= fields[2].data() &&
+               fields[2].data() < input.data() + input.size());
+}
+
+TEST(CsvReader, ManyEscapedFieldsStayValid) {
+  // Unescaping the later fields must not move the earlier ones.
+  std::string input;
+  std::vector<std::string> expected;
+  for (int i = 0; i < 100; ++i) {
+    if (i > 0) input += ',';
+    absl::StrAppend(&input, "\"", i, "\"\"", i, "\"");
+    expected.push_back(absl::StrCat(i, "\"", i));
+  }
+  EXPECT_EQ(ReadAll(input), (Records{expected}));
+}
+
+TEST(CsvReader, Tsv) {
+  absl::CsvDialect tsv;
+  tsv.delimiter = '\t';
+  EXPECT_EQ(ReadAll("a\tb,c\t\"d\te\"\n", tsv),
+            (Records{{"a", "b,c", "d\te"}}));
+}
+
+TEST(CsvReader, Malformed) {
+  std::vector<absl::string_view> fields;
+  {
+    absl::CsvReader reader("a,b\n\"unterminated,c\nd");
+    EXPECT_TRUE(reader.Next(&fields));
+    EXPECT_FALSE(reader.Next(&fields));
+    EXPECT_THAT(fields, IsEmpty());
+    EXPECT_FALSE(reader.ok());
+    EXPECT_EQ(4, reader.position());
+    // Reading stays stopped.
+    EXPECT_FALSE(reader.Next(&fields));
+  }
+  {
+    absl::CsvReader reader("\"a\"b,c");
+    EXPECT_FALSE(reader.Next(&fields));
+    EXPECT_FALSE(reader.ok());
+    EXPECT_EQ(0, reader.position());
+  }
+}
+
+TEST(CsvReader, LongFields) {
+  // Fields longer than the blocks that are scanned at once.
+  const std::string a(100, 'a');
+  const std::string b(70, 'b');
+  const std::string quoted = absl::StrCat(b, ",\n", b);
+  EXPECT_EQ(ReadAll(absl::StrCat(a, ",\"", quoted, "\"\n", a)),
+            (Records{{a, quoted}, {a}}));
+}
+
+}  // namespace
@@ -20,6 +20,7 @@
 #include <limits>
 
 #include "absl/strings/internal/memutil.h"
+#include "absl/strings/internal/swar_digits.h"
 
 namespace absl {
 namespace {
@@ -256,6 +257,16 @@ std::size_t ConsumeDigits(const char* begin, const char* end, int max_digits,
   T accumulator = *out;
   const char* significant_digits_end =
       (end - begin > max_digits) ? begin + max_digits : end;
+  if (base == 10 && sizeof(T) >= sizeof(uint64_t)) {
+    // Long mantissas are consumed eight digits at a time.
+    while (significant_digits_end - begin >= 8) {
+      const uint64_t chunk = strings_internal::LoadEightChars(begin);
+      if (!strings_internal::IsEightDigits(chunk)) break;
+      accumulator =
+          accumulator * 100000000 + strings_internal::ParseEightDigits(chunk);
+      begin += 8;
+    }
+  }
   while (begin < significant_digits_end && IsDigit<base>(*begin)) {
     // Do not guard against *out overflow; max_digits was chosen to avoid this.
     // Do assert against it, to detect problems in debug builds.
@@ -267,6 +278,14 @@ std::size_t ConsumeDigits(const char* begin, const char* end, int max_digits,
     ++begin;
   }
   bool dropped_nonzero = false;
+  if (base == 10) {
+    while (end - begin >= 8) {
+      const uint64_t chunk = strings_internal::LoadEightChars(begin);
+      if (!strings_internal::IsEightDigits(chunk)) break;
+      dropped_nonzero = dropped_nonzero || chunk != 0x3030303030303030u;
+      begin += 8;
+    }
+  }
   while (begin < end && IsDigit<base>(*begin)) {
     dropped_nonzero = dropped_nonzero || (*begin != '0');
     ++begin;
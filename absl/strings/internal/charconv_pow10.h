@@ -0,0 +1,56 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ABSL_STRINGS_INTERNAL_CHARCONV_POW10_H_
+#define ABSL_STRINGS_INTERNAL_CHARCONV_POW10_H_
+
+#include <cstdint>
+
+namespace absl {
+namespace strings_internal {
+
+// The range of powers of ten in the 128-bit table below.  It covers every
+// power needed to convert between decimal and `double` in either direction.
+constexpr int kPow10SignificandMin = -342;
+constexpr int kPow10SignificandMax = 324;
+
+// The 128 most significant bits of each power of ten 10**n in
+// [kPow10SignificandMin, kPow10SignificandMax], as {high, low} words.  The
+// values are truncated, not rounded, so that
+//
+//   s * 2**(FloorLog2Pow10(n) - 127) <= 10**n
+//     < (s + 1) * 2**(FloorLog2Pow10(n) - 127),
+//
+// where s is the significand, and 2**127 <= s < 2**128.  The entry is exact
+// for 0 <= n <= 55.
+//
+// Indexes are biased by -kPow10SignificandMin.
+extern const uint64_t kPow10Significands[][2];
+
+inline const uint64_t* Pow10Significand(int n) {
+  return kPow10Significands[n - kPow10SignificandMin];
+}
+
+// Returns floor(log2(10**n)), for |n| <= 1650.
+inline int FloorLog2Pow10(int n) {
+  // 1741647 / 2**19 approximates log2(10) closely enough over the range.
+  // The right shift of a negative value rounds towards negative infinity on
+  // every compiler we support.
+  return (n * 1741647) >> 19;
+}
+
+}  // namespace strings_internal
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_INTERNAL_CHARCONV_POW10_H_
@@ -0,0 +1,198 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/internal/charconv_shortest.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "absl/numeric/int128.h"
+#include "absl/strings/internal/charconv_pow10.h"
+
+// This is Raffaello Giulietti's Schubfach algorithm ("The Schubfach way to
+// render doubles", 2020).
+//
+// A finite positive float is c * 2**q, for an integer c.  Every real number
+// in its rounding interval, between the midpoints to its two neighbours,
+// converts back to it.  Schubfach scales the interval by 10**-k, where k is
+// chosen so that the interval is between 1 and 10 units wide, and so holds
+// one or two integers that are multiples of 10 or one to four integers in
+// all.  Among those decimals, a multiple of ten is shorter, and is picked if
+// present; otherwise the one closest to the value is.
+//
+// The scaled bounds are computed with a single truncated 128-bit power of ten
+// each, rounded to odd: the result is exact in its upper bits and has a low
+// bit that tells whether anything was dropped, which is all the comparisons
+// below need.
+
+namespace absl {
+namespace strings_internal {
+namespace {
+
+// Returns floor(log10(2**q)), or floor(log10(3/4 * 2**q)) if `lower_closer`,
+// for |q| <= 1500.
+int ScaledPow10Exponent(int q, bool lower_closer) {
+  return (q * 1262611 - (lower_closer ? 524031 : 0)) >> 22;
+}
+
+// Returns (g * cp) >> 128, with its lowest bit set if any bits that were
+// shifted out were set (less a tolerance of one for the truncation in `g`).
+uint64_t RoundToOdd(absl::uint128 g, uint64_t cp) {
+  absl::uint128 x = absl::uint128(absl::Uint128Low64(g)) * cp;
+  absl::uint128 y =
+      absl::uint128(absl::Uint128High64(g)) * cp + absl::Uint128High64(x);
+  return absl::Uint128High64(y) | (absl::Uint128Low64(y) > 1);
+}
+
+// As above for `float`, with a 64-bit `g` and a 32-bit `cp`: returns
+// (g * cp) >> 64, rounded to odd.
+uint32_t RoundToOdd(uint64_t g, uint32_t cp) {
+  absl::uint128 p = absl::uint128(g) * cp;
+  uint32_t y1 = static_cast<uint32_t>(absl::Uint128High64(p));
+  uint32_t y0 = static_cast<uint32_t>(absl::Uint128Low64(p) >> 32);
+  return y1 | (y0 > 1);
+}
+
+// 10**n scaled to 128 bits, rounded up.
+absl::uint128 Pow10Ceiling128(int n) {
+  const uint64_t* s = Pow10Significand(n);
+  return absl::MakeUint128(s[0], s[1]) + 1;
+}
+
+// 10**n scaled to 64 bits, rounded up.
+uint64_t Pow10Ceiling64(int n) { return Pow10Significand(n)[0] + 1; }
+
+template <typename Int>
+ShortestDecimal RemoveTrailingZeros(Int digits, int exponent) {
+  assert(digits != 0);
+  while (digits % 10 == 0) {
+    digits /= 10;
+    ++exponent;
+  }
+  return {digits, exponent};
+}
+
+// The search common to both widths.  `vbl`, `vb` and `vbr` are the lower
+// bound, the value and the upper bound of the interval scaled by 10**-k and
+// by four, rounded to odd.  Bounds are included when `is_even`.
+template <typename Int>
+ShortestDecimal Search(Int vbl, Int vb, Int vbr, bool is_even, int k) {
+  const Int lower = vbl + !is_even;
+  const Int upper = vbr - !is_even;
+
+  const Int s = vb / 4;
+  if (s >= 10) {
+    // Try the multiple of ten below and above the value.
+    const Int sp = s / 10;
+    const bool up_inside = lower <= 40 * sp;
+    const bool wp_inside = 40 * sp + 40 <= upper;
+    if (up_inside != wp_inside) {
+      return RemoveTrailingZeros<Int>(sp + wp_inside, k + 1);
+    }
+  }
+
+  const bool u_inside = lower <= 4 * s;
+  const bool w_inside = 4 * s + 4 <= upper;
+  if (u_inside != w_inside) return RemoveTrailingZeros<Int>(s + w_inside, k);
+
+  // Both neighbours are inside: pick the closer one, or the even one on a tie.
+  const Int mid = 4 * s + 2;
+  const bool round_up = vb > mid || (vb == mid && (s & 1) != 0);
+  return RemoveTrailingZeros<Int>(s + round_up, k);
+}
+
+}  // namespace
+
+ShortestDecimal ShortestDecimalOf(double value) {
+  assert(value > 0);
+  constexpr int kSignificandBits = 52;
+  constexpr int kExponentBias = 1023 + kSignificandBits;
+
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint64_t significand = bits & ((uint64_t{1} << kSignificandBits) - 1);
+  const int biased_exponent = static_cast<int>(bits >> kSignificandBits);
+
+  uint64_t c;
+  int q;
+  if (biased_exponent != 0) {
+    c = (uint64_t{1} << kSignificandBits) | significand;
+    q = biased_exponent - kExponentBias;
+    // Small integers print exactly.
+    if (-q >= 0 && -q <= kSignificandBits &&
+        (c & ((uint64_t{1} << -q) - 1)) == 0) {
+      return RemoveTrailingZeros(c >> -q, 0);
+    }
+  } else {
+    c = significand;
+    q = 1 - kExponentBias;
+  }
+
+  const bool is_even = c % 2 == 0;
+  // At a power of two, the gap to the next value down is half as wide.
+  const bool lower_closer = significand == 0 && biased_exponent > 1;
+
+  const uint64_t cbl = 4 * c - 2 + lower_closer;
+  const uint64_t cb = 4 * c;
+  const uint64_t cbr = 4 * c + 2;
+
+  const int k = ScaledPow10Exponent(q, lower_closer);
+  const int h = q + FloorLog2Pow10(-k) + 1;
+  const absl::uint128 g = Pow10Ceiling128(-k);
+
+  return Search<uint64_t>(RoundToOdd(g, cbl << h), RoundToOdd(g, cb << h),
+                          RoundToOdd(g, cbr << h), is_even, k);
+}
+
+ShortestDecimal ShortestDecimalOf(float value) {
+  assert(value > 0);
+  constexpr int kSignificandBits = 23;
+  constexpr int kExponentBias = 127 + kSignificandBits;
+
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint32_t significand = bits & ((uint32_t{1} << kSignificandBits) - 1);
+  const int biased_exponent = static_cast<int>(bits >> kSignificandBits);
+
+  uint32_t c;
+  int q;
+  if (biased_exponent != 0) {
+    c = (uint32_t{1} << kSignificandBits) | significand;
+    q = biased_exponent - kExponentBias;
+    if (-q >= 0 && -q <= kSignificandBits &&
+        (c & ((uint32_t{1} << -q) - 1)) == 0) {
+      return RemoveTrailingZeros<uint64_t>(c >> -q, 0);
+    }
+  } else {
+    c = significand;
+    q = 1 - kExponentBias;
+  }
+
+  const bool is_even = c % 2 == 0;
+  const bool lower_closer = significand == 0 && biased_exponent > 1;
+
+  const uint32_t cbl = 4 * c - 2 + lower_closer;
+  const uint32_t cb = 4 * c;
+  const uint32_t cbr = 4 * c + 2;
+
+  const int k = ScaledPow10Exponent(q, lower_closer);
+  const int h = q + FloorLog2Pow10(-k) + 1;
+  const uint64_t g = Pow10Ceiling64(-k);
+
+  return Search<uint32_t>(RoundToOdd(g, cbl << h), RoundToOdd(g, cb << h),
+                          RoundToOdd(g, cbr << h), is_even, k);
+}
+
+}  // namespace strings_internal
+}  // namespace absl
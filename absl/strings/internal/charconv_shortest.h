@@ -0,0 +1,41 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ABSL_STRINGS_INTERNAL_CHARCONV_SHORTEST_H_
+#define ABSL_STRINGS_INTERNAL_CHARCONV_SHORTEST_H_
+
+#include <cstdint>
+
+namespace absl {
+namespace strings_internal {
+
+// A decimal number `digits * 10**exponent`.
+struct ShortestDecimal {
+  uint64_t digits;
+  int exponent;
+};
+
+// Returns the decimal with the fewest significant digits that converts back
+// to `value` under round-to-nearest-even.  When several decimals of that
+// length do, returns the one closest to `value`, and of those the one with an
+// even last digit.  `digits` has no trailing zeros.
+//
+// `value` must be finite and positive.
+ShortestDecimal ShortestDecimalOf(double value);
+ShortestDecimal ShortestDecimalOf(float value);
+
+}  // namespace strings_internal
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_INTERNAL_CHARCONV_SHORTEST_H_
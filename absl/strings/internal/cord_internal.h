@@ -0,0 +1,198 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// The nodes of the tree that holds the contents of an `absl::Cord`.
+
+#ifndef ABSL_STRINGS_INTERNAL_CORD_INTERNAL_H_
+#define ABSL_STRINGS_INTERNAL_CORD_INTERNAL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+
+namespace absl {
+namespace cord_internal {
+
+enum class CordRepKind : uint8_t {
+  // An inner node: the concatenation of two non-empty trees.
+  kConcat,
+  // A leaf that holds its bytes inline, after the node.
+  kFlat,
+  // A leaf that refers to memory owned by the caller, which is handed back
+  // to a releaser once the last reference goes away.
+  kExternal,
+  // A leaf that is a range of a flat or external leaf.
+  kSubstring,
+};
+
+struct CordRepConcat;
+struct CordRepFlat;
+struct CordRepExternal;
+struct CordRepSubstring;
+
+// A node of the tree. Nodes are immutable once shared: a cord only changes
+// a node in place while its reference count is one, and every node on the
+// way to it from the root is referenced once as well.
+struct CordRep {
+  CordRep(CordRepKind k, size_t len) : length(len), refcount(1), kind(k) {}
+
+  CordRepConcat* concat();
+  const CordRepConcat* concat() const;
+  CordRepFlat* flat();
+  const CordRepFlat* flat() const;
+  const CordRepExternal* external() const;
+  const CordRepSubstring* substring() const;
+
+  size_t length;
+  std::atomic<int32_t> refcount;
+  CordRepKind kind;
+};
+
+struct CordRepConcat : CordRep {
+  CordRepConcat(CordRep* l, CordRep* r, uint8_t d)
+      : CordRep(CordRepKind::kConcat, l->length + r->length),
+        left(l),
+        right(r),
+        depth(d) {}
+
+  CordRep* left;
+  CordRep* right;
+  // The number of inner nodes on the longest path down to a leaf.
+  uint8_t depth;
+};
+
+// A flat is allocated together with `capacity` bytes that follow it.
+struct CordRepFlat : CordRep {
+  explicit CordRepFlat(size_t cap)
+      : CordRep(CordRepKind::kFlat, 0), capacity(cap) {}
+
+  char* data() { return reinterpret_cast<char*>(this + 1); }
+  const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+
+  size_t capacity;
+};
+
+struct CordRepExternal : CordRep {
+  CordRepExternal(const char* b, size_t len,
+                  void (*r)(CordRepExternal* rep))
+      : CordRep(CordRepKind::kExternal, len), base(b), release(r) {}
+
+  const char* base;
+  // Invokes the releaser and deletes the node.
+  void (*release)(CordRepExternal* rep);
+};
+
+// The node type for external memory with a releaser of type `Releaser`,
+// which is invoked with the data, or with no arguments if it takes none.
+template <typename Releaser>
+struct CordRepExternalImpl : CordRepExternal {
+  template <typename R>
+  CordRepExternalImpl(absl::string_view data, R&& r)
+      : CordRepExternal(data.data(), data.size(), &Release),
+        releaser(std::forward<R>(r)) {}
+
+  static void Release(CordRepExternal* rep) {
+    auto* self = static_cast<CordRepExternalImpl*>(rep);
+    Invoke(std::move(self->releaser),
+           absl::string_view(self->base, self->length));
+    delete self;
+  }
+
+  template <typename R>
+  static auto Invoke(R&& r, absl::string_view data)
+      -> decltype(std::forward<R>(r)(data)) {
+    return std::forward<R>(r)(data);
+  }
+  template <typename R>
+  static auto Invoke(R&& r, absl::string_view)
+      -> decltype(std::forward<R>(r)()) {
+    return std::forward<R>(r)();
+  }
+
+  Releaser releaser;
+};
+
+struct CordRepSubstring : CordRep {
+  CordRepSubstring(CordRep* c, size_t s, size_t len)
+      : CordRep(CordRepKind::kSubstring, len), start(s), child(c) {}
+
+  size_t start;
+  // A flat or external leaf.
+  CordRep* child;
+};
+
+inline CordRepConcat* CordRep::concat() {
+  return static_cast<CordRepConcat*>(this);
+}
+inline const CordRepConcat* CordRep::concat() const {
+  return static_cast<const CordRepConcat*>(this);
+}
+inline CordRepFlat* CordRep::flat() { return static_cast<CordRepFlat*>(this); }
+inline const CordRepFlat* CordRep::flat() const {
+  return static_cast<const CordRepFlat*>(this);
+}
+inline const CordRepExternal* CordRep::external() const {
+  return static_cast<const CordRepExternal*>(this);
+}
+inline const CordRepSubstring* CordRep::substring() const {
+  return static_cast<const CordRepSubstring*>(this);
+}
+
+inline CordRep* Ref(CordRep* rep) {
+  rep->refcount.fetch_add(1, std::memory_order_relaxed);
+  return rep;
+}
+
+// Deletes `rep` and releases its children.
+void Destroy(CordRep* rep);
+
+inline void Unref(CordRep* rep) {
+  // The last reference is the only one, so no other thread can be adding
+  // one concurrently and the decrement can be skipped.
+  if (rep->refcount.load(std::memory_order_acquire) == 1 ||
+      rep->refcount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    Destroy(rep);
+  }
+}
+
+inline int Depth(const CordRep* rep) {
+  return rep->kind == CordRepKind::kConcat ? rep->concat()->depth : 0;
+}
+
+// Returns the bytes of the leaf `rep`.
+inline absl::string_view LeafData(const CordRep* rep) {
+  switch (rep->kind) {
+    case CordRepKind::kFlat:
+      return absl::string_view(rep->flat()->data(), rep->length);
+    case CordRepKind::kExternal:
+      return absl::string_view(rep->external()->base, rep->length);
+    case CordRepKind::kSubstring: {
+      const CordRepSubstring* sub = rep->substring();
+      return absl::string_view(LeafData(sub->child).data() + sub->start,
+                               rep->length);
+    }
+    case CordRepKind::kConcat:
+      break;
+  }
+  return absl::string_view();
+}
+
+}  // namespace cord_internal
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_INTERNAL_CORD_INTERNAL_H_
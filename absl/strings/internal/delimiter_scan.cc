@@ -0,0 +1,274 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/internal/delimiter_scan.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include "absl/base/internal/bits.h"
+#include "absl/strings/internal/memutil.h"
+
+#if defined(__SSE2__) ||  \
+    (defined(_MSC_VER) && \
+     (defined(_M_X64) || (defined(_M_IX86) && _M_IX86_FP >= 2)))
+#define ABSL_STRINGS_INTERNAL_DELIMITER_SCAN_SSE2 1
+#include <emmintrin.h>
+#else
+#define ABSL_STRINGS_INTERNAL_DELIMITER_SCAN_SSE2 0
+#endif
+
+#ifdef __AVX2__
+#define ABSL_STRINGS_INTERNAL_DELIMITER_SCAN_AVX2 1
+#include <immintrin.h>
+#else
+#define ABSL_STRINGS_INTERNAL_DELIMITER_SCAN_AVX2 0
+#endif
+
+namespace absl {
+namespace strings_internal {
+
+namespace {
+
+#if ABSL_STRINGS_INTERNAL_DELIMITER_SCAN_SSE2
+struct Sse2 {
+  using Vec = __m128i;
+  static constexpr size_t kWidth = 16;
+
+  static Vec Load(const char* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  }
+  static Vec Splat(char c) { return _mm_set1_epi8(c); }
+  static Vec Eq(Vec a, Vec b) { return _mm_cmpeq_epi8(a, b); }
+  static Vec Or(Vec a, Vec b) { return _mm_or_si128(a, b); }
+  static Vec And(Vec a, Vec b) { return _mm_and_si128(a, b); }
+  static uint32_t Mask(Vec v) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(v));
+  }
+};
+#endif  // ABSL_STRINGS_INTERNAL_DELIMITER_SCAN_SSE2
+
+#if ABSL_STRINGS_INTERNAL_DELIMITER_SCAN_AVX2
+struct Avx2 {
+  using Vec = __m256i;
+  static constexpr size_t kWidth = 32;
+
+  static Vec Load(const char* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+  static Vec Splat(char c) { return _mm256_set1_epi8(c); }
+  static Vec Eq(Vec a, Vec b) { return _mm256_cmpeq_epi8(a, b); }
+  static Vec Or(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+  static Vec And(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+  static uint32_t Mask(Vec v) {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(v));
+  }
+};
+#endif  // ABSL_STRINGS_INTERNAL_DELIMITER_SCAN_AVX2
+
+// Matches the bytes equal to any of `N` characters. `Match(p)` reads
+// `[p, p + kWidth)` and sets bit `i` when `p[i]` matches.
+template <typename Simd, size_t N>
+class CharsMatcher {
+ public:
+  static constexpr size_t kWidth = Simd::kWidth;
+
+  explicit CharsMatcher(const char* chars) {
+    for (size_t i = 0; i < N; ++i) splat_[i] = Simd::Splat(chars[i]);
+  }
+
+  size_t reach() const { return kWidth; }
+
+  uint32_t Match(const char* p) const {
+    const typename Simd::Vec v = Simd::Load(p);
+    typename Simd::Vec eq = Simd::Eq(v, splat_[0]);
+    for (size_t i = 1; i < N; ++i) eq = Simd::Or(eq, Simd::Eq(v, splat_[i]));
+    return Simd::Mask(eq);
+  }
+
+  bool Verify(const char*) const { return true; }
+
+ private:
+  typename Simd::Vec splat_[N];
+};
+
+// Matches the start of a needle of at least two bytes. `Match(p)` sets bit `i`
+// when both the first and the last byte of the needle match at `p + i`, which
+// rules out most candidates; `Verify()` compares the bytes in between.
+template <typename Simd>
+class StringMatcher {
+ public:
+  static constexpr size_t kWidth = Simd::kWidth;
+
+  explicit StringMatcher(absl::string_view needle)
+      : needle_(needle),
+        first_(Simd::Splat(needle.front())),
+        last_(Simd::Splat(needle.back())) {}
+
+  size_t reach() const { return kWidth + needle_.size() - 1; }
+
+  uint32_t Match(const char* p) const {
+    return Simd::Mask(
+        Simd::And(Simd::Eq(Simd::Load(p), first_),
+                  Simd::Eq(Simd::Load(p + needle_.size() - 1), last_)));
+  }
+
+  bool Verify(const char* p) const {
+    return std::memcmp(p + 1, needle_.data() + 1, needle_.size() - 2) == 0;
+  }
+
+ private:
+  absl::string_view needle_;
+  typename Simd::Vec first_;
+  typename Simd::Vec last_;
+};
+
+// Returns the first position `base + i` with bit `i` set in `mask` that
+// `matcher` verifies, or nullptr.
+template <typename Matcher>
+inline const char* FirstMatch(const char* base, uint32_t mask,
+                              const Matcher& matcher) {
+  for (; mask != 0; mask &= mask - 1) {
+    const char* p =
+        base + absl::base_internal::CountTrailingZerosNonZero32(mask);
+    if (matcher.Verify(p)) return p;
+  }
+  return nullptr;
+}
+
+// Scans `[p, end)` block by block. The range must span at least one block, so
+// that the last, partial block can be scanned by overlapping it with the
+// previous one instead of byte by byte.
+template <typename Matcher>
+const char* ScanBlocks(const char* p, const char* end,
+                       const Matcher& matcher) {
+  assert(static_cast<size_t>(end - p) >= matcher.reach());
+  const char* const last = end - matcher.reach();
+  for (; p <= last; p += Matcher::kWidth) {
+    if (const char* found = FirstMatch(p, matcher.Match(p), matcher)) {
+      return found;
+    }
+  }
+  const size_t overlap = p - last;
+  if (overlap < Matcher::kWidth) {
+    if (const char* found =
+            FirstMatch(p, matcher.Match(last) >> overlap, matcher)) {
+      return found;
+    }
+  }
+  return end;
+}
+
+// Scans `[begin, end)` with the widest matcher whose block fits, or returns
+// nullptr if the range is shorter than any block.
+template <template <typename> class MakeMatcher, typename Arg>
+const char* ScanWidest(const char* begin, const char* end, const Arg& arg) {
+  const size_t len = end - begin;
+  static_cast<void>(len);
+#if ABSL_STRINGS_INTERNAL_DELIMITER_SCAN_AVX2
+  {
+    const typename MakeMatcher<Avx2>::type matcher(arg);
+    if (len >= matcher.reach()) return ScanBlocks(begin, end, matcher);
+  }
+#endif
+#if ABSL_STRINGS_INTERNAL_DELIMITER_SCAN_SSE2
+  {
+    const typename MakeMatcher<Sse2>::type matcher(arg);
+    if (len >= matcher.reach()) return ScanBlocks(begin, end, matcher);
+  }
+#endif
+  return nullptr;
+}
+
+template <size_t N>
+struct Chars {
+  template <typename Simd>
+  struct Matcher {
+    using type = CharsMatcher<Simd, N>;
+  };
+};
+
+template <typename Simd>
+struct String {
+  using type = StringMatcher<Simd>;
+};
+
+}  // namespace
+
+const char* FindChar(const char* begin, const char* end, char c) {
+  if (const char* found = ScanWidest<Chars<1>::Matcher>(begin, end, &c)) {
+    return found;
+  }
+  if (begin == end) return end;
+  const void* found = std::memchr(begin, c, end - begin);
+  return found != nullptr ? static_cast<const char*>(found) : end;
+}
+
+const char* FindString(const char* begin, const char* end,
+                       absl::string_view needle) {
+  assert(!needle.empty());
+  if (needle.size() == 1) return FindChar(begin, end, needle.front());
+  if (static_cast<size_t>(end - begin) < needle.size()) return end;
+  if (const char* found = ScanWidest<String>(begin, end, needle)) {
+    return found;
+  }
+  const char* found =
+      memmatch(begin, end - begin, needle.data(), needle.size());
+  return found != nullptr ? found : end;
+}
+
+CharSetFinder::CharSetFinder(absl::string_view chars)
+    : map_(chars.data(), static_cast<int>(chars.size())),
+      chars_(),
+      num_chars_(0) {
+  for (int c = 0; c < 256; ++c) {
+    if (!map_.contains(static_cast<unsigned char>(c))) continue;
+    if (num_chars_ < kMaxVectorChars) {
+      chars_[num_chars_] = static_cast<char>(c);
+    }
+    ++num_chars_;
+  }
+  if (num_chars_ != 0 && num_chars_ <= kMaxVectorChars) {
+    for (size_t i = num_chars_; i < kMaxVectorChars; ++i) {
+      chars_[i] = chars_[0];
+    }
+  }
+}
+
+const char* CharSetFinder::Find(const char* begin, const char* end) const {
+  assert(num_chars_ != 0);
+  const char* found = nullptr;
+  switch (num_chars_) {
+    case 1:
+      return FindChar(begin, end, chars_[0]);
+    case 2:
+      found = ScanWidest<Chars<2>::Matcher>(begin, end, chars_);
+      break;
+    case 3:
+    case 4:
+      found = ScanWidest<Chars<4>::Matcher>(begin, end, chars_);
+      break;
+    default:
+      break;
+  }
+  if (found != nullptr) return found;
+  for (; begin < end; ++begin) {
+    if (map_.contains(static_cast<unsigned char>(*begin))) break;
+  }
+  return begin;
+}
+
+}  // namespace strings_internal
+}  // namespace absl
@@ -0,0 +1,66 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// This file declares the routines the StrSplit delimiters use to find the next
+// delimiter. On x86 they compare 16 bytes at a time with SSE2, or 32 bytes at a
+// time when AVX2 is enabled, and turn the comparison into a bit mask whose
+// lowest set bit is the match. Elsewhere they fall back to memchr(), a
+// `Charmap` lookup and `memmatch()`.
+//
+// All of them return a pointer to the first match in `[begin, end)`, or `end`.
+
+#ifndef ABSL_STRINGS_INTERNAL_DELIMITER_SCAN_H_
+#define ABSL_STRINGS_INTERNAL_DELIMITER_SCAN_H_
+
+#include <cstddef>
+
+#include "absl/strings/internal/char_map.h"
+#include "absl/strings/string_view.h"
+
+namespace absl {
+namespace strings_internal {
+
+// Finds the first byte equal to `c`.
+const char* FindChar(const char* begin, const char* end, char c);
+
+// Finds the first occurrence of `needle`, which must not be empty.
+const char* FindString(const char* begin, const char* end,
+                       absl::string_view needle);
+
+// A set of characters to search for. The set is built once, when the
+// delimiter is constructed. Sets of up to `kMaxVectorChars` distinct characters
+// are compared against each input block directly; larger sets are looked up
+// byte by byte in a `Charmap`.
+class CharSetFinder {
+ public:
+  static constexpr size_t kMaxVectorChars = 4;
+
+  explicit CharSetFinder(absl::string_view chars);
+
+  // Finds the first byte in the set. The set must not be empty.
+  const char* Find(const char* begin, const char* end) const;
+
+ private:
+  Charmap map_;
+  // The distinct characters of the set, repeated to fill the array, when there
+  // are at most `kMaxVectorChars` of them.
+  char chars_[kMaxVectorChars];
+  size_t num_chars_;
+};
+
+}  // namespace strings_internal
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_INTERNAL_DELIMITER_SCAN_H_
@@ -0,0 +1,129 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/internal/delimiter_scan.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+
+namespace {
+
+using absl::strings_internal::CharSetFinder;
+using absl::strings_internal::FindChar;
+using absl::strings_internal::FindString;
+
+// Random text over a small alphabet, so that matches are frequent, with the
+// bytes that need care in a signed char: NUL and bytes above 0x7f.
+std::string RandomText(std::mt19937* rng, size_t len) {
+  static constexpr char kAlphabet[] = {'a', 'b', ',', '\t', '\0', '\xff',
+                                       '\x80'};
+  std::uniform_int_distribution<size_t> pick(0, sizeof(kAlphabet) - 1);
+  std::string s(len, 'x');
+  // Leave long runs without any match, so that whole blocks are skipped.
+  for (char& c : s) {
+    if (pick(*rng) == 0) c = kAlphabet[pick(*rng)];
+  }
+  return s;
+}
+
+const char* NaiveFindAnyOf(const char* begin, const char* end,
+                           absl::string_view chars) {
+  return std::find_first_of(begin, end, chars.begin(), chars.end());
+}
+
+const char* NaiveFindString(const char* begin, const char* end,
+                            absl::string_view needle) {
+  return std::search(begin, end, needle.begin(), needle.end());
+}
+
+// Every length up to a few blocks, and every start and end offset, so that all
+// of the block loop, the overlapping last block and the short tail are hit.
+template <typename Find, typename Expected>
+void CheckAllRanges(Find find, Expected expected) {
+  std::mt19937 rng(17);
+  for (size_t len = 0; len <= 100; ++len) {
+    const std::string text = RandomText(&rng, len);
+    const char* data = text.data();
+    for (size_t b = 0; b <= len; ++b) {
+      for (size_t e = b; e <= len; e += 1 + (e - b) / 8) {
+        ASSERT_EQ(expected(data + b, data + e) - data,
+                  find(data + b, data + e) - data)
+            << "len=" << len << " b=" << b << " e=" << e;
+      }
+    }
+  }
+}
+
+TEST(DelimiterScan, FindChar) {
+  for (char c : {',', '\0', '\xff', 'z'}) {
+    const std::string chars(1, c);
+    CheckAllRanges(
+        [c](const char* b, const char* e) { return FindChar(b, e, c); },
+        [&](const char* b, const char* e) {
+          return NaiveFindAnyOf(b, e, chars);
+        });
+  }
+}
+
+TEST(DelimiterScan, CharSetFinder) {
+  for (absl::string_view chars :
+       {absl::string_view(","), absl::string_view(",\t"),
+        absl::string_view(",,,"), absl::string_view("a\t,"),
+        absl::string_view("\0\xff", 2), absl::string_view(",\t\x80" "b"),
+        absl::string_view(",\tab\xff"), absl::string_view("z")}) {
+    const CharSetFinder finder(chars);
+    CheckAllRanges(
+        [&](const char* b, const char* e) { return finder.Find(b, e); },
+        [&](const char* b, const char* e) {
+          return NaiveFindAnyOf(b, e, chars);
+        });
+  }
+}
+
+TEST(DelimiterScan, FindString) {
+  for (absl::string_view needle :
+       {absl::string_view(","), absl::string_view("a,"),
+        absl::string_view(",,"), absl::string_view("a\0b", 3),
+        absl::string_view("\xff\t"), absl::string_view("xxxxxxxxxxxxxxxxxxxxa"),
+        absl::string_view("abcdefghijklmnopqrstuvwxyz0123456789")}) {
+    CheckAllRanges(
+        [&](const char* b, const char* e) { return FindString(b, e, needle); },
+        [&](const char* b, const char* e) {
+          return NaiveFindString(b, e, needle);
+        });
+  }
+}
+
+TEST(DelimiterScan, MatchAtEveryPosition) {
+  for (size_t len = 1; len <= 80; ++len) {
+    for (size_t at = 0; at < len; ++at) {
+      std::string text(len, 'x');
+      text[at] = ';';
+      const char* b = text.data();
+      const char* e = b + len;
+      EXPECT_EQ(at, FindChar(b, e, ';') - b);
+      EXPECT_EQ(at, CharSetFinder(";:").Find(b, e) - b);
+      EXPECT_EQ(at, CharSetFinder(";:!?-+").Find(b, e) - b);
+      if (at > 0) {
+        EXPECT_EQ(at - 1, FindString(b, e, "x;") - b);
+      }
+    }
+  }
+}
+
+}  // namespace
@@ -1,10 +1,14 @@
 #include "absl/strings/internal/str_format/bind.h"
 
 #include <cerrno>
+#include <cstdint>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
 
+#include "absl/base/config.h"
+
 namespace absl {
 namespace str_format_internal {
 
@@ -103,16 +107,111 @@ class ConverterConsumer {
   ArgContext arg_context_;
 };
 
+// The formats recently used on this thread, parsed, so that a hot call such
+// as `StrFormat("%s:%d", ...)` does not parse its format every time.
+//
+// Entries are found by the address of the format, which is fixed for the
+// string literals that nearly all formats are.  A format is parsed into the
+// cache only the second time it is seen at an address, so that formats built
+// at run time do not pay for it, and a hit is checked against the full text,
+// since a buffer can be reused for a different format.
+class ParsedFormatCache {
+ public:
+  // Returns this thread's cache, or null if it is already in use further up
+  // the stack: a conversion can format in turn, and must not evict the format
+  // being processed.  A non-null result must be handed back to Release().
+  static ParsedFormatCache* Acquire() {
+#if ABSL_HAVE_THREAD_LOCAL
+    // The destructor of a thread_local constructed before the cache may
+    // format after the cache is gone.
+    if (Destroyed()) return nullptr;
+    static thread_local ParsedFormatCache cache;
+    if (cache.in_use_) return nullptr;
+    cache.in_use_ = true;
+    return &cache;
+#else
+    return nullptr;
+#endif
+  }
+
+  void Release() { in_use_ = false; }
+
+#if ABSL_HAVE_THREAD_LOCAL
+  ~ParsedFormatCache() { Destroyed() = true; }
+#endif
+
+  // Returns the parsed `format`, or null if it is not cached or does not
+  // parse.
+  const ParsedFormatBase* Find(string_view format) {
+    Entry& entry = entries_[Slot(format.data())];
+    if (entry.data != format.data() || entry.size != format.size()) {
+      entry.data = format.data();
+      entry.size = format.size();
+      entry.text.clear();
+      entry.parsed.reset();
+      return nullptr;
+    }
+    if (entry.parsed == nullptr || entry.text != format) {
+      if (format.size() > kMaxFormatSize) return nullptr;
+      entry.text.assign(format.data(), format.size());
+      entry.parsed.reset(new ParsedFormatBase(format));
+    }
+    return entry.parsed->has_error() ? nullptr : entry.parsed.get();
+  }
+
+ private:
+  static constexpr size_t kNumEntries = 64;
+  // Longer formats are mostly text, which parses as fast as it copies.
+  static constexpr size_t kMaxFormatSize = 1024;
+
+  struct Entry {
+    const char* data = nullptr;
+    size_t size = 0;
+    std::string text;
+    std::unique_ptr<ParsedFormatBase> parsed;
+  };
+
+#if ABSL_HAVE_THREAD_LOCAL
+  // Whether this thread's cache has been destroyed.  Being trivially
+  // destructible, it remains usable until the thread is gone.
+  static bool& Destroyed() {
+    static thread_local bool destroyed = false;
+    return destroyed;
+  }
+#endif
+
+  static size_t Slot(const char* data) {
+    uint64_t h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(data));
+    return static_cast<size_t>((h * 0x9E3779B97F4A7C15u) >> 58) % kNumEntries;
+  }
+
+  bool in_use_ = false;
+  Entry entries_[kNumEntries];
+};
+
 template <typename Converter>
 bool ConvertAll(const UntypedFormatSpecImpl format,
                 absl::Span<const FormatArgImpl> args, Converter converter) {
   if (format.has_parsed_conversion()) {
     return format.parsed_conversion()->ProcessFormat(
         ConverterConsumer<Converter>(converter, args));
-  } else {
+  }
+  ParsedFormatCache* cache = ParsedFormatCache::Acquire();
+  if (cache == nullptr) {
     return ParseFormatString(format.str(),
                              ConverterConsumer<Converter>(converter, args));
   }
+  // Hands the cache back even if a conversion throws.
+  struct Releaser {
+    ~Releaser() { cache->Release(); }
+    ParsedFormatCache* cache;
+  } releaser{cache};
+  if (const ParsedFormatBase* parsed = cache->Find(format.str())) {
+    return parsed->ProcessFormat(
+        ConverterConsumer<Converter>(converter, args));
+  }
+  return ParseFormatString(format.str(),
+                           ConverterConsumer<Converter>(converter, args));
 }
 
 class DefaultConverter {
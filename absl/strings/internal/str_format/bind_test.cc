@@ -2,8 +2,12 @@
 
 #include <string.h>
 #include <limits>
+#include <ostream>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
 
 #include "gtest/gtest.h"
+#include "absl/base/config.h"
 
 namespace absl {
 namespace str_format_internal {
@@ -141,6 +145,78 @@ TEST_F(FormatBindTest, FormatPack) {
   }
 }
 
+// Hot formats are parsed once per thread and found again by address, so a
+// buffer that is reused for a different format must not see the old one.
+TEST_F(FormatBindTest, FormatPackWithReusedBuffer) {
+  const int ia[] = {1, 2};
+  const FormatArgImpl args[] = {FormatArgImpl(ia[0]), FormatArgImpl(ia[1])};
+  char buf[] = "%d-%d";
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ("1-2", FormatPack(UntypedFormatSpecImpl(buf), args));
+  }
+  buf[2] = '+';
+  EXPECT_EQ("1+2", FormatPack(UntypedFormatSpecImpl(buf), args));
+  buf[3] = 'x';
+  buf[4] = '\0';
+  EXPECT_EQ("1+x", FormatPack(UntypedFormatSpecImpl(buf), args));
+  buf[1] = 'q';
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ("", FormatPack(UntypedFormatSpecImpl(buf), args));
+  }
+}
+
+struct FormatsWhenStreamed {
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const FormatsWhenStreamed &) {
+    const int value = 7;
+    const FormatArgImpl arg(value);
+    return os << FormatPack(UntypedFormatSpecImpl("<%d>"), {&arg, 1});
+  }
+};
+
+// A conversion that formats in turn must not disturb the format that is
+// being processed.
+TEST_F(FormatBindTest, FormatPackNested) {
+  const FormatsWhenStreamed nested;
+  const StreamedWrapper<FormatsWhenStreamed> streamed(nested);
+  const FormatArgImpl args[] = {FormatArgImpl(streamed), FormatArgImpl(3)};
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ("a<7>b3c",
+              FormatPack(UntypedFormatSpecImpl("a%sb%dc"), args));
+  }
+}
+
+#if ABSL_HAVE_THREAD_LOCAL
+std::string* formatted_at_thread_exit;
+
+// Formats from its destructor, which runs after this thread's cache of
+// parsed formats is destroyed if it was constructed before the cache.
+struct FormatsAtThreadExit {
+  ~FormatsAtThreadExit() {
+    const int value = 5;
+    const FormatArgImpl arg(value);
+    for (int i = 0; i < 3; ++i) {
+      *formatted_at_thread_exit +=
+          FormatPack(UntypedFormatSpecImpl("[%d]"), {&arg, 1});
+    }
+  }
+};
+
+TEST_F(FormatBindTest, FormatPackFromThreadLocalDestructor) {
+  std::string formatted;
+  formatted_at_thread_exit = &formatted;
+  std::thread([] {
+    static thread_local FormatsAtThreadExit formats_at_exit;
+    (void)formats_at_exit;
+    const FormatArgImpl arg(1);
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_EQ("[1]", FormatPack(UntypedFormatSpecImpl("[%d]"), {&arg, 1}));
+    }
+  }).join();
+  EXPECT_EQ("[5][5][5]", formatted);
+}
+#endif  // ABSL_HAVE_THREAD_LOCAL
+
 }  // namespace
 }  // namespace str_format_internal
 }  // namespace absl
@@ -2,7 +2,10 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <cmath>
+#include <limits>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "absl/strings/internal/str_format/bind.h"
@@ -459,6 +462,50 @@ TEST_F(FormatConvertTest, Float) {
   }
 }
 
+// Values and precisions that do not fit in a machine word are printed with
+// multi-word arithmetic, which must still agree with the C library digit for
+// digit.
+TEST_F(FormatConvertTest, FloatExactDigits) {
+#if _MSC_VER
+  return;
+#endif  // _MSC_VER
+
+  const char *const kFormats[] = {"%.0", "%.17", "%.40", "%#.45",
+                                  "%.100", "%.400", "%.770"};
+
+  std::vector<double> doubles = {0.5,
+                                 2.5,
+                                 1e23,
+                                 0.1,
+                                 1e-300,
+                                 5e-324,
+                                 9.5e-7,
+                                 999999999999999999999.5,
+                                 std::numeric_limits<double>::max()};
+  std::mt19937_64 rng(2018);
+  for (int i = 0; i < 200; ++i) {
+    std::uniform_int_distribution<int> exp(-1074, 1000);
+    doubles.push_back(std::ldexp(static_cast<double>(rng() >> 11), exp(rng)));
+  }
+
+  for (const char *fmt : kFormats) {
+    for (char f : {'f', 'g', 'G', 'e', 'E'}) {
+      std::string fmt_str = std::string(fmt) + f;
+      for (double d : doubles) {
+        FormatArgImpl arg(d);
+        UntypedFormatSpecImpl format(fmt_str);
+        ASSERT_EQ(StrPrint(fmt_str.c_str(), d), FormatPack(format, {&arg, 1}))
+            << fmt_str << " " << StrPrint("%a", d);
+        float x = static_cast<float>(d);
+        FormatArgImpl float_arg(x);
+        ASSERT_EQ(StrPrint(fmt_str.c_str(), x),
+                  FormatPack(format, {&float_arg, 1}))
+            << fmt_str << " " << StrPrint("%a", x);
+      }
+    }
+  }
+}
+
 TEST_F(FormatConvertTest, LongDouble) {
   const char *const kFormats[] = {"%",    "%.3", "%8.5", "%9",
                                   "%.60", "%+",  "% ",   "%-10"};
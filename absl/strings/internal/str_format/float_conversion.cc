@@ -4,7 +4,9 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace absl {
 namespace str_format_internal {
@@ -132,7 +134,8 @@ void RoundUp(Buffer *buffer, int *exp) {
   }
 }
 
-void PrintExponent(int exp, char e, Buffer *out) {
+template <typename Out>
+void PrintExponent(int exp, char e, Out *out) {
   out->push_back(e);
   if (exp < 0) {
     out->push_back('-');
@@ -140,9 +143,10 @@ void PrintExponent(int exp, char e, Buffer *out) {
   } else {
     out->push_back('+');
   }
-  // Exponent digits.
+  // Exponent digits.  Only long double needs a fourth.
+  if (exp > 999) out->push_back(exp / 1000 + '0');
   if (exp > 99) {
-    out->push_back(exp / 100 + '0');
+    out->push_back(exp / 100 % 10 + '0');
     out->push_back(exp / 10 % 10 + '0');
     out->push_back(exp % 10 + '0');
   } else {
@@ -368,6 +372,255 @@ void WriteBufferToSink(char sign_char, string_view str,
   sink->Append(right_spaces, ' ');
 }
 
+// The exact decimal expansion of `mantissa * 2**exp`, for the values and
+// precisions FloatToBuffer cannot fit in a machine word.  The integer part is
+// converted up front; fractional digits are produced on demand, nine at a
+// time, by multiplying a multi-word binary fraction by 10**9.
+class ExactDecimal {
+ public:
+  ExactDecimal(std::uint64_t mantissa, int exp) : zero_(mantissa == 0) {
+    if (exp >= 0) {
+      SetInteger(mantissa, exp);
+    } else if (exp > -64) {
+      SetInteger(mantissa >> -exp, 0);
+      SetFraction(mantissa & ((std::uint64_t{1} << -exp) - 1), -exp);
+    } else {
+      SetFraction(mantissa, -exp);
+    }
+  }
+
+  bool zero() const { return zero_; }
+
+  // The digits of the integer part, or an empty string if it is zero.
+  const std::string &integer_digits() const { return integer_digits_; }
+
+  char NextFractionDigit() {
+    if (chunk_pos_ == kChunkDigits) NextChunk();
+    return chunk_[chunk_pos_++];
+  }
+
+  // Whether the fractional digits not yet returned are all zero.
+  bool FractionIsZero() const {
+    return begin_ == fraction_.size() &&
+           std::all_of(chunk_ + chunk_pos_, chunk_ + kChunkDigits,
+                       [](char c) { return c == '0'; });
+  }
+
+ private:
+  static constexpr int kChunkDigits = 9;
+  static constexpr std::uint32_t kChunkBase = 1000000000;
+
+  void SetInteger(std::uint64_t mantissa, int exp) {
+    // Little-endian 32-bit words of mantissa << exp.
+    std::vector<std::uint32_t> words(exp / 32 + 3);
+    const int shift = exp % 32;
+    std::uint32_t *w = &words[exp / 32];
+    w[0] = static_cast<std::uint32_t>(mantissa << shift);
+    w[1] = static_cast<std::uint32_t>((mantissa << shift) >> 32);
+    w[2] = shift ? static_cast<std::uint32_t>(mantissa >> (64 - shift)) : 0;
+
+    // Divide by 10**9 repeatedly, which yields the digits nine at a time from
+    // the right.
+    std::string reversed;
+    while (!words.empty()) {
+      while (!words.empty() && words.back() == 0) words.pop_back();
+      if (words.empty()) break;
+      std::uint64_t rem = 0;
+      for (size_t i = words.size(); i-- > 0;) {
+        std::uint64_t cur = (rem << 32) | words[i];
+        words[i] = static_cast<std::uint32_t>(cur / kChunkBase);
+        rem = cur % kChunkBase;
+      }
+      for (int i = 0; i < kChunkDigits; ++i, rem /= 10) {
+        reversed.push_back('0' + rem % 10);
+      }
+    }
+    while (!reversed.empty() && reversed.back() == '0') reversed.pop_back();
+    integer_digits_.assign(reversed.rbegin(), reversed.rend());
+  }
+
+  // Stores bits / 2**exp, where bits < 2**exp, as a fraction over a whole
+  // number of words.
+  void SetFraction(std::uint64_t bits, int exp) {
+    const size_t num_words = (exp + 31) / 32;
+    const int shift = static_cast<int>(32 * num_words) - exp;
+    fraction_.assign(std::max<size_t>(num_words, 3), 0);
+    fraction_[0] = static_cast<std::uint32_t>(bits << shift);
+    fraction_[1] = static_cast<std::uint32_t>((bits << shift) >> 32);
+    fraction_[2] = shift ? static_cast<std::uint32_t>(bits >> (64 - shift)) : 0;
+    fraction_.resize(num_words);
+    SkipZeroWords();
+  }
+
+  void NextChunk() {
+    std::uint64_t carry = 0;
+    for (size_t i = begin_; i < fraction_.size(); ++i) {
+      std::uint64_t cur = std::uint64_t{fraction_[i]} * kChunkBase + carry;
+      fraction_[i] = static_cast<std::uint32_t>(cur);
+      carry = cur >> 32;
+    }
+    SkipZeroWords();
+    for (int i = kChunkDigits; i-- > 0; carry /= 10) {
+      chunk_[i] = '0' + carry % 10;
+    }
+    chunk_pos_ = 0;
+  }
+
+  // Each multiplication by 10**9 clears nine more low bits; the zero words
+  // stay zero and need not be multiplied again.
+  void SkipZeroWords() {
+    while (begin_ < fraction_.size() && fraction_[begin_] == 0) ++begin_;
+  }
+
+  bool zero_;
+  std::string integer_digits_;
+  std::vector<std::uint32_t> fraction_;
+  size_t begin_ = 0;
+  char chunk_[kChunkDigits] = {'0', '0', '0', '0', '0', '0', '0', '0', '0'};
+  int chunk_pos_ = kChunkDigits;
+};
+
+bool ShouldRoundUp(char last_digit, char next_digit, bool rest_nonzero) {
+  return next_digit > '5' ||
+         (next_digit == '5' && (rest_nonzero || (last_digit - '0') % 2 == 1));
+}
+
+// Adds one unit in the last place.  Returns true if it carried out of the
+// first digit, leaving only zeros.
+bool IncrementDigits(std::string *digits) {
+  for (auto it = digits->rbegin(); it != digits->rend(); ++it) {
+    if (*it != '9') {
+      ++*it;
+      return false;
+    }
+    *it = '0';
+  }
+  return true;
+}
+
+// Appends the value with `precision` fractional digits, as "%f" does.
+void PrintExactFixed(ExactDecimal *decimal, int precision, bool alt,
+                     std::string *out) {
+  std::string digits =
+      decimal->integer_digits().empty() ? "0" : decimal->integer_digits();
+  size_t integer_length = digits.size();
+  for (int i = 0; i <= precision; ++i) {
+    digits.push_back(decimal->NextFractionDigit());
+  }
+  const char next_digit = digits.back();
+  digits.pop_back();
+  if (ShouldRoundUp(digits.back(), next_digit, !decimal->FractionIsZero()) &&
+      IncrementDigits(&digits)) {
+    digits.insert(digits.begin(), '1');
+    ++integer_length;
+  }
+  out->append(digits, 0, integer_length);
+  if (precision > 0 || alt) out->push_back('.');
+  out->append(digits, integer_length, std::string::npos);
+}
+
+// Sets `*digits` to the first `count` significant digits of the value,
+// rounded, and returns the decimal exponent of the first one.
+int ExactSignificantDigits(ExactDecimal *decimal, int count,
+                           std::string *digits) {
+  if (decimal->zero()) {
+    digits->assign(count, '0');
+    return 0;
+  }
+  *digits = decimal->integer_digits();
+  int exp;
+  if (!digits->empty()) {
+    exp = static_cast<int>(digits->size()) - 1;
+  } else {
+    exp = -1;
+    char c;
+    while ((c = decimal->NextFractionDigit()) == '0') --exp;
+    digits->push_back(c);
+  }
+  while (static_cast<int>(digits->size()) <= count) {
+    digits->push_back(decimal->NextFractionDigit());
+  }
+  const char next_digit = (*digits)[count];
+  const bool rest_nonzero =
+      !decimal->FractionIsZero() ||
+      std::any_of(digits->begin() + count + 1, digits->end(),
+                  [](char c) { return c != '0'; });
+  digits->resize(count);
+  if (ShouldRoundUp(digits->back(), next_digit, rest_nonzero) &&
+      IncrementDigits(digits)) {
+    digits->front() = '1';
+    ++exp;
+  }
+  return exp;
+}
+
+// Prints the values that FloatToBuffer could not, with as many words as the
+// value and precision need.
+template <typename Float>
+bool ExactFloatToSink(const Float v, char sign_char,
+                      Decomposed<Float> decomposed, const ConversionSpec &conv,
+                      FormatSinkImpl *sink) {
+  if (!CanFitMantissa<Float, std::uint64_t>()) {
+    return FallbackToSnprintf(v, conv, sink);
+  }
+  ExactDecimal decimal(static_cast<std::uint64_t>(decomposed.mantissa),
+                       decomposed.exponent);
+  const int precision = conv.precision() < 0 ? 6 : conv.precision();
+  const bool alt = conv.flags().alt;
+  const char e = conv.conv().upper() ? 'E' : 'e';
+
+  std::string out;
+  std::string digits;
+  switch (conv.conv().id()) {
+    case ConversionChar::f:
+    case ConversionChar::F:
+      PrintExactFixed(&decimal, precision, alt, &out);
+      break;
+
+    case ConversionChar::e:
+    case ConversionChar::E: {
+      int exp = ExactSignificantDigits(&decimal, precision + 1, &digits);
+      out.push_back(digits[0]);
+      if (precision > 0 || alt) out.push_back('.');
+      out.append(digits, 1, std::string::npos);
+      PrintExponent(exp, e, &out);
+      break;
+    }
+
+    case ConversionChar::g:
+    case ConversionChar::G: {
+      const int significant = std::max(1, precision);
+      int exp = ExactSignificantDigits(&decimal, significant, &digits);
+      const bool fixed = significant > exp && exp >= -4;
+      if (!fixed) {
+        out.push_back(digits[0]);
+        out.push_back('.');
+        out.append(digits, 1, std::string::npos);
+      } else if (exp >= 0) {
+        out.append(digits, 0, exp + 1);
+        out.push_back('.');
+        out.append(digits, exp + 1, std::string::npos);
+      } else {
+        out.append("0.");
+        out.append(-exp - 1, '0');
+        out.append(digits);
+      }
+      if (!alt) {
+        while (out.back() == '0') out.pop_back();
+        if (out.back() == '.') out.pop_back();
+      }
+      if (!fixed) PrintExponent(exp, e, &out);
+      break;
+    }
+
+    default:
+      return false;
+  }
+
+  WriteBufferToSink(sign_char, out, conv, sink);
+  return true;
+}
+
 template <typename Float>
 bool FloatToSink(const Float v, const ConversionSpec &conv,
                  FormatSinkImpl *sink) {
@@ -401,7 +654,7 @@ bool FloatToSink(const Float v, const ConversionSpec &conv,
     case ConversionChar::F:
       if (!FloatToBuffer<FormatStyle::Fixed>(decomposed, precision, &buffer,
                                              nullptr)) {
-        return FallbackToSnprintf(v, conv, sink);
+        return ExactFloatToSink(v, sign_char, decomposed, conv, sink);
       }
       if (!conv.flags().alt && buffer.back() == '.') buffer.pop_back();
       break;
@@ -410,7 +663,7 @@ bool FloatToSink(const Float v, const ConversionSpec &conv,
     case ConversionChar::E:
       if (!FloatToBuffer<FormatStyle::Precision>(decomposed, precision, &buffer,
                                                  &exp)) {
-        return FallbackToSnprintf(v, conv, sink);
+        return ExactFloatToSink(v, sign_char, decomposed, conv, sink);
       }
       if (!conv.flags().alt && buffer.back() == '.') buffer.pop_back();
       PrintExponent(exp, conv.conv().upper() ? 'E' : 'e', &buffer);
@@ -421,7 +674,7 @@ bool FloatToSink(const Float v, const ConversionSpec &conv,
       precision = std::max(0, precision - 1);
       if (!FloatToBuffer<FormatStyle::Precision>(decomposed, precision, &buffer,
                                                  &exp)) {
-        return FallbackToSnprintf(v, conv, sink);
+        return ExactFloatToSink(v, sign_char, decomposed, conv, sink);
       }
       if (precision + 1 > exp && exp >= -4) {
         if (exp < 0) {
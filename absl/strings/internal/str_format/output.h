@@ -31,6 +31,10 @@
 class Cord;
 
 namespace absl {
+
+class Cord;
+class StringBuilder;
+
 namespace str_format_internal {
 
 // RawSink implementation that writes into a char* buffer.
@@ -81,6 +85,16 @@ inline void AbslFormatFlush(AbslCord* out, string_view s) {
   out->Append(s);
 }
 
+// The enable_if is in the return type, since a default template argument
+// would make this a redeclaration of the ::Cord overload.
+template <class Sink>
+inline typename std::enable_if<
+    std::is_same<Sink, absl::Cord>::value ||
+    std::is_same<Sink, absl::StringBuilder>::value>::type
+AbslFormatFlush(Sink* out, string_view s) {
+  out->Append(s);
+}
+
 inline void AbslFormatFlush(FILERawSink* sink, string_view v) {
   sink->Write(v);
 }
@@ -282,6 +282,11 @@ ParsedFormatBase::ParsedFormatBase(string_view format, bool allow_ignored,
                !MatchesConversions(allow_ignored, convs);
 }
 
+ParsedFormatBase::ParsedFormatBase(string_view format)
+    : data_(format.empty() ? nullptr : new char[format.size()]) {
+  has_error_ = !ParseFormatString(format, ParsedFormatConsumer(this));
+}
+
 bool ParsedFormatBase::MatchesConversions(
     bool allow_ignored, std::initializer_list<Conv> convs) const {
   std::unordered_set<int> used;
@@ -149,6 +149,11 @@ class ParsedFormatBase {
   explicit ParsedFormatBase(string_view format, bool allow_ignored,
                             std::initializer_list<Conv> convs);
 
+  // Parses `format` without checking its conversions against a signature.
+  // They are checked when each one is bound to an argument instead, as they
+  // are for a format that is not preparsed.
+  explicit ParsedFormatBase(string_view format);
+
   ParsedFormatBase(const ParsedFormatBase& other) { *this = other; }
 
   ParsedFormatBase(ParsedFormatBase&& other) { *this = std::move(other); }
@@ -0,0 +1,60 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Reading eight ASCII decimal digits at a time with 64-bit arithmetic
+// ("SIMD within a register").  A chunk is the eight characters at a position
+// loaded little-endian, so that its lowest byte is the first character.
+
+#ifndef ABSL_STRINGS_INTERNAL_SWAR_DIGITS_H_
+#define ABSL_STRINGS_INTERNAL_SWAR_DIGITS_H_
+
+#include <cstdint>
+
+#include "absl/base/internal/endian.h"
+
+namespace absl {
+namespace strings_internal {
+
+inline uint64_t LoadEightChars(const char* p) {
+  return absl::little_endian::Load64(p);
+}
+
+// Returns true if all eight characters of `chunk` are '0' through '9'.
+inline bool IsEightDigits(uint64_t chunk) {
+  // A byte below '0' borrows into its top bit when '0' is subtracted, and one
+  // above '9' carries into it when 0x46 ('9' + 0x46 == 0x7f) is added.
+  return (((chunk + 0x4646464646464646u) | (chunk - 0x3030303030303030u)) &
+          0x8080808080808080u) == 0;
+}
+
+// Returns the value of the eight digits in `chunk`, which must satisfy
+// IsEightDigits().
+inline uint32_t ParseEightDigits(uint64_t chunk) {
+  chunk -= 0x3030303030303030u;
+  // Combine adjacent digits into four two-digit values in alternate bytes...
+  chunk = chunk * 10 + (chunk >> 8);
+  // ...and then those into one, with two multiplications that each combine
+  // two pairs.
+  constexpr uint64_t kPairMask = 0x000000FF000000FFu;
+  constexpr uint64_t kHighPairs = 100 + (uint64_t{1000000} << 32);
+  constexpr uint64_t kLowPairs = 1 + (uint64_t{10000} << 32);
+  return static_cast<uint32_t>(((chunk & kPairMask) * kHighPairs +
+                                ((chunk >> 16) & kPairMask) * kLowPairs) >>
+                               32);
+}
+
+}  // namespace strings_internal
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_INTERNAL_SWAR_DIGITS_H_
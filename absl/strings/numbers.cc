@@ -30,11 +30,14 @@
 #include <memory>
 #include <utility>
 
+#include "absl/base/attributes.h"
 #include "absl/base/internal/bits.h"
 #include "absl/base/internal/raw_logging.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/charconv.h"
 #include "absl/strings/internal/memutil.h"
+#include "absl/strings/internal/resize_uninitialized.h"
+#include "absl/strings/internal/swar_digits.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 
@@ -146,6 +149,24 @@ bool SimpleAtob(absl::string_view str, bool* out) {
   return false;
 }
 
+size_t SimpleAtofBatch(absl::Span<const absl::string_view> fields,
+                       absl::Span<float> out) {
+  assert(out.size() >= fields.size());
+  for (size_t i = 0; i < fields.size(); ++i) {
+    if (!SimpleAtof(fields[i], &out[i])) return i;
+  }
+  return fields.size();
+}
+
+size_t SimpleAtodBatch(absl::Span<const absl::string_view> fields,
+                       absl::Span<double> out) {
+  assert(out.size() >= fields.size());
+  for (size_t i = 0; i < fields.size(); ++i) {
+    if (!SimpleAtod(fields[i], &out[i])) return i;
+  }
+  return fields.size();
+}
+
 // ----------------------------------------------------------------------
 // FastIntToBuffer() overloads
 //
@@ -300,6 +321,231 @@ char* numbers_internal::FastIntToBuffer(int64_t i, char* buffer) {
   return numbers_internal::FastIntToBuffer(u, buffer);
 }
 
+// ----------------------------------------------------------------------
+// AppendJoinedNumbers() overloads
+//
+// Integers are measured before they are written: a first pass sums their
+// exact lengths, so the output is sized once, and a second pass writes each
+// one back to front, two digits at a time, into its known span.
+// ----------------------------------------------------------------------
+
+namespace {
+
+// kPowersOfTen[n] is 10**n.
+constexpr uint64_t kPowersOfTen[] = {
+    1u,
+    10u,
+    100u,
+    1000u,
+    10000u,
+    100000u,
+    1000000u,
+    10000000u,
+    100000000u,
+    1000000000u,
+    10000000000u,
+    100000000000u,
+    1000000000000u,
+    10000000000000u,
+    100000000000000u,
+    1000000000000000u,
+    10000000000000000u,
+    100000000000000000u,
+    1000000000000000000u,
+    10000000000000000000u,
+};
+
+constexpr uint64_t kTenToTheNineteenth = kPowersOfTen[19];
+
+// Returns the number of decimal digits in `v`, counting zero as one digit.
+inline size_t DecimalDigitCount(uint64_t v) {
+  // A number of `bits` bits has floor(bits * log10(2)) digits, or one more;
+  // 1233 / 4096 is log10(2) to enough precision for 64 bits.  Powers of ten
+  // above one are even, so `v | 1` does not change the comparison but does
+  // make zero count as one digit.
+  const uint64_t v_or_1 = v | 1;
+  const int bits = 64 - base_internal::CountLeadingZeros64(v_or_1);
+  const int guess = (bits * 1233) >> 12;
+  return guess + (v_or_1 >= kPowersOfTen[guess]);
+}
+
+inline size_t DecimalDigitCount(uint128 v) {
+  if (Uint128High64(v) == 0) return DecimalDigitCount(Uint128Low64(v));
+  // 10**38; anything at least that large has the maximum of 39 digits.
+  constexpr uint128 kTenToTheThirtyEighth =
+      MakeUint128(0x4b3b4ca85a86c47a, 0x098a224000000000);
+  if (v >= kTenToTheThirtyEighth) return 39;
+  return 19 + DecimalDigitCount(Uint128Low64(v / kTenToTheNineteenth));
+}
+
+// Writes the decimal digits of `v` so that they end just before `end`.
+inline void PutDigitsBackward(uint32_t v, char* end) {
+  while (v >= 100) {
+    const uint32_t rest = v / 100;
+    end -= 2;
+    PutTwoDigits(v - rest * 100, end);
+    v = rest;
+  }
+  if (v >= 10) {
+    PutTwoDigits(v, end - 2);
+  } else {
+    end[-1] = static_cast<char>('0' + v);
+  }
+}
+
+// Writes exactly eight decimal digits of `v`, which must be less than 10**8,
+// with leading zeros, so that they end just before `end`.
+inline void PutEightDigitsBackward(uint32_t v, char* end) {
+  for (int i = 0; i < 4; ++i) {
+    const uint32_t rest = v / 100;
+    end -= 2;
+    PutTwoDigits(v - rest * 100, end);
+    v = rest;
+  }
+}
+
+// Wide values are split into eight-digit pieces, so that the digits
+// themselves are produced with cheaper 32-bit arithmetic.
+inline void PutDigitsBackward(uint64_t v, char* end) {
+  while (v >= 100000000) {
+    const uint64_t rest = v / 100000000;
+    PutEightDigitsBackward(static_cast<uint32_t>(v - rest * 100000000), end);
+    end -= 8;
+    v = rest;
+  }
+  PutDigitsBackward(static_cast<uint32_t>(v), end);
+}
+
+// Writes exactly 19 decimal digits of `v`, which must be less than 10**19,
+// with leading zeros, so that they end just before `end`.
+inline void PutNineteenDigitsBackward(uint64_t v, char* end) {
+  const uint64_t high_11 = v / 100000000;
+  PutEightDigitsBackward(static_cast<uint32_t>(v - high_11 * 100000000), end);
+  const uint64_t high_3 = high_11 / 100000000;
+  PutEightDigitsBackward(
+      static_cast<uint32_t>(high_11 - high_3 * 100000000), end - 8);
+  PutTwoDigits(static_cast<size_t>(high_3 % 100), end - 18);
+  end[-19] = static_cast<char>('0' + high_3 / 100);
+}
+
+inline void PutDigitsBackward(uint128 v, char* end) {
+  while (Uint128High64(v) != 0) {
+    const uint128 rest = v / kTenToTheNineteenth;
+    PutNineteenDigitsBackward(Uint128Low64(v - rest * kTenToTheNineteenth),
+                              end);
+    end -= 19;
+    v = rest;
+  }
+  PutDigitsBackward(Uint128Low64(v), end);
+}
+
+// The sign and magnitude of each supported integer type.  The negation is
+// done in unsigned arithmetic, as in FastIntToBuffer().
+inline bool IsNegative(int32_t v) { return v < 0; }
+inline bool IsNegative(int64_t v) { return v < 0; }
+inline bool IsNegative(uint32_t) { return false; }
+inline bool IsNegative(uint64_t) { return false; }
+inline bool IsNegative(uint128) { return false; }
+inline uint32_t Magnitude(int32_t v) {
+  return v < 0 ? 0 - static_cast<uint32_t>(v) : static_cast<uint32_t>(v);
+}
+inline uint64_t Magnitude(int64_t v) {
+  return v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+}
+inline uint32_t Magnitude(uint32_t v) { return v; }
+inline uint64_t Magnitude(uint64_t v) { return v; }
+inline uint128 Magnitude(uint128 v) { return v; }
+
+template <typename Int>
+void AppendJoinedIntegers(absl::Span<const Int> values,
+                          absl::string_view separator, std::string* dest) {
+  if (values.empty()) return;
+  size_t length = separator.size() * (values.size() - 1);
+  for (Int v : values) {
+    length += IsNegative(v) + DecimalDigitCount(Magnitude(v));
+  }
+  const size_t old_size = dest->size();
+  strings_internal::STLStringResizeUninitialized(dest, old_size + length);
+  char* out = &(*dest)[old_size];
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (i != 0) {
+      memcpy(out, separator.data(), separator.size());
+      out += separator.size();
+    }
+    if (IsNegative(values[i])) *out++ = '-';
+    const auto magnitude = Magnitude(values[i]);
+    out += DecimalDigitCount(magnitude);
+    PutDigitsBackward(magnitude, out);
+  }
+  assert(out == &(*dest)[0] + dest->size());
+}
+
+template <typename Float>
+void AppendJoinedFloats(absl::Span<const Float> values,
+                        absl::string_view separator, std::string* dest) {
+  if (values.empty()) return;
+  // SixDigitsToBuffer() output varies in length, so allocate for the longest
+  // and trim afterwards.
+  const size_t old_size = dest->size();
+  strings_internal::STLStringResizeUninitialized(
+      dest, old_size + separator.size() * (values.size() - 1) +
+                numbers_internal::kSixDigitsToBufferSize * values.size());
+  char* const begin = &(*dest)[old_size];
+  char* out = begin;
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (i != 0) {
+      memcpy(out, separator.data(), separator.size());
+      out += separator.size();
+    }
+    out += numbers_internal::SixDigitsToBuffer(values[i], out);
+  }
+  dest->resize(old_size + (out - begin));
+}
+
+}  // namespace
+
+void numbers_internal::AppendJoinedNumbers(absl::Span<const int32_t> values,
+                                           absl::string_view separator,
+                                           std::string* dest) {
+  AppendJoinedIntegers(values, separator, dest);
+}
+
+void numbers_internal::AppendJoinedNumbers(absl::Span<const uint32_t> values,
+                                           absl::string_view separator,
+                                           std::string* dest) {
+  AppendJoinedIntegers(values, separator, dest);
+}
+
+void numbers_internal::AppendJoinedNumbers(absl::Span<const int64_t> values,
+                                           absl::string_view separator,
+                                           std::string* dest) {
+  AppendJoinedIntegers(values, separator, dest);
+}
+
+void numbers_internal::AppendJoinedNumbers(absl::Span<const uint64_t> values,
+                                           absl::string_view separator,
+                                           std::string* dest) {
+  AppendJoinedIntegers(values, separator, dest);
+}
+
+void numbers_internal::AppendJoinedNumbers(absl::Span<const uint128> values,
+                                           absl::string_view separator,
+                                           std::string* dest) {
+  AppendJoinedIntegers(values, separator, dest);
+}
+
+void numbers_internal::AppendJoinedNumbers(absl::Span<const float> values,
+                                           absl::string_view separator,
+                                           std::string* dest) {
+  AppendJoinedFloats(values, separator, dest);
+}
+
+void numbers_internal::AppendJoinedNumbers(absl::Span<const double> values,
+                                           absl::string_view separator,
+                                           std::string* dest) {
+  AppendJoinedFloats(values, separator, dest);
+}
+
 // Given a 128-bit number expressed as a pair of uint64_t, high half first,
 // return that number multiplied by the given 32-bit value.  If the result is
 // too large to fit in a 128-bit number, divide it by 2 until it fits.
@@ -780,6 +1026,34 @@ const IntType LookupTables<IntType>::kVminOverBase[] =
 
 #undef X_OVER_BASE_INITIALIZER
 
+// Parses base-10 digits eight at a time from the front of [*start, end) for
+// as long as that cannot overflow, advancing `*start` past them and returning
+// their value (negated if `negative`).  Whatever is left, including every
+// error, is for the caller's digit-at-a-time loop, which then proceeds exactly
+// as if it had consumed the chunks itself.  Kept out of line so that parsing
+// the short numbers that dominate in practice does not pay for it.
+template <typename IntType, bool negative>
+ABSL_ATTRIBUTE_NOINLINE IntType ParseDecimalChunks(const char** start,
+                                                   const char* end) {
+  // Division truncates towards zero, so both limits err on the safe side.
+  constexpr IntType kChunkMax =
+      (std::numeric_limits<IntType>::max() - 99999999) / 100000000;
+  constexpr IntType kChunkMin =
+      (std::numeric_limits<IntType>::min() + 99999999) / 100000000;
+  const char* p = *start;
+  IntType value = 0;
+  while (end - p >= 8 && (negative ? value >= kChunkMin : value <= kChunkMax)) {
+    const uint64_t chunk = strings_internal::LoadEightChars(p);
+    if (!strings_internal::IsEightDigits(chunk)) break;
+    const auto digits =
+        static_cast<IntType>(strings_internal::ParseEightDigits(chunk));
+    value = negative ? value * 100000000 - digits : value * 100000000 + digits;
+    p += 8;
+  }
+  *start = p;
+  return value;
+}
+
 template <typename IntType>
 inline bool safe_parse_positive_int(absl::string_view text, int base,
                                     IntType* value_p) {
@@ -791,6 +1065,9 @@ inline bool safe_parse_positive_int(absl::string_view text, int base,
   const IntType vmax_over_base = LookupTables<IntType>::kVmaxOverBase[base];
   const char* start = text.data();
   const char* end = start + text.size();
+  if (base == 10 && end - start >= 8) {
+    value = ParseDecimalChunks<IntType, /*negative=*/false>(&start, end);
+  }
   // loop over digits
   for (; start < end; ++start) {
     unsigned char c = static_cast<unsigned char>(start[0]);
@@ -832,6 +1109,9 @@ inline bool safe_parse_negative_int(absl::string_view text, int base,
   }
   const char* start = text.data();
   const char* end = start + text.size();
+  if (base == 10 && end - start >= 8) {
+    value = ParseDecimalChunks<IntType, /*negative=*/true>(&start, end);
+  }
   // loop over digits
   for (; start < end; ++start) {
     unsigned char c = static_cast<unsigned char>(start[0]);
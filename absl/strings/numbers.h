@@ -36,6 +36,7 @@
 #include "absl/base/port.h"
 #include "absl/numeric/int128.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 
 namespace absl {
 
@@ -77,6 +78,36 @@ ABSL_MUST_USE_RESULT bool SimpleAtod(absl::string_view str, double* out);
 // unspecified state.
 ABSL_MUST_USE_RESULT bool SimpleAtob(absl::string_view str, bool* out);
 
+// SimpleAtoiBatch()
+//
+// Converts each of `fields` as `SimpleAtoi()` does, storing the value of
+// `fields[i]` in `out[i]`; `out` must be at least as long as `fields`. Returns
+// the number of leading fields converted successfully, which is
+// `fields.size()` only if all of them were. The output for the first field that
+// fails is unspecified, and the outputs after it are left untouched.
+//
+// Example:
+//
+//   std::vector<absl::string_view> fields = absl::StrSplit(line, ',');
+//   std::vector<int64_t> values(fields.size());
+//   size_t parsed = absl::SimpleAtoiBatch(fields, absl::MakeSpan(values));
+//   if (parsed != fields.size()) {
+//     return InvalidField(fields[parsed]);
+//   }
+template <typename int_type>
+ABSL_MUST_USE_RESULT size_t SimpleAtoiBatch(
+    absl::Span<const absl::string_view> fields, absl::Span<int_type> out);
+
+// SimpleAtofBatch()
+// SimpleAtodBatch()
+//
+// Converts each of `fields` as `SimpleAtof()` or `SimpleAtod()` does, with the
+// same contract as `SimpleAtoiBatch()`.
+ABSL_MUST_USE_RESULT size_t SimpleAtofBatch(
+    absl::Span<const absl::string_view> fields, absl::Span<float> out);
+ABSL_MUST_USE_RESULT size_t SimpleAtodBatch(
+    absl::Span<const absl::string_view> fields, absl::Span<double> out);
+
 }  // namespace absl
 
 // End of public API.  Implementation details follow.
@@ -133,6 +164,23 @@ char* FastIntToBuffer(int_type i, char* buffer) {
   }
 }
 
+// Appends `values` to `*dest`, each formatted as `StrCat()` would format it,
+// with `separator` between them.  This implements `absl::StrJoinNumbers()`.
+void AppendJoinedNumbers(absl::Span<const int32_t> values,
+                         absl::string_view separator, std::string* dest);
+void AppendJoinedNumbers(absl::Span<const uint32_t> values,
+                         absl::string_view separator, std::string* dest);
+void AppendJoinedNumbers(absl::Span<const int64_t> values,
+                         absl::string_view separator, std::string* dest);
+void AppendJoinedNumbers(absl::Span<const uint64_t> values,
+                         absl::string_view separator, std::string* dest);
+void AppendJoinedNumbers(absl::Span<const uint128> values,
+                         absl::string_view separator, std::string* dest);
+void AppendJoinedNumbers(absl::Span<const float> values,
+                         absl::string_view separator, std::string* dest);
+void AppendJoinedNumbers(absl::Span<const double> values,
+                         absl::string_view separator, std::string* dest);
+
 // Implementation of SimpleAtoi, generalized to support arbitrary base (used
 // with base different from 10 elsewhere in Abseil implementation).
 template <typename int_type>
@@ -184,6 +232,16 @@ ABSL_MUST_USE_RESULT bool SimpleAtoi(absl::string_view s, int_type* out) {
   return numbers_internal::safe_strtoi_base(s, out, 10);
 }
 
+template <typename int_type>
+ABSL_MUST_USE_RESULT size_t SimpleAtoiBatch(
+    absl::Span<const absl::string_view> fields, absl::Span<int_type> out) {
+  ABSL_ASSERT(out.size() >= fields.size());
+  for (size_t i = 0; i < fields.size(); ++i) {
+    if (!numbers_internal::safe_strtoi_base(fields[i], &out[i], 10)) return i;
+  }
+  return fields.size();
+}
+
 }  // namespace absl
 
 #endif  // ABSL_STRINGS_NUMBERS_H_
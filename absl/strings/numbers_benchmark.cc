@@ -21,6 +21,8 @@
 #include "benchmark/benchmark.h"
 #include "absl/base/internal/raw_logging.h"
 #include "absl/strings/numbers.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 
 namespace {
 
@@ -158,6 +160,23 @@ BENCHMARK(BM_safe_strtou64_string)
     ->ArgPair(16, 10)
     ->ArgPair(16, 16);
 
+// Parses a row of integer fields as a log ingester does: a millisecond
+// timestamp, a few ids, and some small counters.
+void BM_SimpleAtoiBatch(benchmark::State& state) {
+  const std::vector<std::string> backing_strings = {
+      "1546300800123", "4215", "18446744073709", "200", "0", "77", "65536",
+      "3141592653"};
+  const std::vector<absl::string_view> fields(backing_strings.begin(),
+                                              backing_strings.end());
+  std::vector<int64_t> values(fields.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        absl::SimpleAtoiBatch(fields, absl::MakeSpan(values)));
+  }
+  state.SetItemsProcessed(state.iterations() * fields.size());
+}
+BENCHMARK(BM_SimpleAtoiBatch);
+
 // Returns a vector of `num_strings` strings. Each string represents a
 // floating point number with `num_digits` digits before the decimal point and
 // another `num_digits` digits after.
@@ -37,6 +37,7 @@
 #include "gtest/gtest.h"
 #include "absl/base/internal/raw_logging.h"
 #include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 
 #include "absl/strings/internal/numbers_test_common.h"
 #include "absl/strings/internal/pow10_helper.h"
@@ -530,6 +531,72 @@ TEST(stringtest, safe_strto64_leading_substring) {
   EXPECT_EQ(0, value);  // there was no leading substring
 }
 
+// Base-10 parsing takes eight digits at a time; check that errors and limits
+// either side of those chunks behave as they do one digit at a time.
+TEST(stringtest, safe_strto_long_decimal) {
+  int32_t value32;
+  EXPECT_TRUE(safe_strto32_base("0000000000000002147483647", &value32, 10));
+  EXPECT_EQ(std::numeric_limits<int32_t>::max(), value32);
+  EXPECT_TRUE(safe_strto32_base("-000000002147483648", &value32, 10));
+  EXPECT_EQ(std::numeric_limits<int32_t>::min(), value32);
+  EXPECT_FALSE(safe_strto32_base("21474836470", &value32, 10));
+  EXPECT_EQ(std::numeric_limits<int32_t>::max(), value32);
+  EXPECT_FALSE(safe_strto32_base("-21474836480", &value32, 10));
+  EXPECT_EQ(std::numeric_limits<int32_t>::min(), value32);
+  EXPECT_FALSE(safe_strto32_base("1234567@9", &value32, 10));
+  EXPECT_EQ(1234567, value32);
+  EXPECT_FALSE(safe_strto32_base("12345678@", &value32, 10));
+  EXPECT_EQ(12345678, value32);
+  // Overflow is reported before a later bad character.
+  EXPECT_FALSE(safe_strto32_base("9999999999999999@", &value32, 10));
+  EXPECT_EQ(std::numeric_limits<int32_t>::max(), value32);
+
+  int64_t value64;
+  EXPECT_TRUE(safe_strto64_base("9223372036854775807", &value64, 10));
+  EXPECT_EQ(std::numeric_limits<int64_t>::max(), value64);
+  EXPECT_TRUE(safe_strto64_base("-9223372036854775808", &value64, 10));
+  EXPECT_EQ(std::numeric_limits<int64_t>::min(), value64);
+  EXPECT_FALSE(safe_strto64_base("92233720368547758070", &value64, 10));
+  EXPECT_EQ(std::numeric_limits<int64_t>::max(), value64);
+  EXPECT_FALSE(safe_strto64_base("1234567890123456:7", &value64, 10));
+  EXPECT_EQ(1234567890123456, value64);
+  EXPECT_FALSE(safe_strto64_base("-123456789012345/", &value64, 10));
+  EXPECT_EQ(-123456789012345, value64);
+
+  uint64_t valueu64;
+  EXPECT_TRUE(safe_strtou64_base("18446744073709551615", &valueu64, 10));
+  EXPECT_EQ(std::numeric_limits<uint64_t>::max(), valueu64);
+  EXPECT_FALSE(safe_strtou64_base("18446744073709551616", &valueu64, 10));
+  EXPECT_EQ(std::numeric_limits<uint64_t>::max(), valueu64);
+}
+
+TEST(NumbersTest, AtoiBatch) {
+  const std::vector<absl::string_view> fields = {"1", " -22 ", "333333333333",
+                                                 "x", "5"};
+  std::vector<int64_t> values(fields.size(), -1);
+  EXPECT_EQ(3, absl::SimpleAtoiBatch(fields, absl::MakeSpan(values)));
+  EXPECT_THAT(values, testing::ElementsAre(1, -22, 333333333333, testing::_,
+                                           -1));
+
+  // "-22" is not unsigned.
+  std::vector<uint32_t> unsigned_values(fields.size());
+  EXPECT_EQ(1, absl::SimpleAtoiBatch(fields, absl::MakeSpan(unsigned_values)));
+  EXPECT_EQ(1, unsigned_values[0]);
+  EXPECT_EQ(0, absl::SimpleAtoiBatch({}, absl::MakeSpan(unsigned_values)));
+}
+
+TEST(NumbersTest, AtodBatch) {
+  const std::vector<absl::string_view> fields = {"1.5", "-2e3", "nan?", "4"};
+  std::vector<double> doubles(fields.size());
+  EXPECT_EQ(2, absl::SimpleAtodBatch(fields, absl::MakeSpan(doubles)));
+  EXPECT_EQ(1.5, doubles[0]);
+  EXPECT_EQ(-2000, doubles[1]);
+  std::vector<float> floats(fields.size());
+  EXPECT_EQ(2, absl::SimpleAtofBatch(fields, absl::MakeSpan(floats)));
+  EXPECT_EQ(1.5f, floats[0]);
+  EXPECT_EQ(-2000.0f, floats[1]);
+}
+
 TEST(stringtest, safe_strto64_base) {
   int64_t value;
   EXPECT_TRUE(safe_strto64_base("0x3423432448783446", &value, 16));
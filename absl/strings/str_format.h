@@ -257,6 +257,10 @@ using FormatSpec =
 // dynamically through its `New()` factory function, which only constructs a
 // runtime object if the format is valid at that time.
 //
+// A string literal format that is used repeatedly on a thread is parsed only
+// once there as well, so a `ParsedFormat` is mainly useful for formats that
+// are built at run time.
+//
 // Example:
 //
 //   // Verified at compile time.
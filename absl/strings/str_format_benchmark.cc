@@ -0,0 +1,197 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/str_format.h"
+
+#include <cstdio>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "absl/strings/str_cat.h"
+
+namespace {
+
+const char kFile[] = "storage/block_cache.cc";
+const char kMessage[] = "evicted entry";
+
+// A log line prefix, the most common use of formatting.
+void BM_StrFormat_LogLine(benchmark::State& state) {
+  int line = 0;
+  for (auto _ : state) {
+    std::string out =
+        absl::StrFormat("%s:%d] %s after %d ms", kFile, line, kMessage, 17);
+    benchmark::DoNotOptimize(out);
+    ++line;
+  }
+}
+BENCHMARK(BM_StrFormat_LogLine);
+
+void BM_StrFormat_LogLine_ParsedFormat(benchmark::State& state) {
+  const absl::ParsedFormat<'s', 'd', 's', 'd'> format(
+      "%s:%d] %s after %d ms");
+  int line = 0;
+  for (auto _ : state) {
+    std::string out = absl::StrFormat(format, kFile, line, kMessage, 17);
+    benchmark::DoNotOptimize(out);
+    ++line;
+  }
+}
+BENCHMARK(BM_StrFormat_LogLine_ParsedFormat);
+
+void BM_StrCat_LogLine(benchmark::State& state) {
+  int line = 0;
+  for (auto _ : state) {
+    std::string out =
+        absl::StrCat(kFile, ":", line, "] ", kMessage, " after ", 17, " ms");
+    benchmark::DoNotOptimize(out);
+    ++line;
+  }
+}
+BENCHMARK(BM_StrCat_LogLine);
+
+void BM_Snprintf_LogLine(benchmark::State& state) {
+  char buf[128];
+  int line = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(snprintf(buf, sizeof(buf), "%s:%d] %s after %d ms",
+                                      kFile, line, kMessage, 17));
+    ++line;
+  }
+}
+BENCHMARK(BM_Snprintf_LogLine);
+
+// Flags, widths and precisions exercise the slower parts of the parser.
+void BM_StrFormat_Table(benchmark::State& state) {
+  double value = 0.5;
+  for (auto _ : state) {
+    std::string out =
+        absl::StrFormat("|%-24s|%8.3f|%08x|%+5d|", kFile, value, 0xbeef, -42);
+    benchmark::DoNotOptimize(out);
+    value += 0.25;
+  }
+}
+BENCHMARK(BM_StrFormat_Table);
+
+void BM_StrFormat_Table_ParsedFormat(benchmark::State& state) {
+  const absl::ParsedFormat<'s', 'f', 'x', 'd'> format(
+      "|%-24s|%8.3f|%08x|%+5d|");
+  double value = 0.5;
+  for (auto _ : state) {
+    std::string out = absl::StrFormat(format, kFile, value, 0xbeef, -42);
+    benchmark::DoNotOptimize(out);
+    value += 0.25;
+  }
+}
+BENCHMARK(BM_StrFormat_Table_ParsedFormat);
+
+void BM_Snprintf_Table(benchmark::State& state) {
+  char buf[128];
+  double value = 0.5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(snprintf(buf, sizeof(buf),
+                                      "|%-24s|%8.3f|%08x|%+5d|", kFile, value,
+                                      0xbeef, -42));
+    value += 0.25;
+  }
+}
+BENCHMARK(BM_Snprintf_Table);
+
+// A long template with a single conversion, where copying the text dominates.
+void BM_StrFormat_LongText(benchmark::State& state) {
+  int id = 0;
+  for (auto _ : state) {
+    std::string out = absl::StrFormat(
+        "The request could not be completed because the backend with id %d "
+        "did not answer before the deadline expired; it will be retried.",
+        id++);
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_StrFormat_LongText);
+
+void BM_StrFormat_Int(benchmark::State& state) {
+  int i = 0;
+  for (auto _ : state) {
+    std::string out = absl::StrFormat("%d", i++);
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_StrFormat_Int);
+
+void BM_StrFormat_Double(benchmark::State& state) {
+  double d = 1.0 / 3;
+  for (auto _ : state) {
+    std::string out = absl::StrFormat("%g", d);
+    benchmark::DoNotOptimize(out);
+    d *= 1.5;
+  }
+}
+BENCHMARK(BM_StrFormat_Double);
+
+void BM_StrAppendFormat(benchmark::State& state) {
+  for (auto _ : state) {
+    std::string out;
+    for (int i = 0; i < 64; ++i) {
+      absl::StrAppendFormat(&out, "%s=%d;", kMessage, i);
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(BM_StrAppendFormat);
+
+void BM_SNPrintF(benchmark::State& state) {
+  char buf[128];
+  int line = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::SNPrintF(
+        buf, sizeof(buf), "%s:%d] %s after %d ms", kFile, line, kMessage, 17));
+    ++line;
+  }
+}
+BENCHMARK(BM_SNPrintF);
+
+void BM_FPrintF(benchmark::State& state) {
+  std::FILE* devnull = std::fopen("/dev/null", "w");
+  if (devnull == nullptr) {
+    state.SkipWithError("cannot open /dev/null");
+    return;
+  }
+  int line = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::FPrintF(devnull, "%s:%d] %s after %d ms\n",
+                                           kFile, line, kMessage, 17));
+    ++line;
+  }
+  std::fclose(devnull);
+}
+BENCHMARK(BM_FPrintF);
+
+void BM_Fprintf(benchmark::State& state) {
+  std::FILE* devnull = std::fopen("/dev/null", "w");
+  if (devnull == nullptr) {
+    state.SkipWithError("cannot open /dev/null");
+    return;
+  }
+  int line = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::fprintf(devnull, "%s:%d] %s after %d ms\n",
+                                          kFile, line, kMessage, 17));
+    ++line;
+  }
+  std::fclose(devnull);
+}
+BENCHMARK(BM_Fprintf);
+
+}  // namespace
@@ -57,7 +57,9 @@
 
 #include "absl/base/macros.h"
 #include "absl/strings/internal/str_join_internal.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 
 namespace absl {
 
@@ -285,6 +287,42 @@ std::string StrJoin(const std::tuple<T...>& value,
   return strings_internal::JoinAlgorithm(value, separator, AlphaNumFormatter());
 }
 
+// -----------------------------------------------------------------------------
+// StrJoinNumbers()
+// -----------------------------------------------------------------------------
+//
+// Joins a contiguous range of numbers, such as a `std::vector<int64_t>` or an
+// `absl::Span<const double>`, and returns the result as a std::string. The
+// elements must be `int32_t`, `uint32_t`, `int64_t`, `uint64_t`,
+// `absl::uint128`, `float` or `double`, and are formatted as `StrJoin()` (that
+// is, `StrCat()`) formats them; `absl::uint128` values are written in full in
+// decimal.
+//
+// This is faster than `StrJoin()` for long runs of numbers, such as a numeric
+// column being exported as text: the output is sized once, and integers are
+// written without per-element dispatch.
+//
+// Example:
+//   std::vector<int64_t> v = {1, -22, 333};
+//   std::string s = absl::StrJoinNumbers(v, ",");
+//   EXPECT_EQ("1,-22,333", s);
+template <typename Range>
+std::string StrJoinNumbers(const Range& range, absl::string_view separator) {
+  std::string result;
+  numbers_internal::AppendJoinedNumbers(absl::MakeConstSpan(range), separator,
+                                        &result);
+  return result;
+}
+
+template <typename T>
+std::string StrJoinNumbers(std::initializer_list<T> il,
+                           absl::string_view separator) {
+  std::string result;
+  numbers_internal::AppendJoinedNumbers(
+      absl::MakeConstSpan(il.begin(), il.size()), separator, &result);
+  return result;
+}
+
 }  // namespace absl
 
 #endif  // ABSL_STRINGS_STR_JOIN_H_
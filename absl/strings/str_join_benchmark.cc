@@ -15,6 +15,8 @@
 
 #include "absl/strings/str_join.h"
 
+#include <cstdint>
+#include <random>
 #include <string>
 #include <vector>
 #include <utility>
@@ -54,6 +56,62 @@ void BM_Join2_Ints(benchmark::State& state) {
 }
 BENCHMARK(BM_Join2_Ints)->Range(0, 1 << 13);
 
+// A column of ids and timestamps of mixed widths, as a text exporter sees it.
+std::vector<int64_t> MakeInt64Column(int size) {
+  std::vector<int64_t> v;
+  std::mt19937_64 rng(1);
+  for (int i = 0; i < size; ++i) {
+    v.push_back(static_cast<int64_t>(rng() >> (rng() % 64)));
+  }
+  return v;
+}
+
+void BM_Join2_Int64Column(benchmark::State& state) {
+  const std::vector<int64_t> v = MakeInt64Column(state.range(0));
+  for (auto _ : state) {
+    std::string s = absl::StrJoin(v, ",");
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_Join2_Int64Column)->Range(1, 1 << 13);
+
+void BM_JoinNumbers_Int64Column(benchmark::State& state) {
+  const std::vector<int64_t> v = MakeInt64Column(state.range(0));
+  for (auto _ : state) {
+    std::string s = absl::StrJoinNumbers(v, ",");
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_JoinNumbers_Int64Column)->Range(1, 1 << 13);
+
+void BM_Join2_DoubleColumn(benchmark::State& state) {
+  std::mt19937_64 rng(1);
+  std::uniform_real_distribution<double> uniform(-1e6, 1e6);
+  std::vector<double> v(state.range(0));
+  for (double& d : v) d = uniform(rng);
+  for (auto _ : state) {
+    std::string s = absl::StrJoin(v, ",");
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_Join2_DoubleColumn)->Range(1, 1 << 13);
+
+void BM_JoinNumbers_DoubleColumn(benchmark::State& state) {
+  std::mt19937_64 rng(1);
+  std::uniform_real_distribution<double> uniform(-1e6, 1e6);
+  std::vector<double> v(state.range(0));
+  for (double& d : v) d = uniform(rng);
+  for (auto _ : state) {
+    std::string s = absl::StrJoinNumbers(v, ",");
+    benchmark::DoNotOptimize(s);
+  }
+  state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_JoinNumbers_DoubleColumn)->Range(1, 1 << 13);
+
 void BM_Join2_KeysAndValues(benchmark::State& state) {
   const int string_len = state.range(0);
   const int num_pairs = state.range(1);
@@ -21,6 +21,7 @@
 #include <cstdio>
 #include <functional>
 #include <initializer_list>
+#include <limits>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -31,8 +32,11 @@
 #include "gtest/gtest.h"
 #include "absl/base/macros.h"
 #include "absl/memory/memory.h"
+#include "absl/numeric/int128.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 
 namespace {
 
@@ -471,4 +475,77 @@ TEST(StrJoin, Tuple) {
                           "-", absl::DereferenceFormatter(TestFormatter())));
 }
 
+// Returns powers of ten, and their neighbours, up to the limit of `Int`, with
+// both signs when `Int` is signed.
+template <typename Int>
+std::vector<Int> DigitCountBoundaries() {
+  std::vector<Int> values = {0, std::numeric_limits<Int>::max(),
+                             std::numeric_limits<Int>::min()};
+  for (Int p = 1; p <= std::numeric_limits<Int>::max() / 10; p *= 10) {
+    for (Int v : {p - 1, p, p + 1, Int(p * 10 - 1)}) {
+      values.push_back(v);
+      values.push_back(Int(0 - v));
+    }
+  }
+  return values;
+}
+
+TEST(StrJoinNumbers, MatchesStrJoin) {
+  for (absl::string_view separator : {"", ",", " | "}) {
+    SCOPED_TRACE(separator);
+    const auto int32s = DigitCountBoundaries<int32_t>();
+    EXPECT_EQ(absl::StrJoin(int32s, separator),
+              absl::StrJoinNumbers(int32s, separator));
+    const auto uint32s = DigitCountBoundaries<uint32_t>();
+    EXPECT_EQ(absl::StrJoin(uint32s, separator),
+              absl::StrJoinNumbers(uint32s, separator));
+    const auto int64s = DigitCountBoundaries<int64_t>();
+    EXPECT_EQ(absl::StrJoin(int64s, separator),
+              absl::StrJoinNumbers(int64s, separator));
+    const auto uint64s = DigitCountBoundaries<uint64_t>();
+    EXPECT_EQ(absl::StrJoin(uint64s, separator),
+              absl::StrJoinNumbers(uint64s, separator));
+
+    const std::vector<double> doubles = {
+        0, -0.0, 1.5, -1e-300, 123456789, 0.0001, 1e100,
+        std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::quiet_NaN()};
+    EXPECT_EQ(absl::StrJoin(doubles, separator),
+              absl::StrJoinNumbers(doubles, separator));
+    const std::vector<float> floats(doubles.begin(), doubles.end());
+    EXPECT_EQ(absl::StrJoin(floats, separator),
+              absl::StrJoinNumbers(floats, separator));
+  }
+}
+
+TEST(StrJoinNumbers, Uint128) {
+  const std::vector<absl::uint128> values = {
+      0,
+      9,
+      std::numeric_limits<uint64_t>::max(),
+      absl::uint128(std::numeric_limits<uint64_t>::max()) + 1,
+      absl::MakeUint128(5, 0x6bc75e2d63100000),  // 10**20
+      absl::MakeUint128(0x4b3b4ca85a86c47a, 0x098a223fffffffff),  // 10**38 - 1
+      absl::MakeUint128(0x4b3b4ca85a86c47a, 0x098a224000000000),  // 10**38
+      absl::Uint128Max()};
+  EXPECT_EQ(
+      "0,9,18446744073709551615,18446744073709551616,100000000000000000000,"
+      "99999999999999999999999999999999999999,"
+      "100000000000000000000000000000000000000,"
+      "340282366920938463463374607431768211455",
+      absl::StrJoinNumbers(values, ","));
+}
+
+TEST(StrJoinNumbers, Ranges) {
+  EXPECT_EQ("", absl::StrJoinNumbers(std::vector<int64_t>(), "-"));
+  EXPECT_EQ("7", absl::StrJoinNumbers(std::vector<int64_t>{7}, "-"));
+  EXPECT_EQ("1-2--3", absl::StrJoinNumbers({1, 2, -3}, "-"));
+  EXPECT_EQ("0.5-0.25", absl::StrJoinNumbers({0.5, 0.25}, "-"));
+
+  const uint32_t array[] = {10, 20, 30};
+  EXPECT_EQ("10, 20, 30", absl::StrJoinNumbers(array, ", "));
+  EXPECT_EQ("20, 30",
+            absl::StrJoinNumbers(absl::MakeConstSpan(array).subspan(1), ", "));
+}
+
 }  // namespace
@@ -25,6 +25,7 @@
 
 #include "absl/base/internal/raw_logging.h"
 #include "absl/strings/ascii.h"
+#include "absl/strings/internal/delimiter_scan.h"
 
 namespace absl {
 
@@ -56,11 +57,17 @@ absl::string_view GenericFind(absl::string_view text,
   return found;
 }
 
-// Finds using absl::string_view::find(), therefore the length of the found
-// delimiter is delimiter.length().
+// Finds using strings_internal::FindString(), therefore the length of the
+// found delimiter is delimiter.length().
 struct LiteralPolicy {
   size_t Find(absl::string_view text, absl::string_view delimiter, size_t pos) {
-    return text.find(delimiter, pos);
+    if (delimiter.empty() || pos > text.size()) {
+      return text.find(delimiter, pos);
+    }
+    const char* end = text.data() + text.size();
+    const char* found =
+        strings_internal::FindString(text.data() + pos, end, delimiter);
+    return found == end ? absl::string_view::npos : found - text.data();
   }
   size_t Length(absl::string_view delimiter) { return delimiter.length(); }
 };
@@ -74,6 +81,13 @@ struct AnyOfPolicy {
   size_t Length(absl::string_view /* delimiter */) { return 1; }
 };
 
+// Returns the one-character delimiter at `found`, or the empty piece at the
+// end of `text` if `found` is the end of `text`.
+absl::string_view CharAt(absl::string_view text, const char* found) {
+  const char* end = text.data() + text.size();
+  return absl::string_view(found, found == end ? 0 : 1);
+}
+
 }  // namespace
 
 //
@@ -84,12 +98,12 @@ ByString::ByString(absl::string_view sp) : delimiter_(sp) {}
 
 absl::string_view ByString::Find(absl::string_view text, size_t pos) const {
   if (delimiter_.length() == 1) {
-    // Much faster to call find on a single character than on an
+    // Much faster to search for a single character than for an
     // absl::string_view.
-    size_t found_pos = text.find(delimiter_[0], pos);
-    if (found_pos == absl::string_view::npos)
-      return absl::string_view(text.data() + text.size(), 0);
-    return text.substr(found_pos, 1);
+    pos = std::min(pos, text.size());
+    return CharAt(text, strings_internal::FindChar(
+                            text.data() + pos, text.data() + text.size(),
+                            delimiter_[0]));
   }
   return GenericFind(text, delimiter_, pos, LiteralPolicy());
 }
@@ -99,20 +113,25 @@ absl::string_view ByString::Find(absl::string_view text, size_t pos) const {
 //
 
 absl::string_view ByChar::Find(absl::string_view text, size_t pos) const {
-  size_t found_pos = text.find(c_, pos);
-  if (found_pos == absl::string_view::npos)
-    return absl::string_view(text.data() + text.size(), 0);
-  return text.substr(found_pos, 1);
+  pos = std::min(pos, text.size());
+  return CharAt(text, strings_internal::FindChar(
+                          text.data() + pos, text.data() + text.size(), c_));
 }
 
 //
 // ByAnyChar
 //
 
-ByAnyChar::ByAnyChar(absl::string_view sp) : delimiters_(sp) {}
+ByAnyChar::ByAnyChar(absl::string_view sp)
+    : delimiters_(sp), finder_(delimiters_) {}
 
 absl::string_view ByAnyChar::Find(absl::string_view text, size_t pos) const {
-  return GenericFind(text, delimiters_, pos, AnyOfPolicy());
+  if (delimiters_.empty()) {
+    return GenericFind(text, delimiters_, pos, AnyOfPolicy());
+  }
+  pos = std::min(pos, text.size());
+  return CharAt(text, finder_.Find(text.data() + pos,
+                                   text.data() + text.size()));
 }
 
 //
@@ -44,9 +44,11 @@
 #include <vector>
 
 #include "absl/base/internal/raw_logging.h"
+#include "absl/strings/internal/delimiter_scan.h"
 #include "absl/strings/internal/str_split_internal.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/strip.h"
+#include "absl/types/span.h"
 
 namespace absl {
 
@@ -169,6 +171,10 @@ class ByChar {
 // Note: this delimiter works with single-byte string data, but does not work
 // with variable-width encodings, such as UTF-8.
 //
+// The set of characters is built when the delimiter is constructed, so reuse
+// a `ByAnyChar` rather than constructing one per call when splitting many
+// strings.
+//
 // Example:
 //
 //   using absl::ByAnyChar;
@@ -185,6 +191,7 @@ class ByAnyChar {
 
  private:
   const std::string delimiters_;
+  const strings_internal::CharSetFinder finder_;
 };
 
 // ByLength
@@ -421,6 +428,10 @@ struct SkipWhitespace {
 // 1) All standard STL containers including `std::vector`, `std::list`,
 //    `std::deque`, `std::set`,`std::multiset`, 'std::map`, and `std::multimap`
 // 2) `std::pair` (which is not actually a container). See below.
+// 3) Other containers with an `insert(iterator, value)` member, such as
+//    `absl::InlinedVector`, which does not allocate while the pieces fit in
+//    its inline capacity. To split into storage of a fixed size, such as an
+//    `absl::FixedArray` or an array on the stack, see `StrSplitInto()` below.
 //
 // Example:
 //
@@ -507,6 +518,81 @@ StrSplit(strings_internal::ConvertibleToStringView text, Delimiter d,
       std::move(text), DelimiterType(d), std::move(p));
 }
 
+//------------------------------------------------------------------------------
+//                                StrSplitInto()
+//------------------------------------------------------------------------------
+
+// SplitOverflow
+//
+// What `StrSplitInto()` does when `text` has more pieces than `out` can hold.
+enum class SplitOverflow {
+  // Stores the first `out.size()` pieces and stops splitting. Returns the
+  // number of pieces stored.
+  kTruncate,
+  // Stores the first `out.size() - 1` pieces, and in the last element of `out`
+  // the rest of `text` from the start of the next piece, delimiters included,
+  // much like `MaxSplits()`. Returns the number of pieces stored.
+  kKeepRemainder,
+  // Stores the first `out.size()` pieces and splits the rest of `text` to
+  // count its pieces. Returns the number of pieces of `text`, which is more
+  // than `out.size()` if some were not stored.
+  kCountAll,
+};
+
+// StrSplitInto()
+//
+// Splits `text` like `StrSplit()` and stores the pieces in the caller-provided
+// `out`, without allocating memory. This suits lines with a bounded number of
+// fields that are split in a loop. The pieces refer to `text`, which must
+// outlive them.
+//
+// Example:
+//
+//   absl::string_view fields[4];
+//   size_t n = absl::StrSplitInto("a\tb\tc", '\t', absl::MakeSpan(fields));
+//   // n == 3, fields[0] == "a", fields[1] == "b", fields[2] == "c"
+//
+//   absl::FixedArray<absl::string_view> columns(num_columns);
+//   n = absl::StrSplitInto(line, ',', absl::MakeSpan(columns),
+//                          absl::SplitOverflow::kCountAll);
+//   if (n != columns.size()) return BadLine(line);
+//
+// An optional `Predicate` filters the pieces as it does for `StrSplit()`:
+//
+//   n = absl::StrSplitInto(" a , ,,b,", ',', absl::SkipWhitespace(),
+//                          absl::MakeSpan(fields));
+//   // n == 2, fields[0] == " a ", fields[1] == "b"
+template <typename Delimiter, typename Predicate>
+size_t StrSplitInto(absl::string_view text, Delimiter d, Predicate p,
+                    absl::Span<absl::string_view> out,
+                    SplitOverflow overflow = SplitOverflow::kTruncate) {
+  using DelimiterType =
+      typename strings_internal::SelectDelimiter<Delimiter>::type;
+  const strings_internal::Splitter<DelimiterType, Predicate> splitter(
+      text, DelimiterType(d), std::move(p));
+  const char* const text_end = text.data() + text.size();
+  size_t n = 0;
+  for (auto it = splitter.begin(); !it.at_end(); ++it, ++n) {
+    if (n < out.size()) {
+      if (n + 1 == out.size() && overflow == SplitOverflow::kKeepRemainder) {
+        out[n] = absl::string_view(it->data(), text_end - it->data());
+        return n + 1;
+      }
+      out[n] = *it;
+    } else if (overflow != SplitOverflow::kCountAll) {
+      break;
+    }
+  }
+  return n;
+}
+
+template <typename Delimiter>
+size_t StrSplitInto(absl::string_view text, Delimiter d,
+                    absl::Span<absl::string_view> out,
+                    SplitOverflow overflow = SplitOverflow::kTruncate) {
+  return StrSplitInto(text, std::move(d), AllowEmpty(), out, overflow);
+}
+
 }  // namespace absl
 
 #endif  // ABSL_STRINGS_STR_SPLIT_H_
@@ -22,6 +22,7 @@
 
 #include "benchmark/benchmark.h"
 #include "absl/base/internal/raw_logging.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
 
 namespace {
@@ -117,6 +118,101 @@ void BM_SplitStringAllowEmpty(benchmark::State& state) {
 }
 BENCHMARK_RANGE(BM_SplitStringAllowEmpty, 0, 1 << 20);
 
+// Lines of tab separated fields of 2 to 15 bytes, as in TSV ingestion.
+std::string MakeTsvString(int num_lines) {
+  std::string test;
+  for (int i = 0; i < num_lines; ++i) {
+    for (int field = 0; field < 12; ++field) {
+      if (field > 0) test += '\t';
+      test.append(2 + (i * 7 + field * 5) % 14, 'x');
+    }
+    test += '\n';
+  }
+  return test;
+}
+
+void BM_SplitByCharTsv(benchmark::State& state) {
+  const std::string test = MakeTsvString(state.range(0));
+  std::vector<absl::string_view> result;
+  for (auto _ : state) {
+    result = absl::StrSplit(test, '\t');
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * test.size());
+}
+BENCHMARK(BM_SplitByCharTsv)->Arg(1)->Arg(100);
+
+void BM_SplitByAnyCharTsv(benchmark::State& state) {
+  const std::string test = MakeTsvString(state.range(0));
+  const absl::ByAnyChar delimiter("\t\n");
+  std::vector<absl::string_view> result;
+  for (auto _ : state) {
+    result = absl::StrSplit(test, delimiter);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * test.size());
+}
+BENCHMARK(BM_SplitByAnyCharTsv)->Arg(1)->Arg(100);
+
+// More delimiter characters than are compared per block.
+void BM_SplitByAnyCharLargeSet(benchmark::State& state) {
+  const std::string test = MakeTsvString(state.range(0));
+  const absl::ByAnyChar delimiter("\t\n,;|");
+  std::vector<absl::string_view> result;
+  for (auto _ : state) {
+    result = absl::StrSplit(test, delimiter);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * test.size());
+}
+BENCHMARK(BM_SplitByAnyCharLargeSet)->Arg(1)->Arg(100);
+
+// Splitting one line at a time, into a new vector, into an InlinedVector and
+// into caller storage.
+void BM_SplitLineToVector(benchmark::State& state) {
+  const std::string line = MakeTsvString(1);
+  for (auto _ : state) {
+    std::vector<absl::string_view> fields = absl::StrSplit(line, '\t');
+    benchmark::DoNotOptimize(fields.data());
+  }
+}
+BENCHMARK(BM_SplitLineToVector);
+
+void BM_SplitLineToInlinedVector(benchmark::State& state) {
+  const std::string line = MakeTsvString(1);
+  for (auto _ : state) {
+    absl::InlinedVector<absl::string_view, 16> fields =
+        absl::StrSplit(line, '\t');
+    benchmark::DoNotOptimize(fields.data());
+  }
+}
+BENCHMARK(BM_SplitLineToInlinedVector);
+
+void BM_SplitLineInto(benchmark::State& state) {
+  const std::string line = MakeTsvString(1);
+  absl::string_view fields[16];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        absl::StrSplitInto(line, '\t', absl::MakeSpan(fields)));
+    benchmark::DoNotOptimize(fields);
+  }
+}
+BENCHMARK(BM_SplitLineInto);
+
+void BM_SplitByString(benchmark::State& state) {
+  std::string test = MakeTestString(state.range(0));
+  for (size_t i = 0; i + 1 < test.size(); ++i) {
+    if (test[i] == ';') test[i + 1] = ' ';
+  }
+  std::vector<absl::string_view> result;
+  for (auto _ : state) {
+    result = absl::StrSplit(test, "; ");
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * test.size());
+}
+BENCHMARK(BM_SplitByString)->Arg(1)->Arg(100);
+
 struct OneCharLiteral {
   char operator()() const { return 'X'; }
 };
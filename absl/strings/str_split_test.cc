@@ -29,6 +29,8 @@
 #include "gtest/gtest.h"
 #include "absl/base/dynamic_annotations.h"  // for RunningOnValgrind
 #include "absl/base/macros.h"
+#include "absl/container/fixed_array.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/numbers.h"
 
 namespace {
@@ -415,6 +417,9 @@ TEST(Splitter, ConversionOperator) {
   TestConversionOperator<std::multiset<absl::string_view>>(splitter);
   TestConversionOperator<std::multiset<std::string>>(splitter);
   TestConversionOperator<std::unordered_set<std::string>>(splitter);
+  TestConversionOperator<absl::InlinedVector<absl::string_view, 4>>(splitter);
+  TestConversionOperator<absl::InlinedVector<absl::string_view, 2>>(splitter);
+  TestConversionOperator<absl::InlinedVector<std::string, 4>>(splitter);
 
   // Tests conversion to map-like objects.
 
@@ -932,6 +937,87 @@ TEST(Split, WorksWithLargeStrings) {
   }
 }
 
+TEST(SplitInto, Basics) {
+  absl::string_view out[4];
+  EXPECT_EQ(3, absl::StrSplitInto("a,b,c", ',', absl::MakeSpan(out)));
+  EXPECT_THAT(absl::MakeSpan(out, 3), ElementsAre("a", "b", "c"));
+
+  EXPECT_EQ(4, absl::StrSplitInto("a,,b,", ',', absl::MakeSpan(out)));
+  EXPECT_THAT(out, ElementsAre("a", "", "b", ""));
+
+  EXPECT_EQ(1, absl::StrSplitInto("", ',', absl::MakeSpan(out)));
+  EXPECT_EQ("", out[0]);
+  EXPECT_EQ(0, absl::StrSplitInto(absl::string_view(), ',',
+                                  absl::MakeSpan(out)));
+
+  EXPECT_EQ(2, absl::StrSplitInto("a, b", ", ", absl::MakeSpan(out)));
+  EXPECT_THAT(absl::MakeSpan(out, 2), ElementsAre("a", "b"));
+  EXPECT_EQ(3, absl::StrSplitInto("a=b,c", absl::ByAnyChar(",="),
+                                  absl::MakeSpan(out)));
+  EXPECT_THAT(absl::MakeSpan(out, 3), ElementsAre("a", "b", "c"));
+}
+
+TEST(SplitInto, PiecesReferToText) {
+  const std::string text = "ab,cd";
+  absl::string_view out[2];
+  ASSERT_EQ(2, absl::StrSplitInto(text, ',', absl::MakeSpan(out)));
+  EXPECT_EQ(text.data(), out[0].data());
+  EXPECT_EQ(text.data() + 3, out[1].data());
+}
+
+TEST(SplitInto, Predicate) {
+  absl::string_view out[4];
+  EXPECT_EQ(2, absl::StrSplitInto(" a , ,,b,", ',', absl::SkipWhitespace(),
+                                  absl::MakeSpan(out)));
+  EXPECT_THAT(absl::MakeSpan(out, 2), ElementsAre(" a ", "b"));
+  EXPECT_EQ(3, absl::StrSplitInto(",a,,b,c", ',', absl::SkipEmpty(),
+                                  absl::MakeSpan(out, 2),
+                                  absl::SplitOverflow::kCountAll));
+  EXPECT_THAT(absl::MakeSpan(out, 2), ElementsAre("a", "b"));
+}
+
+TEST(SplitInto, Overflow) {
+  absl::string_view out[2];
+  EXPECT_EQ(2, absl::StrSplitInto("a,b,c,d", ',', absl::MakeSpan(out)));
+  EXPECT_THAT(out, ElementsAre("a", "b"));
+
+  EXPECT_EQ(2, absl::StrSplitInto("a,b,c,d", ',', absl::MakeSpan(out),
+                                  absl::SplitOverflow::kKeepRemainder));
+  EXPECT_THAT(out, ElementsAre("a", "b,c,d"));
+  EXPECT_EQ(2, absl::StrSplitInto("a,b", ',', absl::MakeSpan(out),
+                                  absl::SplitOverflow::kKeepRemainder));
+  EXPECT_THAT(out, ElementsAre("a", "b"));
+  EXPECT_EQ(1, absl::StrSplitInto("a", ',', absl::MakeSpan(out),
+                                  absl::SplitOverflow::kKeepRemainder));
+  EXPECT_EQ("a", out[0]);
+
+  EXPECT_EQ(4, absl::StrSplitInto("a,b,c,d", ',', absl::MakeSpan(out),
+                                  absl::SplitOverflow::kCountAll));
+  EXPECT_THAT(out, ElementsAre("a", "b"));
+
+  // Nothing is stored in an empty span.
+  EXPECT_EQ(0, absl::StrSplitInto("a,b", ',', absl::Span<absl::string_view>(),
+                                  absl::SplitOverflow::kKeepRemainder));
+  EXPECT_EQ(2, absl::StrSplitInto("a,b", ',', absl::Span<absl::string_view>(),
+                                  absl::SplitOverflow::kCountAll));
+}
+
+TEST(SplitInto, FixedArray) {
+  absl::FixedArray<absl::string_view, 8> fields(3);
+  EXPECT_EQ(3, absl::StrSplitInto("x\ty\tz", '\t', absl::MakeSpan(fields)));
+  EXPECT_THAT(fields, ElementsAre("x", "y", "z"));
+}
+
+TEST(SplitInto, RemainderStartsAtNextKeptPiece) {
+  // Unlike with MaxSplits(), empty pieces skipped by the predicate do not
+  // start the remainder.
+  absl::string_view out[2];
+  EXPECT_EQ(2, absl::StrSplitInto("a,,b,,", ',', absl::SkipEmpty(),
+                                  absl::MakeSpan(out),
+                                  absl::SplitOverflow::kKeepRemainder));
+  EXPECT_THAT(out, ElementsAre("a", "b,,"));
+}
+
 TEST(SplitInternalTest, TypeTraits) {
   EXPECT_FALSE(absl::strings_internal::HasMappedType<int>::value);
   EXPECT_TRUE(
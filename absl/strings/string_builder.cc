@@ -0,0 +1,109 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/string_builder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/strings/internal/resize_uninitialized.h"
+
+namespace absl {
+
+namespace {
+
+// The first heap allocation is at least this large, so that building a short
+// string out of many small fragments does not reallocate for each.
+constexpr size_t kMinHeapCapacity = 64;
+
+}  // namespace
+
+StringBuilder::StringBuilder(std::string str)
+    : size_(str.size()),
+      buffer_(nullptr),
+      buffer_size_(0),
+      heap_(std::move(str)) {
+  strings_internal::STLStringResizeUninitialized(&heap_, heap_.capacity());
+  data_ = &heap_[0];
+  capacity_ = heap_.size();
+}
+
+void StringBuilder::Grow(size_t n) {
+  size_t new_capacity = std::max(size_ + n, 2 * capacity_);
+  new_capacity = std::max(new_capacity, kMinHeapCapacity);
+  if (data_ != buffer_) {
+    // Shrink first, so that only the contents are copied if `heap_`
+    // reallocates.
+    heap_.resize(size_);
+  } else {
+    heap_.clear();
+    heap_.reserve(new_capacity);
+    heap_.append(data_, size_);
+  }
+  strings_internal::STLStringResizeUninitialized(&heap_, new_capacity);
+  data_ = &heap_[0];
+  capacity_ = new_capacity;
+}
+
+void StringBuilder::AppendPieces(
+    std::initializer_list<absl::string_view> pieces) {
+  size_t total_size = 0;
+  for (const absl::string_view piece : pieces) {
+    AssertNoOverlap(piece);
+    total_size += piece.size();
+  }
+  if (total_size > capacity_ - size_) Grow(total_size);
+  char* out = data_ + size_;
+  for (const absl::string_view piece : pieces) {
+    const size_t this_size = piece.size();
+    if (this_size != 0) {
+      std::memcpy(out, piece.data(), this_size);
+      out += this_size;
+    }
+  }
+  size_ += total_size;
+}
+
+void StringBuilder::AppendSubstituteArray(
+    absl::string_view format, std::initializer_list<absl::string_view> args) {
+  size_t total_size;
+  if (!substitute_internal::SubstitutedSize(format, args.begin(), args.size(),
+                                            &total_size) ||
+      total_size == 0) {
+    return;
+  }
+  for (const absl::string_view arg : args) AssertNoOverlap(arg);
+  if (total_size > capacity_ - size_) Grow(total_size);
+  char* const end = substitute_internal::SubstituteToBuffer(
+      data_ + size_, format, args.begin());
+  assert(end == data_ + size_ + total_size);
+  static_cast<void>(end);
+  size_ += total_size;
+}
+
+std::string StringBuilder::Release() {
+  std::string result;
+  if (data_ != buffer_) {
+    heap_.resize(size_);
+    result.swap(heap_);
+  } else if (size_ != 0) {
+    result.assign(data_, size_);
+  }
+  data_ = buffer_;
+  size_ = 0;
+  capacity_ = buffer_size_;
+  return result;
+}
+
+}  // namespace absl
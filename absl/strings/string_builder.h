@@ -0,0 +1,189 @@
+//
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// -----------------------------------------------------------------------------
+// File: string_builder.h
+// -----------------------------------------------------------------------------
+//
+// This header file contains `absl::StringBuilder`, a buffer for building a
+// string out of many fragments. Where repeated `absl::StrAppend()` calls
+// resize a `std::string` once per call, a `StringBuilder` keeps spare capacity
+// and grows geometrically, so that appending a fragment is a bounds check and
+// a copy.
+//
+// A `StringBuilder` may start out in storage provided by the caller, such as
+// a stack buffer or a block of an arena, and only allocates once that is full.
+// It can be cleared and reused, keeping its capacity.
+//
+// Fragments are appended with the arguments `absl::StrCat()` accepts, with
+// `absl::Substitute()` formats, or with `absl::Format()`:
+//
+//   char buffer[256];
+//   absl::StringBuilder builder(absl::MakeSpan(buffer));
+//   builder.Append("id=", id, ", name=", name);
+//   builder.AppendSubstitute(", at $0:$1", host, port);
+//   absl::Format(&builder, ", %.2f ms", latency_ms);
+//   std::string response = builder.Release();
+
+#ifndef ABSL_STRINGS_STRING_BUILDER_H_
+#define ABSL_STRINGS_STRING_BUILDER_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/strings/substitute.h"
+#include "absl/types/span.h"
+
+namespace absl {
+
+// StringBuilder
+//
+// A growable character buffer. As with `absl::StrAppend()`, the fragments
+// appended must not refer into the builder itself, since growing it moves its
+// contents.
+class StringBuilder {
+ public:
+  // Creates an empty builder, which allocates on the first append.
+  StringBuilder()
+      : data_(nullptr),
+        size_(0),
+        capacity_(0),
+        buffer_(nullptr),
+        buffer_size_(0) {}
+
+  // Creates an empty builder that writes to `buffer` until it is full, and
+  // then moves its contents to the heap. `buffer` must outlive the builder.
+  explicit StringBuilder(absl::Span<char> buffer)
+      : data_(buffer.data()),
+        size_(0),
+        capacity_(buffer.size()),
+        buffer_(buffer.data()),
+        buffer_size_(buffer.size()) {}
+
+  // Creates a builder that appends to `str`, reusing its capacity.
+  explicit StringBuilder(std::string str);
+
+  // The builder points into its own storage, so it can be neither copied nor
+  // moved.
+  StringBuilder(const StringBuilder&) = delete;
+  StringBuilder& operator=(const StringBuilder&) = delete;
+
+  // StringBuilder::Append()
+  //
+  // Appends the concatenation of the arguments, each of which can be anything
+  // `absl::StrCat()` accepts.
+  void Append(const AlphaNum& a) {
+    const absl::string_view piece = a.Piece();
+    AssertNoOverlap(piece);
+    if (piece.size() > capacity_ - size_) Grow(piece.size());
+    // `data_` is null while the builder is empty and unallocated, and memcpy
+    // may not be passed null even for no bytes.
+    if (!piece.empty()) std::memcpy(data_ + size_, piece.data(), piece.size());
+    size_ += piece.size();
+  }
+
+  template <typename... AV>
+  void Append(const AlphaNum& a, const AlphaNum& b, const AV&... args) {
+    AppendPieces({a.Piece(), b.Piece(),
+                  static_cast<const AlphaNum&>(args).Piece()...});
+  }
+
+  // StringBuilder::push_back()
+  //
+  // Appends the single character `c`, which `Append()` does not accept.
+  void push_back(char c) {
+    if (size_ == capacity_) Grow(1);
+    data_[size_++] = c;
+  }
+
+  // StringBuilder::AppendSubstitute()
+  //
+  // Appends `format` with its "$0" through "$9" replaced by the arguments, as
+  // `absl::SubstituteAndAppend()` does. The arguments can be anything
+  // `absl::Substitute()` accepts.
+  template <typename... Args>
+  void AppendSubstitute(absl::string_view format, const Args&... args) {
+    static_assert(sizeof...(Args) <= 10,
+                  "Substitute() takes at most 10 arguments");
+    // Each `Arg` lives until the end of the full expression, so that the
+    // pieces that refer to its scratch buffer remain valid for the call.
+    AppendSubstituteArray(format,
+                          {substitute_internal::Arg(args).piece()...});
+  }
+
+  // StringBuilder::view()
+  //
+  // Returns the contents, which are valid until the builder is next changed.
+  absl::string_view view() const { return absl::string_view(data_, size_); }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_t capacity() const { return capacity_; }
+
+  // StringBuilder::clear()
+  //
+  // Empties the builder, keeping its capacity.
+  void clear() { size_ = 0; }
+
+  // StringBuilder::reserve()
+  //
+  // Makes room for a total of `n` chars without further allocation.
+  void reserve(size_t n) {
+    if (n > capacity_) Grow(n - size_);
+  }
+
+  // StringBuilder::Release()
+  //
+  // Returns the contents and empties the builder. Heap contents are moved
+  // into the result rather than copied; contents still in the caller-provided
+  // buffer are copied, and the builder then writes to that buffer again.
+  std::string Release();
+
+ private:
+  // Reallocates so that `n` more chars fit, at least doubling the capacity.
+  void Grow(size_t n);
+
+  void AppendPieces(std::initializer_list<absl::string_view> pieces);
+  void AppendSubstituteArray(absl::string_view format,
+                             std::initializer_list<absl::string_view> args);
+
+  void AssertNoOverlap(absl::string_view piece) const {
+    assert(piece.empty() ||
+           uintptr_t(piece.data() - data_) >= uintptr_t(capacity_));
+    static_cast<void>(piece);
+  }
+
+  // The contents are [data_, data_ + size_), in storage of `capacity_` chars
+  // that is either the caller's buffer or `heap_`.
+  char* data_;
+  size_t size_;
+  size_t capacity_;
+  // The buffer given at construction, if any.
+  char* buffer_;
+  size_t buffer_size_;
+  // Heap storage. Its size is kept equal to `capacity_` while in use, so that
+  // appending does not touch it.
+  std::string heap_;
+};
+
+}  // namespace absl
+
+#endif  // ABSL_STRINGS_STRING_BUILDER_H_
@@ -0,0 +1,101 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_builder.h"
+#include "absl/strings/substitute.h"
+
+namespace {
+
+// Each benchmark builds a response out of `state.range(0)` records of a few
+// fragments each, as a serializer does.
+
+void BM_StrAppend(benchmark::State& state) {
+  for (auto _ : state) {
+    std::string out;
+    for (int i = 0; i < state.range(0); ++i) {
+      absl::StrAppend(&out, "\"key", i, "\":");
+      absl::StrAppend(&out, i * 31, ",");
+    }
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_StrAppend)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_StringBuilder(benchmark::State& state) {
+  for (auto _ : state) {
+    absl::StringBuilder builder;
+    for (int i = 0; i < state.range(0); ++i) {
+      builder.Append("\"key", i, "\":");
+      builder.Append(i * 31, ",");
+    }
+    benchmark::DoNotOptimize(builder.Release());
+  }
+}
+BENCHMARK(BM_StringBuilder)->Arg(10)->Arg(100)->Arg(1000);
+
+// A builder that is cleared and reused, so that only the first iteration
+// allocates.
+void BM_StringBuilderReused(benchmark::State& state) {
+  absl::StringBuilder builder;
+  for (auto _ : state) {
+    builder.clear();
+    for (int i = 0; i < state.range(0); ++i) {
+      builder.Append("\"key", i, "\":");
+      builder.Append(i * 31, ",");
+    }
+    benchmark::DoNotOptimize(builder.view());
+  }
+}
+BENCHMARK(BM_StringBuilderReused)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_StringBuilderStackBuffer(benchmark::State& state) {
+  char buffer[4096];
+  for (auto _ : state) {
+    absl::StringBuilder builder(absl::MakeSpan(buffer));
+    for (int i = 0; i < state.range(0); ++i) {
+      builder.Append("\"key", i, "\":");
+      builder.Append(i * 31, ",");
+    }
+    benchmark::DoNotOptimize(builder.view());
+  }
+}
+BENCHMARK(BM_StringBuilderStackBuffer)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_SubstituteAndAppend(benchmark::State& state) {
+  for (auto _ : state) {
+    std::string out;
+    for (int i = 0; i < state.range(0); ++i) {
+      absl::SubstituteAndAppend(&out, "\"key$0\":$1,", i, i * 31);
+    }
+    benchmark::DoNotOptimize(out);
+  }
+}
+BENCHMARK(BM_SubstituteAndAppend)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_StringBuilderSubstitute(benchmark::State& state) {
+  for (auto _ : state) {
+    absl::StringBuilder builder;
+    for (int i = 0; i < state.range(0); ++i) {
+      builder.AppendSubstitute("\"key$0\":$1,", i, i * 31);
+    }
+    benchmark::DoNotOptimize(builder.Release());
+  }
+}
+BENCHMARK(BM_StringBuilderSubstitute)->Arg(10)->Arg(100)->Arg(1000);
+
+}  // namespace
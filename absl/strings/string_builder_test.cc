@@ -0,0 +1,166 @@
+// Copyright 2018 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "absl/strings/string_builder.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/strings/substitute.h"
+
+namespace {
+
+TEST(StringBuilder, Empty) {
+  absl::StringBuilder builder;
+  EXPECT_TRUE(builder.empty());
+  EXPECT_EQ(0, builder.size());
+  EXPECT_EQ("", builder.view());
+  builder.Append("");
+  builder.Append("", "");
+  EXPECT_TRUE(builder.empty());
+  EXPECT_EQ("", builder.Release());
+}
+
+TEST(StringBuilder, AppendMatchesStrCat) {
+  absl::StringBuilder builder;
+  builder.Append("a");
+  builder.Append(1, "b");
+  builder.Append(2.5, absl::Hex(255), true, std::string("c"),
+                 absl::string_view("d"), -3);
+  builder.push_back('!');
+  EXPECT_EQ(absl::StrCat("a", 1, "b", 2.5, absl::Hex(255), true, "c", "d",
+                         -3, "!"),
+            builder.view());
+}
+
+TEST(StringBuilder, AppendSubstitute) {
+  absl::StringBuilder builder;
+  builder.Append("<");
+  builder.AppendSubstitute("$1 $0 $$ $2", "x", 42, 1.5);
+  builder.AppendSubstitute("");
+  builder.AppendSubstitute("$0$1$2$3$4$5$6$7$8$9", 0, 1, 2, 3, 4, 5, 6, 7, 8,
+                           9);
+  builder.Append(">");
+  EXPECT_EQ(absl::StrCat("<", absl::Substitute("$1 $0 $$ $2", "x", 42, 1.5),
+                         "0123456789>"),
+            builder.view());
+}
+
+TEST(StringBuilder, Format) {
+  absl::StringBuilder builder;
+  builder.Append("[");
+  EXPECT_TRUE(absl::Format(&builder, "%d-%s-%.2f", 7, "seven", 7.0));
+  builder.Append("]");
+  EXPECT_EQ("[7-seven-7.00]", builder.view());
+}
+
+TEST(StringBuilder, GrowsAcrossManyFragments) {
+  absl::StringBuilder builder;
+  std::string expected;
+  for (int i = 0; i < 1000; ++i) {
+    builder.Append("field", i, "=", i * 7, ";");
+    absl::StrAppend(&expected, "field", i, "=", i * 7, ";");
+  }
+  EXPECT_EQ(expected, builder.view());
+  EXPECT_GE(builder.capacity(), builder.size());
+}
+
+TEST(StringBuilder, ExternalBuffer) {
+  char buffer[16];
+  absl::StringBuilder builder(absl::MakeSpan(buffer));
+  EXPECT_EQ(sizeof(buffer), builder.capacity());
+  builder.Append("0123456789");
+  EXPECT_EQ(buffer, builder.view().data());
+  EXPECT_EQ("0123456789", builder.view());
+
+  // Spills to the heap once the buffer is full.
+  builder.Append("abcdefghij");
+  EXPECT_NE(buffer, builder.view().data());
+  EXPECT_EQ("0123456789abcdefghij", builder.view());
+  EXPECT_EQ("0123456789abcdefghij", builder.Release());
+
+  // Release() goes back to the buffer.
+  EXPECT_TRUE(builder.empty());
+  EXPECT_EQ(sizeof(buffer), builder.capacity());
+  builder.Append("short");
+  EXPECT_EQ(buffer, builder.view().data());
+  EXPECT_EQ("short", builder.Release());
+  EXPECT_TRUE(builder.empty());
+}
+
+TEST(StringBuilder, ExternalBufferExactFit) {
+  char buffer[4];
+  absl::StringBuilder builder(absl::MakeSpan(buffer));
+  builder.Append("ab", "cd");
+  EXPECT_EQ(buffer, builder.view().data());
+  builder.push_back('e');
+  EXPECT_EQ("abcde", builder.view());
+}
+
+TEST(StringBuilder, ReleaseMovesHeapContents) {
+  absl::StringBuilder builder;
+  builder.Append(std::string(1000, 'x'));
+  const char* data = builder.view().data();
+  const std::string result = builder.Release();
+  EXPECT_EQ(std::string(1000, 'x'), result);
+  EXPECT_EQ(data, result.data());
+  EXPECT_TRUE(builder.empty());
+
+  builder.Append("again");
+  EXPECT_EQ("again", builder.Release());
+}
+
+TEST(StringBuilder, FromString) {
+  std::string str = "prefix:";
+  str.reserve(100);
+  const char* data = str.data();
+  absl::StringBuilder builder(std::move(str));
+  EXPECT_EQ("prefix:", builder.view());
+  EXPECT_GE(builder.capacity(), 100);
+  builder.Append("suffix");
+  EXPECT_EQ(data, builder.view().data());
+  EXPECT_EQ("prefix:suffix", builder.Release());
+}
+
+TEST(StringBuilder, ClearKeepsCapacity) {
+  absl::StringBuilder builder;
+  builder.Append(std::string(500, 'y'));
+  const size_t capacity = builder.capacity();
+  const char* data = builder.view().data();
+  builder.clear();
+  EXPECT_TRUE(builder.empty());
+  builder.Append(std::string(400, 'z'));
+  EXPECT_EQ(capacity, builder.capacity());
+  EXPECT_EQ(data, builder.view().data());
+  EXPECT_EQ(std::string(400, 'z'), builder.view());
+}
+
+TEST(StringBuilder, Reserve) {
+  char buffer[8];
+  absl::StringBuilder builder(absl::MakeSpan(buffer));
+  builder.Append("abc");
+  builder.reserve(4);
+  EXPECT_EQ(buffer, builder.view().data());
+  builder.reserve(300);
+  EXPECT_GE(builder.capacity(), 300);
+  EXPECT_EQ("abc", builder.view());
+  const char* data = builder.view().data();
+  builder.Append(std::string(297, 'q'));
+  EXPECT_EQ(data, builder.view().data());
+}
+
+}  // namespace
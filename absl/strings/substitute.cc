@@ -25,10 +25,9 @@
 namespace absl {
 namespace substitute_internal {
 
-void SubstituteAndAppendArray(std::string* output, absl::string_view format,
-                              const absl::string_view* args_array,
-                              size_t num_args) {
-  // Determine total size needed.
+bool SubstitutedSize(absl::string_view format,
+                     const absl::string_view* args_array, size_t num_args,
+                     size_t* result) {
   size_t size = 0;
   for (size_t i = 0; i < format.size(); i++) {
     if (format[i] == '$') {
@@ -38,7 +37,7 @@ void SubstituteAndAppendArray(std::string* output, absl::string_view format,
                      "Invalid strings::Substitute() format std::string: \"%s\".",
                      absl::CEscape(format).c_str());
 #endif
-        return;
+        return false;
       } else if (absl::ascii_isdigit(format[i + 1])) {
         int index = format[i + 1] - '0';
         if (static_cast<size_t>(index) >= num_args) {
@@ -50,7 +49,7 @@ void SubstituteAndAppendArray(std::string* output, absl::string_view format,
               "\"%s\".",
               index, static_cast<int>(num_args), absl::CEscape(format).c_str());
 #endif
-          return;
+          return false;
         }
         size += args_array[index].size();
         ++i;  // Skip next char.
@@ -63,19 +62,18 @@ void SubstituteAndAppendArray(std::string* output, absl::string_view format,
                      "Invalid strings::Substitute() format std::string: \"%s\".",
                      absl::CEscape(format).c_str());
 #endif
-        return;
+        return false;
       }
     } else {
       ++size;
     }
   }
+  *result = size;
+  return true;
+}
 
-  if (size == 0) return;
-
-  // Build the std::string.
-  size_t original_size = output->size();
-  strings_internal::STLStringResizeUninitialized(output, original_size + size);
-  char* target = &(*output)[original_size];
+char* SubstituteToBuffer(char* target, absl::string_view format,
+                         const absl::string_view* args_array) {
   for (size_t i = 0; i < format.size(); i++) {
     if (format[i] == '$') {
       if (absl::ascii_isdigit(format[i + 1])) {
@@ -90,8 +88,24 @@ void SubstituteAndAppendArray(std::string* output, absl::string_view format,
       *target++ = format[i];
     }
   }
+  return target;
+}
+
+void SubstituteAndAppendArray(std::string* output, absl::string_view format,
+                              const absl::string_view* args_array,
+                              size_t num_args) {
+  // Determine total size needed.
+  size_t size;
+  if (!SubstitutedSize(format, args_array, num_args, &size)) return;
+  if (size == 0) return;
 
+  // Build the std::string.
+  size_t original_size = output->size();
+  strings_internal::STLStringResizeUninitialized(output, original_size + size);
+  char* target =
+      SubstituteToBuffer(&(*output)[original_size], format, args_array);
   assert(target == output->data() + output->size());
+  static_cast<void>(target);
 }
 
 static const char kHexDigits[] = "0123456789abcdef";
@@ -166,8 +166,21 @@ class Arg {
   char scratch_[numbers_internal::kFastToBufferSize];
 };
 
-// Internal helper function. Don't call this from outside this implementation.
-// This interface may change without notice.
+// Internal helper functions. Don't call these from outside this
+// implementation. This interface may change without notice.
+
+// Sets `*result` to the size of `format` with the arguments substituted.
+// Returns false, after a fatal log in debug mode, if `format` is invalid.
+bool SubstitutedSize(absl::string_view format,
+                     const absl::string_view* args_array, size_t num_args,
+                     size_t* result);
+
+// Writes `format` with the arguments substituted to `target`, which must have
+// room for `SubstitutedSize()` chars, and returns the end of the output.
+// `format` must be valid.
+char* SubstituteToBuffer(char* target, absl::string_view format,
+                         const absl::string_view* args_array);
+
 void SubstituteAndAppendArray(std::string* output, absl::string_view format,
                               const absl::string_view* args_array,
                               size_t num_args);